@@ -272,6 +272,29 @@ int msg_send_to_self(msg_t *m);
  */
 int msg_send_int(msg_t *m, kernel_pid_t target_pid);
 
+/**
+ * @brief Send a burst of messages to one thread (non-blocking).
+ *
+ * All messages are delivered within a single critical section: if the target
+ * is waiting in msg_receive(), the first message is copied directly, all
+ * following messages are appended to the target's message queue. The target
+ * is woken up at most once for the whole burst, so the scheduling cost is
+ * amortized over all messages.
+ *
+ * Sending stops as soon as the target's message queue is full, this function
+ * never blocks. May be called from interrupt context.
+ *
+ * @param[in,out] m         Array of @p num messages to send, must not be
+ *                          NULL. msg_t::sender_pid of each sent message is
+ *                          set by this function.
+ * @param[in] num           Number of messages in @p m.
+ * @param[in] target_pid    PID of target thread
+ *
+ * @return  number of messages sent, starting from @p m[0]
+ * @return  -1, on error (invalid PID)
+ */
+int msg_send_many(msg_t *m, unsigned num, kernel_pid_t target_pid);
+
 /**
  * @brief Test if the message was sent inside an ISR.
  * @see msg_send_int()
@@ -309,6 +332,24 @@ int msg_receive(msg_t *m);
  */
 int msg_try_receive(msg_t *m);
 
+/**
+ * @brief Receive up to @p max messages at once.
+ *
+ * Drains the message queue and the messages of send-blocked threads into
+ * @p m within a single critical section, in the order they would have been
+ * returned by subsequent calls to msg_receive(). All senders woken up on the
+ * way are scheduled with a single context switch.
+ *
+ * If no message is available, this function blocks until one is received.
+ *
+ * @param[out] m    Array of at least @p max preallocated ``msg_t``
+ *                  structures, must not be NULL.
+ * @param[in] max   Maximum number of messages to receive, must be > 0.
+ *
+ * @return  number of messages received (1 <= n <= @p max)
+ */
+int msg_receive_many(msg_t *m, unsigned max);
+
 /**
  * @brief Send a message, block until reply received.
  *
@@ -134,6 +134,40 @@ static inline unsigned int ringbuffer_get_free(const ringbuffer_t *__restrict rb
     return rb->size - rb->avail;
 }
 
+/**
+ * @brief           Reserve a contiguous region for writing.
+ * @details         Returns the largest contiguous free region after the last element.
+ *                  Data written to it is added to the ringbuffer by ringbuffer_commit().
+ *                  As the region ends at the end of the underlying buffer, call this
+ *                  function again after committing to get the wrapped-around part.
+ * @param[in]       rb       Ringbuffer to operate on.
+ * @param[out]      region   Start of the free region.
+ * @returns         Size of the free region, 0 if the ringbuffer is full.
+ */
+unsigned ringbuffer_reserve(const ringbuffer_t *__restrict rb, char **region);
+
+/**
+ * @brief           Add data written to a region returned by ringbuffer_reserve().
+ * @param[in,out]   rb    Ringbuffer to operate on.
+ * @param[in]       n     Number of elements written, must not exceed the size of the region.
+ */
+static inline void ringbuffer_commit(ringbuffer_t *__restrict rb, unsigned n)
+{
+    rb->avail += n;
+}
+
+/**
+ * @brief           Get a contiguous region of the oldest elements in the buffer.
+ * @details         The elements stay in the ringbuffer until they are removed using
+ *                  ringbuffer_remove(). As the region ends at the end of the underlying
+ *                  buffer, call this function again after removing to get the
+ *                  wrapped-around part.
+ * @param[in]       rb       Ringbuffer to operate on.
+ * @param[out]      region   Start of the oldest element.
+ * @returns         Number of contiguous elements at @p region, 0 if empty.
+ */
+unsigned ringbuffer_peek_region(const ringbuffer_t *__restrict rb, char **region);
+
 /**
  * @brief           Read, but don't remove, the oldest element in the buffer.
  * @param[in]       rb    Ringbuffer to operate on.
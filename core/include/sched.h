@@ -175,6 +175,31 @@ extern clist_node_t sched_runqueues[SCHED_PRIO_LEVELS];
 NORETURN void sched_task_exit(void);
 
 #ifdef MODULE_SCHEDSTATISTICS
+/**
+ * @brief   Number of buckets of the scheduler statistics histograms
+ */
+#ifndef SCHEDSTAT_HIST_NUMOF
+#define SCHEDSTAT_HIST_NUMOF    (8U)
+#endif
+
+/**
+ * @brief   Upper bound of the first histogram bucket as power of two (in us)
+ *
+ * Bucket 0 counts durations below 2^SCHEDSTAT_HIST_SHIFT us, every further
+ * bucket covers four times the range of its predecessor. The last bucket
+ * counts everything above.
+ */
+#ifndef SCHEDSTAT_HIST_SHIFT
+#define SCHEDSTAT_HIST_SHIFT    (4U)
+#endif
+
+/**
+ * @brief   Length of the window for the rolling CPU usage (in us)
+ */
+#ifndef SCHEDSTAT_WINDOW_US
+#define SCHEDSTAT_WINDOW_US     (1000000U)
+#endif
+
 /**
  *  Scheduler statistics
  */
@@ -183,6 +208,17 @@ typedef struct {
                                   scheduled to run */
     unsigned int schedules;  /**< How often the thread was scheduled to run */
     uint64_t runtime_ticks;  /**< The total runtime of this thread in ticks */
+    uint32_t wakeup;         /**< Time stamp the thread became runnable, 0 if
+                                  it is not waiting to run after a wake-up */
+    uint32_t latency_max;    /**< Longest wake-up latency seen in us */
+    uint32_t latency_hist[SCHEDSTAT_HIST_NUMOF]; /**< Histogram of the time
+                                  from becoming runnable to running */
+    uint32_t slice_hist[SCHEDSTAT_HIST_NUMOF];   /**< Histogram of the time
+                                  the thread ran before being switched out */
+    uint64_t window_base;    /**< runtime_ticks at the start of the current
+                                  CPU usage window */
+    uint16_t cpu_permille;   /**< CPU usage in the last complete window in
+                                  1/1000 */
 } schedstat;
 
 /**
@@ -196,6 +232,50 @@ extern schedstat sched_pidlist[KERNEL_PID_LAST + 1];
  *  @param[in] callback The callback functions the will be called
  */
 void sched_register_cb(void (*callback)(uint32_t, uint32_t));
+
+/**
+ * @brief   Get the CPU usage of a thread during the last complete window of
+ *          @ref SCHEDSTAT_WINDOW_US
+ *
+ * @param[in] pid   thread to query
+ *
+ * @return  CPU usage in 1/1000
+ */
+unsigned sched_cpu_permille(kernel_pid_t pid);
+
+/**
+ * @brief   Get the histogram bucket a duration is counted in
+ *
+ * @param[in] us    duration in microseconds
+ *
+ * @return  bucket index into schedstat::latency_hist and schedstat::slice_hist
+ */
+static inline unsigned sched_hist_bucket(uint32_t us)
+{
+    if (us < (1UL << SCHEDSTAT_HIST_SHIFT)) {
+        return 0;
+    }
+    unsigned bucket = 1;
+    us >>= (SCHEDSTAT_HIST_SHIFT + 2);
+    while (us && (bucket < (SCHEDSTAT_HIST_NUMOF - 1))) {
+        us >>= 2;
+        bucket++;
+    }
+    return bucket;
+}
+
+/**
+ * @brief   Get the lower bound of a histogram bucket
+ *
+ * @param[in] bucket    bucket index
+ *
+ * @return  shortest duration in microseconds counted in @p bucket
+ */
+static inline uint32_t sched_hist_bucket_min(unsigned bucket)
+{
+    return (bucket == 0) ? 0 :
+           (1UL << (SCHEDSTAT_HIST_SHIFT + ((bucket - 1) << 1)));
+}
 #endif /* MODULE_SCHEDSTATISTICS */
 
 #ifdef __cplusplus
@@ -29,6 +29,7 @@
 #include "thread.h"
 #include "irq.h"
 #include "cib.h"
+#include "trace.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -90,6 +91,8 @@ static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block, unsigned sta
         return -1;
     }
 
+    TRACE(TRACE_MSG_SEND, target_pid);
+
     thread_t *me = (thread_t *) sched_active_thread;
 
     DEBUG("msg_send() %s:%i: Sending from %" PRIkernel_pid " to %" PRIkernel_pid
@@ -164,6 +167,7 @@ int msg_send_to_self(msg_t *m)
     unsigned state = irq_disable();
 
     m->sender_pid = sched_active_pid;
+    TRACE(TRACE_MSG_SEND, sched_active_pid);
     int res = queue_msg((thread_t *) sched_active_thread, m);
 
     irq_restore(state);
@@ -186,6 +190,7 @@ int msg_send_int(msg_t *m, kernel_pid_t target_pid)
     }
 
     m->sender_pid = KERNEL_PID_ISR;
+    TRACE(TRACE_MSG_SEND, target_pid);
     if (target->status == STATUS_RECEIVE_BLOCKED) {
         DEBUG("msg_send_int: Direct msg copy from %" PRIkernel_pid " to %"
               PRIkernel_pid ".\n", thread_getpid(), target_pid);
@@ -205,6 +210,65 @@ int msg_send_int(msg_t *m, kernel_pid_t target_pid)
     }
 }
 
+int msg_send_many(msg_t *m, unsigned num, kernel_pid_t target_pid)
+{
+#ifdef DEVELHELP
+    if (!pid_is_valid(target_pid)) {
+        DEBUG("msg_send_many(): target_pid is invalid, continuing anyways\n");
+    }
+#endif /* DEVELHELP */
+
+    int in_isr = irq_is_in();
+    unsigned state = irq_disable();
+    thread_t *target = (thread_t *) sched_threads[target_pid];
+
+    if (target == NULL) {
+        DEBUG("msg_send_many(): target thread does not exist\n");
+        irq_restore(state);
+        return -1;
+    }
+
+    kernel_pid_t sender_pid = in_isr ? KERNEL_PID_ISR : sched_active_pid;
+    unsigned sent = 0;
+    int wakeup = 0;
+
+    TRACE(TRACE_MSG_SEND, target_pid);
+
+    if ((num > 0) && (target->status == STATUS_RECEIVE_BLOCKED)) {
+        DEBUG("msg_send_many(): Direct msg copy to %" PRIkernel_pid ".\n",
+              target_pid);
+        m[0].sender_pid = sender_pid;
+        /* copy first msg to target */
+        msg_t *target_message = (msg_t *) target->wait_data;
+        *target_message = m[0];
+        sched_set_status(target, STATUS_PENDING);
+        wakeup = 1;
+        sent++;
+    }
+
+    /* the rest goes to the queue, without touching the scheduler */
+    for (; sent < num; sent++) {
+        m[sent].sender_pid = sender_pid;
+        if (!queue_msg(target, &m[sent])) {
+            break;
+        }
+    }
+
+    DEBUG("msg_send_many(): %u of %u messages sent to %" PRIkernel_pid ".\n",
+          sent, num, target_pid);
+
+    irq_restore(state);
+    if (wakeup) {
+        if (in_isr) {
+            sched_context_switch_request = 1;
+        }
+        else {
+            thread_yield_higher();
+        }
+    }
+    return sent;
+}
+
 int msg_send_receive(msg_t *m, msg_t *reply, kernel_pid_t target_pid)
 {
     assert(sched_active_pid != target_pid);
@@ -266,12 +330,20 @@ int msg_reply_int(msg_t *m, msg_t *reply)
 
 int msg_try_receive(msg_t *m)
 {
-    return _msg_receive(m, 0);
+    int res = _msg_receive(m, 0);
+
+    if (res == 1) {
+        TRACE(TRACE_MSG_RECV, m->sender_pid);
+    }
+    return res;
 }
 
 int msg_receive(msg_t *m)
 {
-    return _msg_receive(m, 1);
+    int res = _msg_receive(m, 1);
+
+    TRACE(TRACE_MSG_RECV, m->sender_pid);
+    return res;
 }
 
 static int _msg_receive(msg_t *m, int block)
@@ -360,6 +432,75 @@ static int _msg_receive(msg_t *m, int block)
     DEBUG("This should have never been reached!\n");
 }
 
+int msg_receive_many(msg_t *m, unsigned max)
+{
+    assert(max > 0);
+
+    unsigned state = irq_disable();
+    thread_t *me = (thread_t *) sched_active_thread;
+    uint16_t sender_prio = THREAD_PRIORITY_IDLE;
+    unsigned n = 0;
+
+    /* queued messages are older than the ones of send-blocked threads */
+    if (me->msg_array) {
+        int queue_index;
+        while ((n < max) && ((queue_index = cib_get(&(me->msg_queue))) >= 0)) {
+            m[n++] = me->msg_array[queue_index];
+        }
+    }
+
+    /* take messages directly from waiting threads, then let the remaining
+     * waiters refill the queue as far as it goes */
+    while (me->msg_waiters.next) {
+        msg_t *dest;
+
+        if (n < max) {
+            dest = &m[n++];
+        }
+        else {
+            int queue_index = me->msg_array ? cib_put(&(me->msg_queue)) : -1;
+            if (queue_index < 0) {
+                break;
+            }
+            dest = &me->msg_array[queue_index];
+        }
+
+        list_node_t *next = list_remove_head(&me->msg_waiters);
+        thread_t *sender = container_of((clist_node_t*)next, thread_t, rq_entry);
+        *dest = *((msg_t *) sender->wait_data);
+
+        if (sender->status != STATUS_REPLY_BLOCKED) {
+            sender->wait_data = NULL;
+            sched_set_status(sender, STATUS_PENDING);
+            if (sender->priority < sender_prio) {
+                sender_prio = sender->priority;
+            }
+        }
+    }
+
+    if (n == 0) {
+        DEBUG("msg_receive_many(): %" PRIkernel_pid ": No msg available. "
+              "Going blocked.\n", sched_active_thread->pid);
+        me->wait_data = (void *) m;
+        sched_set_status(me, STATUS_RECEIVE_BLOCKED);
+        irq_restore(state);
+        thread_yield_higher();
+        /* sender copied message */
+        TRACE(TRACE_MSG_RECV, m[0].sender_pid);
+        return 1;
+    }
+
+    DEBUG("msg_receive_many(): %" PRIkernel_pid ": Got %u messages.\n",
+          sched_active_thread->pid, n);
+    TRACE(TRACE_MSG_RECV, m[0].sender_pid);
+    irq_restore(state);
+    /* one switch for all senders that were woken up */
+    if (sender_prio < THREAD_PRIORITY_IDLE) {
+        sched_switch(sender_prio);
+    }
+    return n;
+}
+
 int msg_avail(void)
 {
     DEBUG("msg_available: %" PRIkernel_pid ": msg_available.\n",
@@ -28,6 +28,7 @@
 #include "sched.h"
 #include "irq.h"
 #include "list.h"
+#include "trace.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -51,6 +52,7 @@ int _mutex_lock(mutex_t *mutex, int blocking)
         DEBUG("PID[%" PRIkernel_pid "]: Adding node to mutex queue: prio: %"
               PRIu32 "\n", sched_active_pid, (uint32_t)me->priority);
         sched_set_status(me, STATUS_MUTEX_BLOCKED);
+        TRACE(TRACE_MUTEX_BLOCK, mutex);
         if (mutex->queue.next == MUTEX_LOCKED) {
             mutex->queue.next = (list_node_t*)&me->rq_entry;
             mutex->queue.next->next = NULL;
@@ -97,6 +99,7 @@ void mutex_unlock(mutex_t *mutex)
     DEBUG("mutex_unlock: waking up waiting thread %" PRIkernel_pid "\n",
           process->pid);
     sched_set_status(process, STATUS_PENDING);
+    TRACE(TRACE_MUTEX_UNBLOCK, mutex);
 
     if (!mutex->queue.next) {
         mutex->queue.next = MUTEX_LOCKED;
@@ -123,6 +126,7 @@ void mutex_unlock_and_sleep(mutex_t *mutex)
                                              rq_entry);
             DEBUG("PID[%" PRIkernel_pid "]: waking up waiter.\n", process->pid);
             sched_set_status(process, STATUS_PENDING);
+            TRACE(TRACE_MUTEX_UNBLOCK, mutex);
             if (!mutex->queue.next) {
                 mutex->queue.next = MUTEX_LOCKED;
             }
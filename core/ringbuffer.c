@@ -52,14 +52,38 @@ static char get_head(ringbuffer_t *restrict rb)
     return result;
 }
 
+unsigned ringbuffer_reserve(const ringbuffer_t *restrict rb, char **region)
+{
+    unsigned pos = rb->start + rb->avail;
+    if (pos >= rb->size) {
+        pos -= rb->size;
+    }
+    *region = rb->buf + pos;
+
+    if (ringbuffer_full(rb)) {
+        return 0;
+    }
+    if (pos < rb->start) {
+        /* free space is between tail and head */
+        return rb->start - pos;
+    }
+    return rb->size - pos;
+}
+
 unsigned ringbuffer_add(ringbuffer_t *restrict rb, const char *buf, unsigned n)
 {
-    unsigned i;
-    for (i = 0; i < n; i++) {
-        if (ringbuffer_full(rb)) {
-            break;
+    unsigned i = 0;
+    unsigned len;
+    char *region;
+
+    /* at most two rounds: up to the end of the buffer, then from its start */
+    while ((i < n) && (len = ringbuffer_reserve(rb, &region))) {
+        if (len > (n - i)) {
+            len = n - i;
         }
-        add_tail(rb, buf[i]);
+        memcpy(region, buf + i, len);
+        ringbuffer_commit(rb, len);
+        i += len;
     }
     return i;
 }
@@ -121,7 +145,7 @@ unsigned ringbuffer_remove(ringbuffer_t *restrict rb, unsigned n)
         rb->avail -= n;
 
         /* compensate underflow */
-        if (rb->start > rb->size) {
+        if (rb->start >= rb->size) {
             rb->start -= rb->size;
         }
     }
@@ -129,6 +153,14 @@ unsigned ringbuffer_remove(ringbuffer_t *restrict rb, unsigned n)
     return n;
 }
 
+unsigned ringbuffer_peek_region(const ringbuffer_t *restrict rb, char **region)
+{
+    unsigned bytes_till_end = rb->size - rb->start;
+
+    *region = rb->buf + rb->start;
+    return (rb->avail < bytes_till_end) ? rb->avail : bytes_till_end;
+}
+
 int ringbuffer_peek_one(const ringbuffer_t *restrict rb_)
 {
     ringbuffer_t rb = *rb_;
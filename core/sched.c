@@ -28,6 +28,7 @@
 #include "thread.h"
 #include "irq.h"
 #include "log.h"
+#include "trace.h"
 
 #ifdef MODULE_MPU_STACK_GUARD
 #include "mpu.h"
@@ -77,6 +78,31 @@ uint8_t _tcb_name_offset = offsetof(thread_t, name);
 #ifdef MODULE_SCHEDSTATISTICS
 static void (*sched_cb) (uint32_t timestamp, uint32_t value) = NULL;
 schedstat sched_pidlist[KERNEL_PID_LAST + 1];
+static uint64_t sched_window_start;
+
+/* closes the CPU usage window if it is complete, must be called with
+ * interrupts disabled */
+static void _window_update(uint64_t now)
+{
+    uint64_t len = now - sched_window_start;
+
+    if (len < _xtimer_ticks_from_usec(SCHEDSTAT_WINDOW_US)) {
+        return;
+    }
+
+    for (kernel_pid_t pid = KERNEL_PID_FIRST; pid <= KERNEL_PID_LAST; pid++) {
+        schedstat *stat = &sched_pidlist[pid];
+        uint64_t runtime = stat->runtime_ticks;
+
+        /* account the slice of the running thread up to now */
+        if ((pid == sched_active_pid) && stat->laststart) {
+            runtime += now - stat->laststart;
+        }
+        stat->cpu_permille = ((runtime - stat->window_base) * 1000) / len;
+        stat->window_base = runtime;
+    }
+    sched_window_start = now;
+}
 #endif
 
 int __attribute__((used)) sched_run(void)
@@ -102,6 +128,7 @@ int __attribute__((used)) sched_run(void)
 
 #ifdef MODULE_SCHEDSTATISTICS
     uint64_t now = _xtimer_now64();
+    _window_update(now);
 #endif
 
     if (active_thread) {
@@ -118,7 +145,9 @@ int __attribute__((used)) sched_run(void)
 #ifdef MODULE_SCHEDSTATISTICS
         schedstat *active_stat = &sched_pidlist[active_thread->pid];
         if (active_stat->laststart) {
-            active_stat->runtime_ticks += now - active_stat->laststart;
+            uint32_t slice = now - active_stat->laststart;
+            active_stat->runtime_ticks += slice;
+            active_stat->slice_hist[sched_hist_bucket(_xtimer_usec_from_ticks(slice))]++;
         }
 #endif
     }
@@ -127,6 +156,14 @@ int __attribute__((used)) sched_run(void)
     schedstat *next_stat = &sched_pidlist[next_thread->pid];
     next_stat->laststart = now;
     next_stat->schedules++;
+    if (next_stat->wakeup) {
+        uint32_t latency = _xtimer_usec_from_ticks((uint32_t)now - next_stat->wakeup);
+        next_stat->latency_hist[sched_hist_bucket(latency)]++;
+        if (latency > next_stat->latency_max) {
+            next_stat->latency_max = latency;
+        }
+        next_stat->wakeup = 0;
+    }
     if (sched_cb) {
         sched_cb(now, next_thread->pid);
     }
@@ -135,6 +172,7 @@ int __attribute__((used)) sched_run(void)
     next_thread->status = STATUS_RUNNING;
     sched_active_pid = next_thread->pid;
     sched_active_thread = (volatile thread_t *) next_thread;
+    TRACE(TRACE_SWITCH, next_thread->pid);
 
 #ifdef MODULE_MPU_STACK_GUARD
     mpu_configure(
@@ -156,6 +194,15 @@ void sched_register_cb(void (*callback)(uint32_t, uint32_t))
 {
     sched_cb = callback;
 }
+
+unsigned sched_cpu_permille(kernel_pid_t pid)
+{
+    unsigned state = irq_disable();
+    _window_update(_xtimer_now64());
+    unsigned res = sched_pidlist[pid].cpu_permille;
+    irq_restore(state);
+    return res;
+}
 #endif
 
 void sched_set_status(thread_t *process, unsigned int status)
@@ -166,6 +213,10 @@ void sched_set_status(thread_t *process, unsigned int status)
                   process->pid, process->priority);
             clist_rpush(&sched_runqueues[process->priority], &(process->rq_entry));
             runqueue_bitcache |= 1 << process->priority;
+#ifdef MODULE_SCHEDSTATISTICS
+            /* 0 means "not woken up", so avoid it as time stamp */
+            sched_pidlist[process->pid].wakeup = _xtimer_now() | 1;
+#endif
         }
     }
     else {
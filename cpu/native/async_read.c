@@ -36,24 +36,29 @@ static pid_t _sigio_child_pids[ASYNC_READ_NUMOF];
 static void _sigio_child(int fd);
 #endif
 
-static void _async_io_isr(void) {
-    fd_set rfds;
-
-    FD_ZERO(&rfds);
+/* polls all monitored file descriptors without blocking */
+static int _poll(fd_set *rfds) {
+    FD_ZERO(rfds);
 
     int max_fd = 0;
 
     struct timeval timeout = { .tv_usec = 0 };
 
     for (int i = 0; i < _next_index; i++) {
-        FD_SET(_fds[i], &rfds);
+        FD_SET(_fds[i], rfds);
 
         if (max_fd < _fds[i]) {
             max_fd = _fds[i];
         }
     }
 
-    if (real_select(max_fd + 1, &rfds, NULL, NULL, &timeout) > 0) {
+    return real_select(max_fd + 1, rfds, NULL, NULL, &timeout);
+}
+
+static void _async_io_isr(void) {
+    fd_set rfds;
+
+    if (_poll(&rfds) > 0) {
         for (int i = 0; i < _next_index; i++) {
             if (FD_ISSET(_fds[i], &rfds)) {
                 _native_async_read_callbacks[i](_fds[i], _args[i]);
@@ -115,6 +120,22 @@ void native_async_read_add_handler(int fd, void *arg, native_async_read_callback
     _next_index++;
 }
 
+int native_async_read_pending(void)
+{
+    fd_set rfds;
+    int res;
+
+    if (_next_index == 0) {
+        return 0;
+    }
+
+    _native_syscall_enter();
+    res = _poll(&rfds);
+    _native_syscall_leave();
+
+    return (res > 0);
+}
+
 #ifdef __MACH__
 static void _sigio_child(int index)
 {
@@ -67,6 +67,15 @@ void native_async_read_continue(int fd);
  */
 void native_async_read_add_handler(int fd, void *arg, native_async_read_callback_t handler);
 
+/**
+ * @brief   check whether a monitored file descriptor is ready to read
+ *
+ * @return  1 if data is waiting for a callback registered with
+ *          native_async_read_add_handler()
+ * @return  0 otherwise
+ */
+int native_async_read_pending(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -68,6 +68,7 @@ void native_cpu_init(void);
 void native_interrupt_init(void);
 
 void native_irq_handler(void);
+void native_timer_skip_idle(void);
 extern void _native_sig_leave_tramp(void);
 extern void _native_sig_leave_handler(void);
 
@@ -159,6 +160,7 @@ extern pid_t _native_pid;
 extern pid_t _native_id;
 extern unsigned _native_rng_seed;
 extern int _native_rng_mode; /**< 0 = /dev/random, 1 = random(3) */
+extern int _native_virtual_time; /**< 1 = skip idle time, see native_timer_skip_idle() */
 extern const char *_native_unix_socket_path;
 
 ssize_t _native_read(int fd, void *buf, size_t count);
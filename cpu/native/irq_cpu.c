@@ -40,6 +40,7 @@
 #include "periph/pm.h"
 
 #include "native_internal.h"
+#include "trace.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -261,7 +262,9 @@ void native_irq_handler(void)
 
         if (native_irq_handlers[sig] != NULL) {
             DEBUG("native_irq_handler: calling interrupt handler for %i\n", sig);
+            TRACE(TRACE_ISR_ENTER, sig);
             native_irq_handlers[sig]();
+            TRACE(TRACE_ISR_EXIT, sig);
         }
         else if (sig == SIGUSR1) {
             warnx("native_irq_handler: ignoring SIGUSR1");
@@ -32,6 +32,7 @@
 void pm_set_lowest(void)
 {
     _native_in_syscall++; // no switching here
+    native_timer_skip_idle();
     real_pause();
     _native_in_syscall--;
 
@@ -17,6 +17,15 @@
  *
  * Uses POSIX realtime clock and POSIX itimer to mimic hardware.
  *
+ * In virtual time mode (`--virtual-time`), the idle thread does not wait for
+ * the next timer deadline but skips the clock forward to it. Time only
+ * passes in real time while threads or interrupts are running, so timeouts
+ * of minutes expire in (real) milliseconds. The clock is only skipped to
+ * timers set by the application, never to xtimer's own overflow tick, and
+ * not at all while file descriptors of the host are monitored (netdev_tap,
+ * uart). Virtual time can therefore not be used with a network interface or
+ * the shell on stdin.
+ *
  * This is based on native's hwtimer implementation by Ludwig Knüpfer.
  * I removed the multiplexing, as xtimer does the same. (kaspar)
  *
@@ -45,8 +54,12 @@
 
 #include "cpu.h"
 #include "cpu_conf.h"
+#include "async_read.h"
 #include "native_internal.h"
 #include "periph/timer.h"
+#ifdef MODULE_XTIMER
+#include "xtimer.h"
+#endif
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -55,6 +68,11 @@
 
 static unsigned long time_null;
 
+/* virtual time mode: idle time skipped so far, and the pending deadline */
+static unsigned long time_skipped;
+static unsigned int time_deadline;
+static int deadline_armed;
+
 static timer_cb_t _callback;
 static void *_cb_arg;
 
@@ -78,6 +96,7 @@ void native_isr_timer(void)
 {
     DEBUG("%s\n", __func__);
 
+    deadline_armed = 0;
     _callback(_cb_arg, 0);
 }
 
@@ -94,6 +113,7 @@ int timer_init(tim_t dev, unsigned long freq, timer_cb_t cb, void *arg)
 
     /* initialize time delta */
     time_null = 0;
+    time_skipped = 0;
     time_null = timer_read(0);
 
     _callback = cb;
@@ -113,6 +133,9 @@ static void do_timer_set(unsigned int offset)
         offset = NATIVE_TIMER_MIN_RES;
     }
 
+    deadline_armed = (offset != 0);
+    time_deadline = timer_read(0) + offset;
+
     memset(&itv, 0, sizeof(itv));
     itv.it_value.tv_sec = (offset / 1000000);
     itv.it_value.tv_usec = offset % 1000000;
@@ -200,5 +223,48 @@ unsigned int timer_read(tim_t dev)
 #endif
     _native_syscall_leave();
 
-    return ts2ticks(&t) - time_null;
+    return ts2ticks(&t) - time_null + time_skipped;
+}
+
+void native_timer_skip_idle(void)
+{
+    if (!_native_virtual_time || !deadline_armed) {
+        return;
+    }
+
+    /* input from the host (tap, uart, can) that already arrived is handled
+     * first. Later input is timestamped in virtual time, like timers. */
+    if (_native_sigpend || native_async_read_pending()) {
+        return;
+    }
+
+#ifdef MODULE_XTIMER
+    /* the deadline armed might be xtimer's tick at the end of the low-level
+     * timer period, which is always armed. Only skip to it if a timer set
+     * by the application is due by then or in a later period, otherwise the
+     * idle thread would skip from tick to tick. */
+    uint32_t target;
+    switch (xtimer_next_target(&target)) {
+        case 0:
+            if ((int)(target - time_deadline) < 0) {
+                return;
+            }
+            break;
+        case 1:
+            break;
+        default:
+            return;
+    }
+#endif
+
+    int remaining = (int)(time_deadline - timer_read(0));
+
+    /* leave the minimum resolution to the real timer, which then delivers
+     * the interrupt through the usual signal path */
+    if (remaining > NATIVE_TIMER_MIN_RES) {
+        DEBUG("native_timer_skip_idle(): skipping %i us\n",
+              remaining - NATIVE_TIMER_MIN_RES);
+        time_skipped += remaining - NATIVE_TIMER_MIN_RES;
+        do_timer_set(NATIVE_TIMER_MIN_RES);
+    }
 }
@@ -60,6 +60,7 @@ pid_t _native_pid;
 pid_t _native_id;
 unsigned _native_rng_seed = 0;
 int _native_rng_mode = 0;
+int _native_virtual_time = 0;
 const char *_native_unix_socket_path = NULL;
 
 #ifdef MODULE_NETDEV_TAP
@@ -75,7 +76,7 @@ netdev_tap_params_t netdev_tap_params[NETDEV_TAP_MAX];
 #include "candev_linux.h"
 #endif
 
-static const char short_opts[] = ":hi:s:deEoc:"
+static const char short_opts[] = ":hi:s:deEoc:V"
 #ifdef MODULE_MTD_NATIVE
     "m:"
 #endif
@@ -93,6 +94,7 @@ static const struct option long_opts[] = {
     { "stderr-noredirect", no_argument, NULL, 'E' },
     { "stdout-pipe", no_argument, NULL, 'o' },
     { "uart-tty", required_argument, NULL, 'c' },
+    { "virtual-time", no_argument, NULL, 'V' },
 #ifdef MODULE_MTD_NATIVE
     { "mtd", required_argument, NULL, 'm' },
 #endif
@@ -229,7 +231,7 @@ void usage_exit(int status)
     }
 #endif
 
-    real_printf(" [-i <id>] [-d] [-e|-E] [-o] [-c <tty>]\n");
+    real_printf(" [-i <id>] [-d] [-e|-E] [-o] [-c <tty>] [-V]\n");
 
     real_printf(" help: %s -h\n\n", _progname);
 
@@ -253,7 +255,10 @@ void usage_exit(int status)
 "        to socket\n"
 "    -c <tty>, --uart-tty=<tty>\n"
 "        specify TTY device for UART. This argument can be used multiple\n"
-"        times (up to UART_NUMOF)\n");
+"        times (up to UART_NUMOF)\n"
+"    -V, --virtual-time\n"
+"        skip idle time: when all threads are idle, advance the clock\n"
+"        straight to the next timer deadline\n");
 #ifdef MODULE_MTD_NATIVE
     real_printf(
 "    -m <mtd>, --mtd=<mtd>\n"
@@ -336,6 +341,9 @@ __attribute__((constructor)) static void startup(int argc, char **argv, char **e
             case 'c':
                 tty_uart_setup(uart++, optarg);
                 break;
+            case 'V':
+                _native_virtual_time = 1;
+                break;
 #ifdef MODULE_MTD_NATIVE
             case 'm':
                 ((mtd_native_dev_t *)mtd0)->fname = strndup(optarg, PATH_MAX - 1);
@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+# Copyright (C) 2017 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""Convert a RIOT kernel event trace dump to Chrome trace JSON.
+
+Reads the output of `trace_dump()` (or the `trace` shell command) from a
+file or stdin and writes a JSON timeline that can be opened with
+chrome://tracing or https://ui.perfetto.dev.  All non-trace lines in the
+input are ignored, so a complete terminal log can be fed in directly.
+"""
+
+import argparse
+import json
+import sys
+
+TRACE_SWITCH = 0
+TRACE_ISR_ENTER = 1
+TRACE_ISR_EXIT = 2
+TRACE_MUTEX_BLOCK = 3
+TRACE_MUTEX_UNBLOCK = 4
+TRACE_MSG_SEND = 5
+TRACE_MSG_RECV = 6
+TRACE_USER = 7
+
+INSTANT_NAMES = {
+    TRACE_MUTEX_BLOCK: "mutex block",
+    TRACE_MUTEX_UNBLOCK: "mutex unblock",
+    TRACE_MSG_SEND: "msg send",
+    TRACE_MSG_RECV: "msg recv",
+    TRACE_USER: "user",
+}
+
+# KERNEL_PID_UNDEF: no thread uses it, events recorded before the first
+# context switch carry it
+PID_ISR = 0
+
+
+def parse(lines):
+    """Return (threads, events, dropped) of the last complete dump."""
+    threads = {}
+    events = []
+    dropped = 0
+    dumps = []
+    inside = False
+
+    for line in lines:
+        fields = line.strip().split()
+        if len(fields) < 2 or fields[0] != "TRACE":
+            continue
+        if fields[1] == "BEGIN":
+            threads, events, inside = {}, [], True
+            dropped = int(fields[3]) if len(fields) > 3 else 0
+        elif not inside:
+            continue
+        elif fields[1] == "END":
+            dumps.append((threads, events, dropped))
+            inside = False
+        elif fields[1] == "THREAD":
+            threads[int(fields[2])] = " ".join(fields[3:])
+        elif len(fields) == 5:
+            events.append(tuple(int(f) for f in fields[1:]))
+
+    if not dumps:
+        raise ValueError("no complete TRACE BEGIN ... TRACE END block found")
+    return dumps[-1]
+
+
+def unwrap(events):
+    """Make 32-bit microsecond timestamps monotonic across overflows."""
+    offset = 0
+    last = None
+    for time, etype, pid, arg in events:
+        if last is not None and time < last:
+            offset += 1 << 32
+        last = time
+        yield time + offset, etype, pid, arg
+
+
+def signed16(value):
+    return value - 0x10000 if value & 0x8000 else value
+
+
+def convert(threads, events, dropped):
+    out = []
+
+    for pid, name in sorted(threads.items()):
+        out.append({"name": "thread_name", "ph": "M", "pid": 0, "tid": pid,
+                    "args": {"name": "%s (%i)" % (name, pid)}})
+    out.append({"name": "thread_name", "ph": "M", "pid": 0, "tid": PID_ISR,
+                "args": {"name": "ISR"}})
+
+    running = None
+    since = None
+    end = None
+    for time, etype, pid, arg in unwrap(events):
+        end = time
+        if etype == TRACE_SWITCH:
+            if running is not None and running != arg:
+                out.append({"name": threads.get(running, str(running)),
+                            "ph": "X", "pid": 0, "tid": running,
+                            "ts": since, "dur": time - since})
+            if running != arg:
+                running, since = arg, time
+        elif etype in (TRACE_ISR_ENTER, TRACE_ISR_EXIT):
+            out.append({"name": "irq %i" % arg,
+                        "ph": "B" if etype == TRACE_ISR_ENTER else "E",
+                        "pid": 0, "tid": PID_ISR, "ts": time})
+        else:
+            name = INSTANT_NAMES.get(etype, "type %i" % etype)
+            if etype in (TRACE_MUTEX_BLOCK, TRACE_MUTEX_UNBLOCK):
+                args = {"mutex": "0x%04x" % arg}
+            elif etype in (TRACE_MSG_SEND, TRACE_MSG_RECV):
+                args = {"peer": signed16(arg)}
+            else:
+                args = {"arg": arg}
+            out.append({"name": name, "ph": "i", "s": "t", "pid": 0,
+                        "tid": pid, "ts": time, "args": args})
+
+    if running is not None and end is not None and end > since:
+        out.append({"name": threads.get(running, str(running)), "ph": "X",
+                    "pid": 0, "tid": running, "ts": since,
+                    "dur": end - since})
+
+    return {"traceEvents": out,
+            "otherData": {"dropped": dropped}}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("input", nargs="?", type=argparse.FileType("r"),
+                        default=sys.stdin,
+                        help="terminal log containing a trace dump")
+    parser.add_argument("-o", "--output", type=argparse.FileType("w"),
+                        default=sys.stdout, help="JSON output file")
+    args = parser.parse_args()
+
+    try:
+        threads, events, dropped = parse(args.input)
+    except ValueError as e:
+        sys.exit("error: %s" % e)
+
+    if dropped:
+        sys.stderr.write("warning: %i older events were overwritten\n"
+                         % dropped)
+    json.dump(convert(threads, events, dropped), args.output)
+    args.output.write("\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -299,7 +299,9 @@ static int nd_recv(netdev_t *netdev, void *buf, size_t max_len, void *info)
             DEBUG("[enc28j60] recv: unable to get packet - buffer too small\n");
             size = 0;
         }
-        /* release memory */
+    }
+    /* release memory, also when the caller asked to drop the packet */
+    if ((buf != NULL) || (max_len > 0)) {
         cmd_w_addr(dev, ADDR_RX_READ, next);
         cmd_bfs(dev, REG_ECON2, -1, ECON2_PKTDEC);
     }
@@ -20,6 +20,8 @@
  * @}
  */
 
+#include <stdbool.h>
+
 #include "div.h"
 #include "irq.h"
 #include "xtimer.h"
@@ -79,61 +81,88 @@ static void _del_event_from_list(evtimer_t *evtimer, evtimer_event_t *event)
     }
 }
 
-static void _set_timer(xtimer_t *timer, uint32_t offset)
+/* Returns the offset of the last event (relative to the first) that still lies
+ * within the first event's tolerance window. All events up to that one are
+ * executed together. */
+static uint32_t _coalesce_span(evtimer_t *evtimer)
 {
-    uint64_t offset_in_us = (uint64_t)offset * 1000;
+    uint32_t span = 0;
+    evtimer_event_t *event = evtimer->events->next;
 
-    DEBUG("evtimer: now=%" PRIu32 " setting xtimer to %" PRIu32 ":%" PRIu32 "\n",
-          xtimer_now_usec(), (uint32_t)(offset_in_us >> 32),
-          (uint32_t)(offset_in_us));
-    _xtimer_set64(timer, offset_in_us, offset_in_us >> 32);
+    while (event && ((span + event->offset) <= evtimer->slack)) {
+        span += event->offset;
+        event = event->next;
+    }
+    return span;
 }
 
-static void _update_timer(evtimer_t *evtimer)
+/* milliseconds since evtimer_t::base. Rounded up for new events, so they
+ * don't fire early, and down for due events */
+static uint32_t _elapsed(evtimer_t *evtimer, uint64_t now, bool round_up)
 {
-    if (evtimer->events) {
-        evtimer_event_t *event = evtimer->events;
-        _set_timer(&evtimer->timer, event->offset);
-    }
-    else {
-        xtimer_remove(&evtimer->timer);
+    if (now <= evtimer->base) {
+        return 0;
     }
+    return div_u64_by_125((now - evtimer->base + (round_up ? 999 : 0)) >> 3);
 }
 
-static uint32_t _get_offset(xtimer_t *timer)
+/* Sets the xtimer for the first event. The targets of the events never
+ * change, the slack only determines the window the xtimer may fire in:
+ * from the target of the last event coalesced with the first one to the end
+ * of the first event's tolerance window. */
+static void _set_timer(evtimer_t *evtimer)
 {
     uint64_t now = xtimer_now_usec64();
-    uint64_t target = ((uint64_t)timer->long_target) << 32 | timer->target;
+    uint64_t target = evtimer->base + (uint64_t)evtimer->events->offset * 1000;
+    uint64_t start = target + (uint64_t)_coalesce_span(evtimer) * 1000;
+    uint64_t end = target + (uint64_t)evtimer->slack * 1000;
+    uint64_t offset_in_us, slack_in_us;
 
-    if (target <= now) {
-        return 0;
+    if (start < now) {
+        start = now;
     }
-    else {
-        target -= now;
-        /* add half of 125 so integer division rounds to nearest */
-        return div_u64_by_125((target >> 3) + 62);
+    offset_in_us = start - now;
+    slack_in_us = (end > start) ? (end - start) : 0;
+    if (slack_in_us > UINT32_MAX) {
+        slack_in_us = UINT32_MAX;
     }
+
+    DEBUG("evtimer: now=%" PRIu32 " setting xtimer to %" PRIu32 ":%" PRIu32
+          " slack=%" PRIu32 "\n", (uint32_t)now,
+          (uint32_t)(offset_in_us >> 32), (uint32_t)(offset_in_us),
+          (uint32_t)slack_in_us);
+    _xtimer_set_slack64(&evtimer->timer, offset_in_us, offset_in_us >> 32,
+                        slack_in_us);
 }
 
-static void _update_head_offset(evtimer_t *evtimer)
+static void _update_timer(evtimer_t *evtimer)
 {
     if (evtimer->events) {
-        evtimer_event_t *event = evtimer->events;
-        event->offset = _get_offset(&evtimer->timer);
-        DEBUG("evtimer: _update_head_offset(): new head offset %" PRIu32 "\n", event->offset);
+        _set_timer(evtimer);
+    }
+    else {
+        xtimer_remove(&evtimer->timer);
     }
 }
 
 void evtimer_add(evtimer_t *evtimer, evtimer_event_t *event)
 {
     unsigned state = irq_disable();
+    uint64_t now = xtimer_now_usec64();
 
     DEBUG("evtimer_add(): adding event with offset %" PRIu32 "\n", event->offset);
 
-    _update_head_offset(evtimer);
+    /* the offsets in the list are relative to base, the one of event to now */
+    if (evtimer->events == NULL) {
+        evtimer->base = now;
+    }
+    else {
+        event->offset += _elapsed(evtimer, now, true);
+    }
     evtimer_add_event_to_list(evtimer, event);
-    if (evtimer->events == event) {
-        _set_timer(&evtimer->timer, event->offset);
+    /* with slack, the new event might extend the set of coalesced events */
+    if ((evtimer->events == event) || evtimer->slack) {
+        _set_timer(evtimer);
     }
     irq_restore(state);
     if (sched_context_switch_request) {
@@ -147,25 +176,11 @@ void evtimer_del(evtimer_t *evtimer, evtimer_event_t *event)
 
     DEBUG("evtimer_del(): removing event with offset %" PRIu32 "\n", event->offset);
 
-    _update_head_offset(evtimer);
     _del_event_from_list(evtimer, event);
     _update_timer(evtimer);
     irq_restore(state);
 }
 
-static evtimer_event_t *_get_next(evtimer_t *evtimer)
-{
-    evtimer_event_t *event = evtimer->events;
-
-    if (event && (event->offset == 0)) {
-        evtimer->events = event->next;
-        return event;
-    }
-    else {
-        return NULL;
-    }
-}
-
 static void _evtimer_handler(void *arg)
 {
     DEBUG("_evtimer_handler()\n");
@@ -173,12 +188,21 @@ static void _evtimer_handler(void *arg)
     evtimer_t *evtimer = (evtimer_t *)arg;
 
     /* this function gets called directly by xtimer if the set xtimer expired.
-     * Thus the offset of the first event is down to zero. */
-    evtimer_event_t *event = evtimer->events;
-    event->offset = 0;
-
-    /* iterate the event list */
-    while ((event = _get_next(evtimer))) {
+     * The first event and those coalesced with it are due, and so is any
+     * event whose target passed while the xtimer fired late. */
+    uint32_t due = evtimer->events->offset + _coalesce_span(evtimer);
+    uint32_t elapsed = _elapsed(evtimer, xtimer_now_usec64(), false);
+    evtimer_event_t *event;
+
+    if (due < elapsed) {
+        due = elapsed;
+    }
+    /* iterate the event list, base follows the targets of the events */
+    while ((event = evtimer->events) && (event->offset <= due)) {
+        due -= event->offset;
+        evtimer->base += (uint64_t)event->offset * 1000;
+        evtimer->events = event->next;
+        event->offset = 0;
         evtimer->callback(event);
     }
 
@@ -191,6 +215,8 @@ void evtimer_init(evtimer_t *evtimer, evtimer_callback_t handler)
     evtimer->timer.callback = _evtimer_handler;
     evtimer->timer.arg = (void *)evtimer;
     evtimer->events = NULL;
+    evtimer->base = 0;
+    evtimer->slack = 0;
 }
 
 void evtimer_print(const evtimer_t *evtimer)
@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_event Event Queue
+ * @ingroup     sys
+ * @brief       Provides an event queue for deferred callbacks
+ *
+ * Many modules need a thread of their own only to execute small pieces of
+ * code outside of interrupt context or on timer expiry. With messages, every
+ * such thread costs a stack and a message queue.
+ *
+ * This module provides "intrusive" event objects: an event is embedded in
+ * the user's data structure and carries its own handler function, so posting
+ * an event neither copies data nor allocates memory and cannot fail. Any
+ * number of modules can post their events to the same @ref event_queue_t,
+ * and thereby share a single handler thread.
+ *
+ * - events can be posted from ISR's, other threads or the handler thread
+ *   itself
+ * - posting an event that is already queued has no effect, so an event is
+ *   never executed more than once per post
+ * - the handler thread is woken up using @ref core_thread_flags
+ *   "thread flags" (@ref THREAD_FLAG_EVENT), so it can wait for events and
+ *   messages or other thread flags at the same time
+ *
+ * Example:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * static void handler(event_t *event)
+ * {
+ *     printf("triggered 0x%08x\n", (unsigned)event);
+ * }
+ *
+ * static event_t event = { .handler = handler };
+ *
+ * int main(void)
+ * {
+ *     event_queue_t queue;
+ *
+ *     event_queue_init(&queue);
+ *     event_post(&queue, &event);
+ *     event_loop(&queue);
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @{
+ *
+ * @file
+ * @brief       Event API
+ */
+
+#ifndef EVENT_H
+#define EVENT_H
+
+#include <stdint.h>
+
+#include "clist.h"
+#include "thread.h"
+#include "thread_flags.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef THREAD_FLAG_EVENT
+/**
+ * @brief   Thread flag used for signaling events to the handler thread
+ */
+#define THREAD_FLAG_EVENT   (0x1)
+#endif
+
+/**
+ * @brief   Event structure forward declaration
+ */
+typedef struct event event_t;
+
+/**
+ * @brief   Event handler type definition
+ */
+typedef void (*event_handler_t)(event_t *);
+
+/**
+ * @brief   Event structure
+ *
+ * Extend by embedding as first member, see e.g. @ref event_callback_t.
+ */
+struct event {
+    clist_node_t list_node;     /**< event queue list entry */
+    event_handler_t handler;    /**< pointer to event handler function */
+};
+
+/**
+ * @brief   Event queue structure
+ */
+typedef struct {
+    clist_node_t event_list;    /**< list of queued events */
+    thread_t *waiter;           /**< thread owning the event queue */
+} event_queue_t;
+
+/**
+ * @brief   Initialize an event queue
+ *
+ * The calling thread becomes the owner of the queue, i.e. it is the thread
+ * that gets woken up on event_post().
+ *
+ * @param[out]  queue   event queue object to initialize
+ */
+void event_queue_init(event_queue_t *queue);
+
+/**
+ * @brief   Queue an event
+ *
+ * Does nothing if @p event is already queued. May be called from interrupt
+ * context.
+ *
+ * @param[in]   queue   event queue to queue event in
+ * @param[in]   event   event to queue in event queue
+ */
+void event_post(event_queue_t *queue, event_t *event);
+
+/**
+ * @brief   Cancel a queued event
+ *
+ * Does nothing if @p event is not queued. May be called from interrupt
+ * context.
+ *
+ * @param[in]   queue   event queue to remove event from
+ * @param[in]   event   event to remove from queue
+ */
+void event_cancel(event_queue_t *queue, event_t *event);
+
+/**
+ * @brief   Get next event from event queue, non-blocking
+ *
+ * @param[in]   queue   event queue to get event from
+ *
+ * @return  pointer to next event
+ * @return  NULL if no event available
+ */
+event_t *event_get(event_queue_t *queue);
+
+/**
+ * @brief   Get next event from event queue, blocking
+ *
+ * Must only be called by the thread owning @p queue.
+ *
+ * @param[in]   queue   event queue to get event from
+ *
+ * @return  pointer to next event
+ */
+event_t *event_wait(event_queue_t *queue);
+
+/**
+ * @brief   Simple event loop
+ *
+ * Waits for events on @p queue and executes their handlers, forever.
+ *
+ * @param[in]   queue   event queue to process
+ */
+static inline void event_loop(event_queue_t *queue)
+{
+    while (1) {
+        event_t *event = event_wait(queue);
+        event->handler(event);
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVENT_H */
+/** @} */
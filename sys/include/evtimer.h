@@ -72,6 +72,10 @@ typedef struct {
     evtimer_callback_t callback;    /**< Handler function for this evtimer's
                                          event type */
     evtimer_event_t *events;        /**< Event queue */
+    uint64_t base;                  /**< Time in microseconds the offset of
+                                         the first event is relative to */
+    uint32_t slack;                 /**< Tolerance in milliseconds events may
+                                         be delayed by */
 } evtimer_t;
 
 /**
@@ -82,6 +86,24 @@ typedef struct {
  */
 void evtimer_init(evtimer_t *evtimer, evtimer_callback_t handler);
 
+/**
+ * @brief   Sets the tolerance of an event timer
+ *
+ * Events of @p evtimer may be executed up to @p slack milliseconds after
+ * their offset. Events within that window of each other are executed
+ * together, and the underlying xtimer is set with the remaining slack (see
+ * xtimer_set_slack()), so it can be coalesced with other timers, too. The
+ * slack does not accumulate: every event keeps its own target, so an event
+ * is never executed later than @p slack milliseconds after it.
+ *
+ * @param[in] evtimer   An event timer
+ * @param[in] slack     Tolerance in milliseconds, 0 for exact timing (default)
+ */
+static inline void evtimer_set_slack(evtimer_t *evtimer, uint32_t slack)
+{
+    evtimer->slack = slack;
+}
+
 /**
  * @brief   Adds event to an event timer
  *
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_memarray Memory pool
+ * @ingroup     sys
+ * @brief       Fixed-size block allocator on top of a static array
+ * @{
+ *
+ * @file
+ * @brief       Memory pool interface definition
+ *
+ * A memarray hands out fixed-size blocks of a user supplied array in O(1).
+ * Returned blocks are kept in a free list that is linked through the blocks
+ * themselves, so there is no per-block overhead: while a block is free,
+ * its first `sizeof(void *)` bytes hold the link to the next free block,
+ * the remaining bytes are left untouched. Blocks that were never allocated
+ * are handed out in array order, so a statically initialized memarray
+ * (see @ref MEMARRAY_INIT) needs no initialization at runtime.
+ *
+ * memarray_alloc() and memarray_free() may be called from interrupt
+ * context.
+ *
+ * Each memarray counts the blocks currently in use, the maximum number of
+ * blocks ever in use simultaneously and the number of failed allocations.
+ */
+
+#ifndef MEMARRAY_H
+#define MEMARRAY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Memory pool descriptor
+ */
+typedef struct {
+    void *free_list;    /**< first block of the free list */
+    uint8_t *data;      /**< memory the blocks are taken from */
+    size_t size;        /**< size of a single block */
+    size_t num;         /**< number of blocks in memarray_t::data */
+    size_t used;        /**< number of blocks currently allocated */
+    size_t high_water;  /**< maximum of memarray_t::used. Blocks from this
+                         *   index on were never allocated */
+    unsigned failed;    /**< number of failed allocations */
+} memarray_t;
+
+/**
+ * @brief   Static initializer for a memarray
+ *
+ * @param[in] data  array the blocks are taken from
+ * @param[in] size  size of a single block, must be >= `sizeof(void *)`
+ * @param[in] num   number of blocks in @p data
+ */
+#define MEMARRAY_INIT(data, size, num)  { NULL, (uint8_t *)(data), (size), \
+                                          (num), 0, 0, 0 }
+
+/**
+ * @brief   Initialize a memarray
+ *
+ * All blocks become free and the statistics are reset.
+ *
+ * @param[out] mem  memarray to initialize
+ * @param[in] data  array the blocks are taken from
+ * @param[in] size  size of a single block, must be >= `sizeof(void *)`
+ * @param[in] num   number of blocks in @p data
+ */
+void memarray_init(memarray_t *mem, void *data, size_t size, size_t num);
+
+/**
+ * @brief   Allocate a block
+ *
+ * @param[in,out] mem   memarray to allocate from
+ *
+ * @return  pointer to a block of memarray_t::size bytes, contents undefined
+ * @return  NULL, if all blocks are in use
+ */
+void *memarray_alloc(memarray_t *mem);
+
+/**
+ * @brief   Return a block to its memarray
+ *
+ * @param[in,out] mem   memarray @p ptr was allocated from
+ * @param[in] ptr       block to free, must not be NULL
+ */
+void memarray_free(memarray_t *mem, void *ptr);
+
+/**
+ * @brief   Get the number of free blocks
+ *
+ * @param[in] mem   memarray to check
+ *
+ * @return  number of blocks that can still be allocated
+ */
+static inline size_t memarray_available(const memarray_t *mem)
+{
+    return mem->num - mem->used;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MEMARRAY_H */
+/** @} */
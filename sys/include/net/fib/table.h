@@ -35,6 +35,20 @@ extern "C" {
  */
 #define FIB_MAX_REGISTERED_RP (5)
 
+/**
+ * @brief Node of the longest-prefix-match trie of a FIB table
+ *
+ * Links are node IDs: IDs `1 .. size` refer to fib_entry_t::node of entry
+ * `ID - 1`, IDs `size + 1 .. 2 * size` to the fib_entry_t::glue of entry
+ * `ID - size - 1`. 0 is used as NULL, so a zeroed table is an empty trie.
+ */
+typedef struct {
+    uint16_t child[2];  /**< sub-tries for the next bit being 0 or 1 */
+    uint16_t parent;    /**< parent node, 0 for the root */
+    uint16_t bit;       /**< length of the prefix represented by this node
+                         *   in bits, including the 8 bit address size tag */
+} fib_trie_node_t;
+
 /**
  * @brief Container descriptor for a FIB entry
  */
@@ -51,6 +65,16 @@ typedef struct {
     uint32_t next_hop_flags;
     /** Pointer to the shared generic address */
     universal_address_container_t *next_hop;
+    /** Trie node of this entry */
+    fib_trie_node_t node;
+    /** Storage for one branching node of the trie, managed by the table */
+    fib_trie_node_t glue;
+    /** Next entry with the identical prefix (index + 1), 0 for none */
+    uint16_t dup;
+    /** Entry (index + 1) at the heap position of this index */
+    uint16_t heap;
+    /** Position + 1 of this entry in the expiry heap, 0 if not expiring */
+    uint16_t heap_pos;
 } fib_entry_t;
 
 /**
@@ -117,7 +141,8 @@ typedef struct {
     *   This value indicates what is stored in `data` of this table
     */
     uint8_t table_type;
-    /** the maximim number of entries in this FIB table */
+    /** the maximim number of entries in this FIB table
+     *  (at most 32767 for single hop tables) */
     size_t size;
     /** table access mutex to grant exclusive operations on calls */
     mutex_t mtx_access;
@@ -133,6 +158,14 @@ typedef struct {
     *   e.g. when the unreachable destination is covered by the prefix
     */
     universal_address_container_t* prefix_rp[FIB_MAX_REGISTERED_RP];
+    /** root node of the longest-prefix-match trie (single hop tables) */
+    uint16_t trie_root;
+    /** list of released glue nodes */
+    uint16_t glue_free;
+    /** number of glue nodes ever handed out */
+    uint16_t glue_used;
+    /** number of entries in the expiry heap */
+    uint16_t heap_len;
 } fib_table_t;
 
 #ifdef __cplusplus
@@ -34,6 +34,7 @@
 #include "thread.h"
 
 #include "net/ipv6.h"
+#include "net/gnrc/ipv6/flowc.h"
 #include "net/gnrc/ipv6/ext.h"
 #include "net/gnrc/ipv6/hdr.h"
 #include "net/gnrc/ipv6/nc.h"
@@ -49,10 +50,18 @@ extern "C" {
 
 /**
  * @brief   Default stack size to use for the IPv6 thread
+ *
+ * @note    With @ref net_gnrc_netapi_inline the IPv6 thread also runs
+ *          6LoWPAN and UDP, so it gets the stack of one of those threads on
+ *          top.
  */
 #ifndef GNRC_IPV6_STACK_SIZE
+#ifdef MODULE_GNRC_NETAPI_INLINE
+#define GNRC_IPV6_STACK_SIZE        (2 * THREAD_STACKSIZE_DEFAULT)
+#else
 #define GNRC_IPV6_STACK_SIZE        (THREAD_STACKSIZE_DEFAULT)
 #endif
+#endif
 
 /**
  * @brief   Default priority for the IPv6 thread
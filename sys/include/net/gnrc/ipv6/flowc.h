@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_ipv6_flowc IPv6 flow cache
+ * @ingroup     net_gnrc_ipv6
+ * @brief       Caches the result of next hop determination per destination
+ *
+ * Sending a unicast packet to a non-local destination requires a FIB
+ * lookup, a neighbor cache lookup and (for packets originating from this
+ * node) source address selection. This module keeps a small direct-mapped
+ * cache keyed by destination address (and the interface requested by the
+ * sender) that stores the outcome of these steps: the outgoing interface,
+ * the link-layer address of the next hop and the source address.
+ *
+ * The whole cache is invalidated on any change to the FIB, the neighbor
+ * cache or the address configuration of an IPv6 interface. Additionally,
+ * entries expire after @ref GNRC_IPV6_FLOWC_LIFETIME, since FIB entries
+ * time out without any explicit event.
+ *
+ * @{
+ *
+ * @file
+ * @brief   IPv6 flow cache definitions
+ */
+#ifndef NET_GNRC_IPV6_FLOWC_H
+#define NET_GNRC_IPV6_FLOWC_H
+
+#include <stdint.h>
+
+#include "kernel_types.h"
+#include "net/ipv6/addr.h"
+#include "timex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of entries in the flow cache
+ *
+ * @note    Must be a power of two.
+ */
+#ifndef GNRC_IPV6_FLOWC_SIZE
+#define GNRC_IPV6_FLOWC_SIZE        (8U)
+#endif
+
+/**
+ * @brief   Lifetime of a flow cache entry in microseconds
+ */
+#ifndef GNRC_IPV6_FLOWC_LIFETIME
+#define GNRC_IPV6_FLOWC_LIFETIME    (1U * US_PER_SEC)
+#endif
+
+/**
+ * @brief   Flow cache statistics
+ */
+typedef struct {
+    uint32_t hits;          /**< lookups answered from the cache */
+    uint32_t misses;        /**< lookups not answered from the cache */
+    uint32_t invalidations; /**< number of times the cache was flushed */
+} gnrc_ipv6_flowc_stats_t;
+
+#if defined(MODULE_GNRC_IPV6_FLOWC) || defined(DOXYGEN)
+/**
+ * @brief   Looks up the next hop for a destination in the flow cache
+ *
+ * @param[in] iface         The interface requested by the sender. May be
+ *                          KERNEL_PID_UNDEF.
+ * @param[in] dst           The destination address.
+ * @param[out] l2addr       The link-layer address of the next hop. Must be
+ *                          at least @ref GNRC_IPV6_NC_L2_ADDR_MAX long.
+ * @param[out] l2addr_len   The length of @p l2addr.
+ * @param[out] src          The source address to use for @p dst. May be
+ *                          NULL. Stays unchanged if the cached source
+ *                          address is unspecified.
+ *
+ * @return  The interface to send over, on a cache hit.
+ * @return  KERNEL_PID_UNDEF, on a cache miss.
+ */
+kernel_pid_t gnrc_ipv6_flowc_get(kernel_pid_t iface, const ipv6_addr_t *dst,
+                                 uint8_t *l2addr, uint8_t *l2addr_len,
+                                 ipv6_addr_t *src);
+
+/**
+ * @brief   Returns the current generation of the flow cache
+ *
+ * The generation changes with every call of @ref gnrc_ipv6_flowc_invalidate().
+ * Take it before determining the next hop that is passed to
+ * @ref gnrc_ipv6_flowc_add().
+ *
+ * @return  The current generation of the flow cache.
+ */
+unsigned gnrc_ipv6_flowc_gen(void);
+
+/**
+ * @brief   Stores the result of a next hop determination in the flow cache
+ *
+ * The source address for the flow is selected with
+ * @ref gnrc_ipv6_netif_find_best_src_addr(). An existing entry mapped to
+ * the same slot is replaced. Nothing is stored if the cache was invalidated
+ * since @p gen was taken, as the result may be based on stale state then.
+ *
+ * @param[in] gen           The generation of the flow cache before the next
+ *                          hop was determined, see @ref gnrc_ipv6_flowc_gen().
+ * @param[in] req_iface     The interface requested by the sender. May be
+ *                          KERNEL_PID_UNDEF.
+ * @param[in] dst           The destination address.
+ * @param[in] iface         The interface determined for @p dst.
+ * @param[in] l2addr        The link-layer address of the next hop.
+ * @param[in] l2addr_len    The length of @p l2addr.
+ */
+void gnrc_ipv6_flowc_add(unsigned gen, kernel_pid_t req_iface,
+                         const ipv6_addr_t *dst, kernel_pid_t iface,
+                         const uint8_t *l2addr, uint8_t l2addr_len);
+
+/**
+ * @brief   Invalidates all entries of the flow cache
+ *
+ * To be called whenever routing, neighbor or interface address state
+ * changes.
+ */
+void gnrc_ipv6_flowc_invalidate(void);
+
+/**
+ * @brief   Returns the statistics of the flow cache
+ *
+ * @return  The statistics of the flow cache.
+ */
+const gnrc_ipv6_flowc_stats_t *gnrc_ipv6_flowc_get_stats(void);
+
+/**
+ * @brief   Prints the statistics and the entries of the flow cache
+ */
+void gnrc_ipv6_flowc_print(void);
+#else
+static inline void gnrc_ipv6_flowc_invalidate(void)
+{
+    return;
+}
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_IPV6_FLOWC_H */
+/** @} */
@@ -44,6 +44,21 @@ extern "C" {
 #define GNRC_IPV6_NC_SIZE           (GNRC_NETIF_NUMOF * 8)
 #endif
 
+#ifndef GNRC_IPV6_NC_HASH_SIZE
+/**
+ * @brief   The number of buckets of the hash table over the neighbor cache
+ *
+ * @note    Must be a power of two.
+ */
+#if GNRC_IPV6_NC_SIZE > 128
+#define GNRC_IPV6_NC_HASH_SIZE      (64U)
+#elif GNRC_IPV6_NC_SIZE > 32
+#define GNRC_IPV6_NC_HASH_SIZE      (16U)
+#else
+#define GNRC_IPV6_NC_HASH_SIZE      (8U)
+#endif
+#endif
+
 #ifndef GNRC_IPV6_NC_L2_ADDR_MAX
 /**
  * @brief   The maximum size of a link layer address
@@ -163,11 +178,28 @@ typedef struct {
 #endif
 
     uint8_t probes_remaining;               /**< remaining number of unanswered probes */
+
+    /**
+     * @brief   Next entry (index + 1) in the same hash bucket or, for unused
+     *          entries, in the list of free entries
+     */
+    uint16_t hash_next;
+    uint16_t lru_prev;                      /**< more recently used entry (index + 1) */
+    uint16_t lru_next;                      /**< less recently used entry (index + 1) */
     /**
      * @}
      */
 } gnrc_ipv6_nc_t;
 
+/**
+ * @brief   Neighbor cache statistics
+ */
+typedef struct {
+    uint32_t hits;          /**< lookups that found an entry */
+    uint32_t misses;        /**< lookups that found no entry */
+    uint32_t evictions;     /**< stale entries replaced by new neighbors */
+} gnrc_ipv6_nc_stats_t;
+
 /**
  * @brief   Initializes neighbor cache
  */
@@ -176,6 +208,10 @@ void gnrc_ipv6_nc_init(void);
 /**
  * @brief   Adds a neighbor to the neighbor cache
  *
+ * If the neighbor cache is full, the least recently used entry in state
+ * @ref GNRC_IPV6_NC_STATE_STALE that is neither a router nor registered via
+ * 6LoWPAN-ND is replaced.
+ *
  * @param[in] iface         PID to the interface where the neighbor is.
  * @param[in] ipv6_addr     IPv6 address of the neighbor. Must not be NULL.
  * @param[in] l2_addr       Link layer address of the neighbor. NULL if unknown.
@@ -309,6 +345,13 @@ gnrc_ipv6_nc_t *gnrc_ipv6_nc_still_reachable(const ipv6_addr_t *ipv6_addr);
 kernel_pid_t gnrc_ipv6_nc_get_l2_addr(uint8_t *l2_addr, uint8_t *l2_addr_len,
                                       const gnrc_ipv6_nc_t *entry);
 
+/**
+ * @brief   Returns the statistics of the neighbor cache
+ *
+ * @return  The statistics of the neighbor cache.
+ */
+const gnrc_ipv6_nc_stats_t *gnrc_ipv6_nc_get_stats(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -51,6 +51,30 @@
  * USEMODULE += gnrc_netapi_callbacks
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  * @}
+ *
+ * @defgroup    net_gnrc_netapi_inline   Run-to-completion mode
+ * @ingroup     net_gnrc_netapi
+ * @brief       Run the GNRC stack within a single thread
+ * @{
+ * @details The submodule `gnrc_netapi_inline` makes the 6LoWPAN, IPv6 and UDP
+ *          modules register @ref GNRC_NETREG_TYPE_CB "callbacks" instead of
+ *          running their own threads. All callbacks are executed in one
+ *          stack thread (the IPv6 thread, see @ref gnrc_netapi_inline_pid):
+ *          a packet handed to the stack by another thread (e.g. a network
+ *          device or an application) enters the stack thread with a single
+ *          @ref core_msg "message" and is then passed down or up the stack by
+ *          direct function calls. This saves a context switch per layer and
+ *          the stacks of the 6LoWPAN and UDP threads, but the stack thread
+ *          needs enough stack for the whole call chain (see
+ *          @ref GNRC_IPV6_STACK_SIZE).
+ *
+ * To use, add the module `gnrc_netapi_inline` to the `USEMODULE` macro in
+ * your application's Makefile:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ {.mk}
+ * USEMODULE += gnrc_netapi_inline
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * @}
  * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
  * @author      Hauke Petersen <hauke.petersen@fu-berlin.de>
  */
@@ -206,6 +230,47 @@ int gnrc_netapi_get(kernel_pid_t pid, netopt_t opt, uint16_t context,
 int gnrc_netapi_set(kernel_pid_t pid, netopt_t opt, uint16_t context,
                     void *data, size_t data_len);
 
+#if defined(MODULE_GNRC_NETAPI_INLINE) || defined(DOXYGEN)
+/**
+ * @brief   @ref core_msg type for handing a callback over to the stack thread
+ *
+ * @note    Only available with @ref net_gnrc_netapi_inline.
+ */
+#define GNRC_NETAPI_MSG_TYPE_INLINE     (0x0207)
+
+/**
+ * @brief   Number of callbacks that can wait for the stack thread at once
+ *
+ * @note    Only available with @ref net_gnrc_netapi_inline.
+ */
+#ifndef GNRC_NETAPI_INLINE_QUEUE_SIZE
+#define GNRC_NETAPI_INLINE_QUEUE_SIZE   (8U)
+#endif
+
+/**
+ * @brief   PID of the thread all @ref GNRC_NETREG_TYPE_CB "callbacks" run in
+ *
+ * @details A callback dispatched from any other thread is handed to this
+ *          thread with a @ref GNRC_NETAPI_MSG_TYPE_INLINE message. If
+ *          KERNEL_PID_UNDEF, callbacks are called in the dispatching thread.
+ *
+ * @note    Only available with @ref net_gnrc_netapi_inline.
+ */
+extern kernel_pid_t gnrc_netapi_inline_pid;
+
+/**
+ * @brief   Runs a callback handed over with a
+ *          @ref GNRC_NETAPI_MSG_TYPE_INLINE message
+ *
+ * @pre     Called by thread @ref gnrc_netapi_inline_pid
+ *
+ * @note    Only available with @ref net_gnrc_netapi_inline.
+ *
+ * @param[in] msg   A message of type @ref GNRC_NETAPI_MSG_TYPE_INLINE
+ */
+void gnrc_netapi_inline_handle(msg_t *msg);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -116,6 +116,16 @@ typedef struct gnrc_netdev {
      */
     kernel_pid_t pid;
 
+    /**
+     * @brief Headroom to reserve in front of received frames
+     *
+     * Used by link layers with variable header length to receive frames so
+     * that their header can be split off without copying the payload (see
+     * gnrc_pktbuf_headroom()). It is predicted from the header length of the
+     * last received frame.
+     */
+    uint8_t rx_headroom;
+
 #ifdef MODULE_GNRC_MAC
     /**
      * @brief general information for the MAC protocol
@@ -72,6 +72,17 @@ typedef enum {
 } gnrc_netreg_type_t;
 #endif
 
+/**
+ * @brief   Number of hash buckets of the registry
+ *
+ * @details Entries are hashed by their protocol type and
+ *          gnrc_netreg_entry_t::demux_ctx, so lookups only need to traverse
+ *          the entries of one bucket. Must be a power of two.
+ */
+#ifndef GNRC_NETREG_BUCKETS
+#define GNRC_NETREG_BUCKETS     (16U)
+#endif
+
 /**
  * @brief   Demux context value to get all packets of a certain type.
  *
@@ -93,12 +104,14 @@ typedef enum {
  *
  * @return  An initialized netreg entry
  */
-#ifdef MODULE_GNRC_NETAPI_MBOX
+#if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
 #define GNRC_NETREG_ENTRY_INIT_PID(demux_ctx, pid)  { NULL, demux_ctx, \
                                                       GNRC_NETREG_TYPE_DEFAULT, \
-                                                      { pid } }
+                                                      { pid }, \
+                                                      GNRC_NETTYPE_UNDEF }
 #else
-#define GNRC_NETREG_ENTRY_INIT_PID(demux_ctx, pid)  { NULL, demux_ctx, { pid } }
+#define GNRC_NETREG_ENTRY_INIT_PID(demux_ctx, pid)  { NULL, demux_ctx, { pid }, \
+                                                      GNRC_NETTYPE_UNDEF }
 #endif
 
 #if defined(MODULE_GNRC_NETAPI_MBOX) || defined(DOXYGEN)
@@ -115,7 +128,8 @@ typedef enum {
  */
 #define GNRC_NETREG_ENTRY_INIT_MBOX(demux_ctx, mbox) { NULL, demux_ctx, \
                                                        GNRC_NETREG_TYPE_MBOX, \
-                                                       { .mbox = mbox } }
+                                                       { .mbox = mbox }, \
+                                                       GNRC_NETTYPE_UNDEF }
 #endif
 
 #if defined(MODULE_GNRC_NETAPI_CALLBACKS) || defined(DOXYGEN)
@@ -124,15 +138,16 @@ typedef enum {
  *
  * @param[in] demux_ctx The @ref gnrc_netreg_entry_t::demux_ctx "demux context"
  *                      for the netreg entry
- * @param[in] cbd       Target callback for the registry entry
+ * @param[in] _cbd      Target callback for the registry entry
  *
  * @note    Only available with @ref net_gnrc_netapi_callbacks.
  *
  * @return  An initialized netreg entry
  */
-#define GNRC_NETREG_ENTRY_INIT_CB(demux_ctx, cbd)   { NULL, demux_ctx, \
+#define GNRC_NETREG_ENTRY_INIT_CB(demux_ctx, _cbd)  { NULL, demux_ctx, \
                                                       GNRC_NETREG_TYPE_CB, \
-                                                      { .cbd = cbd } }
+                                                      { .cbd = _cbd }, \
+                                                      GNRC_NETTYPE_UNDEF }
 /** @} */
 
 /**
@@ -210,6 +225,12 @@ typedef struct gnrc_netreg_entry {
         gnrc_netreg_entry_cbd_t *cbd;
 #endif
     } target;                   /**< Target for the registry entry */
+    /**
+     * @brief   Protocol type the entry is registered for
+     *
+     * @internal    Set by gnrc_netreg_register()
+     */
+    gnrc_nettype_t nettype;
 } gnrc_netreg_entry_t;
 
 /**
@@ -241,6 +262,7 @@ static inline void gnrc_netreg_entry_init_pid(gnrc_netreg_entry_t *entry,
     entry->type = GNRC_NETREG_TYPE_DEFAULT;
 #endif
     entry->target.pid = pid;
+    entry->nettype = GNRC_NETTYPE_UNDEF;
 }
 
 #if defined(MODULE_GNRC_NETAPI_MBOX) || defined(DOXYGEN)
@@ -262,6 +284,7 @@ static inline void gnrc_netreg_entry_init_mbox(gnrc_netreg_entry_t *entry,
     entry->demux_ctx = demux_ctx;
     entry->type = GNRC_NETREG_TYPE_MBOX;
     entry->target.mbox = mbox;
+    entry->nettype = GNRC_NETTYPE_UNDEF;
 }
 #endif
 
@@ -284,6 +307,7 @@ static inline void gnrc_netreg_entry_init_cb(gnrc_netreg_entry_t *entry,
     entry->demux_ctx = demux_ctx;
     entry->type = GNRC_NETREG_TYPE_CB;
     entry->target.cbd = cbd;
+    entry->nettype = GNRC_NETTYPE_UNDEF;
 }
 #endif
 /** @} */
@@ -18,6 +18,20 @@
  *          this *will* lead to alignment problems and can potentially result
  *          in segmentation/hard faults and other unexpected behaviour.
  *
+ * There are two implementations of the packet buffer, both working on a
+ * static array of @ref GNRC_PKTBUF_SIZE bytes:
+ *
+ * - `gnrc_pktbuf_static` (default) keeps an address ordered list of holes
+ *   and allocates first-fit. It has no memory overhead beyond the array but
+ *   allocation and release take time linear in the number of holes.
+ * - `gnrc_pktbuf_sizeclass` keeps the holes in segregated free lists per
+ *   size class and merges adjacent holes using boundary tags, so allocation
+ *   and release take constant time and full-MTU packets are less likely to
+ *   fail in a fragmented buffer. It needs about
+ *   `(GNRC_PKTBUF_SIZE / sizeof(void *)) / 8 + 68` bytes of additional RAM
+ *   and @ref GNRC_PKTBUF_SIZE must be smaller than 65535.
+ *   Select it with `USEMODULE += gnrc_pktbuf_sizeclass`.
+ *
  * @{
  *
  * @file
@@ -87,6 +101,84 @@ void gnrc_pktbuf_init(void);
 gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, void *data, size_t size,
                                 gnrc_nettype_t type);
 
+/**
+ * @brief   Callback for the release of a snip created by gnrc_pktbuf_add_ext()
+ *
+ * @warning Called with the packet buffer locked, so it must not call any
+ *          `gnrc_pktbuf_*` function.
+ *
+ * @param[in] arg   The argument given to gnrc_pktbuf_add_ext().
+ * @param[in] data  The data of the released snip.
+ * @param[in] size  The size of the released snip.
+ */
+typedef void (*gnrc_pktbuf_ext_cb_t)(void *arg, const void *data, size_t size);
+
+/**
+ * @brief   Adds a new gnrc_pktsnip_t that references data outside of the
+ *          packet buffer
+ *
+ * Only the snip descriptor is allocated in the packet buffer, @p data is not
+ * copied. The caller has to keep @p data unchanged until @p cb is called,
+ * which happens exactly once, when the last user released the snip.
+ *
+ * The snip is read-only: gnrc_pktbuf_start_write() always returns a copy in
+ * the packet buffer, gnrc_pktbuf_mark() and gnrc_pktbuf_realloc_data() must
+ * not be used on it.
+ *
+ * @pre `data != NULL && size > 0`
+ *
+ * @param[in] next      Next gnrc_pktsnip_t in the packet. Leave NULL if you
+ *                      want to create a new packet.
+ * @param[in] data      Data of the new gnrc_pktsnip_t.
+ * @param[in] size      Length of @p data.
+ * @param[in] type      Protocol type of the gnrc_pktsnip_t.
+ * @param[in] cb        Called when the snip is released. May be NULL if
+ *                      @p data stays valid anyway.
+ * @param[in] arg       Argument for @p cb.
+ *
+ * @return  Pointer to the packet part that represents the new gnrc_pktsnip_t.
+ * @return  NULL, if no space is left in the packet buffer.
+ */
+gnrc_pktsnip_t *gnrc_pktbuf_add_ext(gnrc_pktsnip_t *next, const void *data,
+                                    size_t size, gnrc_nettype_t type,
+                                    gnrc_pktbuf_ext_cb_t cb, void *arg);
+
+/**
+ * @brief   Checks if the data of a snip is outside of the packet buffer
+ *
+ * @param[in] pkt   A packet snip.
+ *
+ * @return  true, if @p pkt was created by gnrc_pktbuf_add_ext().
+ * @return  false, otherwise.
+ */
+bool gnrc_pktbuf_is_ext(const gnrc_pktsnip_t *pkt);
+
+/**
+ * @brief   Calculates the headroom to reserve in front of a header, so it can
+ *          be marked without moving data around
+ *
+ * gnrc_pktbuf_mark() can only split off a header in place if the marked
+ * section ends on a chunk boundary of the packet buffer. Receivers can
+ * allocate a snip with this many additional bytes, receive the frame
+ * behind them and then mark `gnrc_pktbuf_headroom(hdr_len) + hdr_len` bytes.
+ * The header is then found at offset `gnrc_pktbuf_headroom(hdr_len)` of the
+ * marked snip and the payload is not copied (unless it is very short).
+ *
+ * @param[in] hdr_len   Length of the header.
+ *
+ * @return  Number of bytes to put in front of the header.
+ */
+static inline size_t gnrc_pktbuf_headroom(size_t hdr_len)
+{
+    /* both packet buffer implementations align chunks to pointer size and
+     * need at least two pointers for their bookkeeping of free chunks */
+    size_t marked = (hdr_len < (2 * sizeof(void *))) ? (2 * sizeof(void *)) :
+                                                       hdr_len;
+
+    marked = (marked + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+    return marked - hdr_len;
+}
+
 /**
  * @brief   Marks the first @p size bytes in a received packet with a new
  *          packet snip that is appended to the packet.
@@ -115,6 +207,7 @@ gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, void *data, size_t size,
  *
  * @return  The new packet snip in @p pkt on success.
  * @return  NULL, if pkt == NULL or size == 0 or size > pkt->size or pkt->data == NULL.
+ * @return  NULL, if @p pkt was created by gnrc_pktbuf_add_ext().
  * @return  NULL, if no space is left in the packet buffer.
  */
 gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t type);
@@ -175,7 +268,8 @@ static inline void gnrc_pktbuf_release(gnrc_pktsnip_t *pkt)
  * @brief   Must be called once before there is a write operation in a thread.
  *
  * @details This function duplicates a packet in the packet buffer if
- *          gnrc_pktsnip_t::users of @p pkt > 1.
+ *          gnrc_pktsnip_t::users of @p pkt > 1 or if its data is not in the
+ *          packet buffer (see gnrc_pktbuf_add_ext()).
  *
  * @note    Do *not* call this function in a thread twice on the same packet.
  *
@@ -281,7 +375,13 @@ gnrc_pktsnip_t *gnrc_pktbuf_duplicate_upto(gnrc_pktsnip_t *pkt, gnrc_nettype_t t
  *
  * @note    Only available with DEVELHELP defined.
  *
- * @details Statistics include maximum number of reserved bytes.
+ * @details Statistics include maximum number of reserved bytes and the
+ *          number of bytes gnrc_pktbuf_mark() and gnrc_pktbuf_realloc_data()
+ *          had to move to keep chunks apart as well as the number of bytes
+ *          gnrc_pktbuf_add_ext() referenced instead of copying them.
+ *          `gnrc_pktbuf_sizeclass` additionally reports the number of failed
+ *          allocations, the free bytes, the largest free block and the
+ *          resulting fragmentation.
  */
 void gnrc_pktbuf_stats(void);
 #endif
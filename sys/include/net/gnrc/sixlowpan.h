@@ -84,7 +84,12 @@
  *
  * ## `GNRC_NETAPI_MSG_TYPE_SET`
  *
- * `GNRC_NETAPI_MSG_TYPE_SET` is not supported.
+ * `GNRC_NETAPI_MSG_TYPE_SET` is only supported for @ref NETOPT_ADDRESS,
+ * @ref NETOPT_ADDRESS_LONG and @ref NETOPT_SRC_LEN with the context being a 6LoWPAN compatible
+ * interface. The option is passed on to the interface thread and, on success, the compression
+ * cache of @ref net_gnrc_sixlowpan_iphc is invalidated. Set the link-layer address of a 6LoWPAN
+ * interface this way to have it picked up by header compression immediately. This is not
+ * available with `gnrc_netapi_inline`.
  *
  * ## `GNRC_NETAPI_MSG_TYPE_GET`
  *
@@ -140,6 +145,8 @@ extern "C" {
  *          the 6LoWPAN thread.
  *
  * @return  The PID to the 6LoWPAN thread, on success.
+ * @return  KERNEL_PID_UNDEF, with @ref net_gnrc_netapi_inline, where 6LoWPAN
+ *          runs in the stack thread instead of its own.
  * @return  -EINVAL, if @ref GNRC_SIXLOWPAN_PRIO was greater than or equal to
  *          @ref SCHED_PRIO_LEVELS
  * @return  -EOVERFLOW, if there are too many threads running already in general
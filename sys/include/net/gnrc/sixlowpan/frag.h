@@ -32,16 +32,41 @@
 #include "kernel_types.h"
 #include "net/gnrc/pkt.h"
 #include "net/sixlowpan.h"
+#include "timex.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 /**
- * @brief   Message type for passing one 6LoWPAN fragment down the network stack
+ * @brief   Number of fragments handed to the interface at once
+ *
+ * Should not exceed the message queue size of the interface's thread.
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_BATCH_SIZE
+#define GNRC_SIXLOWPAN_FRAG_BATCH_SIZE  (8U)
+#endif
+
+/**
+ * @brief   Time in microseconds to wait before handing the rest of a datagram
+ *          to an interface whose message queue was full
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_RETRY_DELAY
+#define GNRC_SIXLOWPAN_FRAG_RETRY_DELAY (5U * US_PER_MS)
+#endif
+
+/**
+ * @brief   Message type for continuing the fragmentation of a datagram once
+ *          the interface's message queue has space again
  */
 #define GNRC_SIXLOWPAN_MSG_FRAG_SND    (0x0225)
 
+/**
+ * @brief   Message type for triggering garbage collection of the reassembly
+ *          buffer
+ */
+#define GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF (0x0226)
+
 /**
  * @brief   Definition of 6LoWPAN fragmentation type.
  */
@@ -49,13 +74,32 @@ typedef struct {
     kernel_pid_t pid;       /**< PID of the interface */
     gnrc_pktsnip_t *pkt;    /**< Pointer to the IPv6 packet to be fragmented */
     size_t datagram_size;   /**< Length of just the IPv6 packet to be fragmented */
-    uint16_t offset;        /**< Offset of the Nth fragment from the beginning of the
-                             *   payload datagram */
+    uint16_t offset;        /**< Offset of the next fragment from the beginning of the
+                             *   (compressed) datagram. gnrc_sixlowpan_msg_frag_t::pkt
+                             *   only holds what is left behind this offset. */
+    uint16_t tag;           /**< Tag of the datagram */
 } gnrc_sixlowpan_msg_frag_t;
 
+/**
+ * @brief   Generates a new datagram tag for a datagram sent by this node
+ *
+ * @return  A tag not used for any recently sent datagram.
+ */
+uint16_t gnrc_sixlowpan_frag_next_tag(void);
+
 /**
  * @brief   Sends a packet fragmented.
  *
+ * The payload of the packet is cut into the fragments and the fragments are
+ * handed to the interface in batches of @ref GNRC_SIXLOWPAN_FRAG_BATCH_SIZE.
+ * Cutting off the first fragment generally copies the payload snip it ends
+ * in once, since that cut is not aligned within the packet buffer (see
+ * @ref gnrc_pktbuf_mark()). A payload that is also held by someone else is
+ * copied once up front instead. Only if the interface does not take a whole
+ * batch, the remaining fragments are sent on reception of a
+ * @ref GNRC_SIXLOWPAN_MSG_FRAG_SND message that a timer sends to the calling
+ * thread after @ref GNRC_SIXLOWPAN_FRAG_RETRY_DELAY.
+ *
  * @param[in] fragment_msg    Message containing status of the 6LoWPAN
  *                            fragmentation progress
  */
@@ -68,6 +112,16 @@ void gnrc_sixlowpan_frag_send(gnrc_sixlowpan_msg_frag_t *fragment_msg);
  */
 void gnrc_sixlowpan_frag_handle_pkt(gnrc_pktsnip_t *pkt);
 
+/**
+ * @brief   Removes timed out datagrams from the reassembly buffer.
+ *
+ * To be called on reception of @ref GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF. The
+ * reassembly buffer sends this message to the thread that received the
+ * fragments, or with @ref net_gnrc_netapi_inline to the thread running the
+ * stack, when the oldest incomplete datagram times out.
+ */
+void gnrc_sixlowpan_frag_gc_rbuf(void);
+
 #ifdef __cplusplus
 }
 #endif
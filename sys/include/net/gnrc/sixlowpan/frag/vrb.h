@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_sixlowpan_frag_vrb 6LoWPAN virtual reassembly buffer
+ * @ingroup     net_gnrc_sixlowpan_frag
+ * @brief       Forwards 6LoWPAN fragments without reassembling their datagram
+ *
+ * A router that receives the first fragment of a datagram it has to forward
+ * over a 6LoWPAN interface only inspects the IPv6 header in that fragment.
+ * It remembers the link-layer source and tag of the datagram together with
+ * the next hop and a new tag in the virtual reassembly buffer (VRB) and
+ * relays this and all subsequent fragments right away, only replacing the
+ * link-layer header and the tag.
+ *
+ * The next hop is taken from the @ref net_gnrc_ipv6_flowc. Datagrams are
+ * reassembled and forwarded by @ref net_gnrc_ipv6 as before if
+ *
+ * - there is no flow cache entry for their destination (the forwarding of
+ *   a reassembled datagram creates one),
+ * - the first fragment does not arrive first,
+ * - the compressed IPv6 header derives an address from the link-layer
+ *   addresses, since they change on every hop, or
+ * - the hop limit expires on this hop.
+ *
+ * @see <a href="https://tools.ietf.org/html/draft-ietf-lwig-6lowpan-virtual-reassembly-00">
+ *          draft-ietf-lwig-6lowpan-virtual-reassembly-00
+ *      </a>
+ *
+ * @{
+ *
+ * @file
+ * @brief   6LoWPAN virtual reassembly buffer definitions
+ */
+#ifndef NET_GNRC_SIXLOWPAN_FRAG_VRB_H
+#define NET_GNRC_SIXLOWPAN_FRAG_VRB_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "net/gnrc/pkt.h"
+#include "timex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of datagrams that can be forwarded at the same time
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_VRB_SIZE
+#define GNRC_SIXLOWPAN_FRAG_VRB_SIZE    (16U)
+#endif
+
+/**
+ * @brief   Time in microseconds after the last fragment of a datagram, after
+ *          which its entry in the virtual reassembly buffer is dropped
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT
+#define GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT (3U * US_PER_SEC)
+#endif
+
+/**
+ * @brief   Virtual reassembly buffer statistics
+ */
+typedef struct {
+    uint32_t datagrams;     /**< datagrams forwarded without reassembly */
+    uint32_t fragments;     /**< fragments forwarded without reassembly */
+    uint32_t evictions;     /**< entries dropped before they timed out */
+} gnrc_sixlowpan_frag_vrb_stats_t;
+
+/**
+ * @brief   Forwards a fragment if its datagram is not to be reassembled
+ *
+ * @pre `pkt->next` is the interface header of the fragment.
+ *
+ * @param[in] pkt       A received fragment.
+ * @param[in] offset    The offset of the fragment in its datagram in bytes.
+ *
+ * @return  true, if @p pkt was forwarded (or dropped) and released.
+ * @return  false, if @p pkt was not touched and is to be reassembled.
+ */
+bool gnrc_sixlowpan_frag_vrb_forward(gnrc_pktsnip_t *pkt, size_t offset);
+
+/**
+ * @brief   Returns the statistics of the virtual reassembly buffer
+ *
+ * @return  The statistics of the virtual reassembly buffer.
+ */
+const gnrc_sixlowpan_frag_vrb_stats_t *gnrc_sixlowpan_frag_vrb_get_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_SIXLOWPAN_FRAG_VRB_H */
+/** @} */
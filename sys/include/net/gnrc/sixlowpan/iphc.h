@@ -10,6 +10,25 @@
  * @defgroup    net_gnrc_sixlowpan_iphc   IPv6 header compression (IPHC)
  * @ingroup     net_gnrc_sixlowpan
  * @brief       IPv6 header compression for 6LoWPAN.
+ *
+ * With the `gnrc_sixlowpan_iphc_cache` module, the outcome of compressing
+ * the IPv6 header and (with `gnrc_sixlowpan_iphc_nhc`) the UDP header of a
+ * packet is kept in a small direct-mapped cache. A packet of the same flow,
+ * i.e. with the same addresses, traffic class, flow label, hop limit, next
+ * header and UDP ports that is sent over the same interface to the same
+ * link-layer destination, is then compressed by copying the stored headers
+ * and only filling in the UDP checksum. This saves the context lookups, the
+ * address compression decisions and, if the interface header carries no
+ * source address, the query for the interface identifier of the interface.
+ *
+ * The cache is invalidated on any change to the compression contexts and
+ * whenever a link-layer address or its length is set through the 6LoWPAN
+ * thread (see @ref net_gnrc_sixlowpan), since addresses are elided based on
+ * the link-layer address of the interface if the interface header carries
+ * none. A link-layer address set directly at the interface thread is only
+ * picked up once the entries expired. Entries expire after
+ * @ref GNRC_SIXLOWPAN_IPHC_CACHE_LIFETIME, since contexts time out without
+ * any explicit event.
  * @{
  *
  * @file
@@ -21,14 +40,41 @@
 #define NET_GNRC_SIXLOWPAN_IPHC_H
 
 #include <stdbool.h>
+#include <stdint.h>
 
 #include "net/gnrc/pkt.h"
 #include "net/sixlowpan.h"
+#include "timex.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief   Number of entries in the compression cache
+ *
+ * @note    Must be a power of two.
+ */
+#ifndef GNRC_SIXLOWPAN_IPHC_CACHE_SIZE
+#define GNRC_SIXLOWPAN_IPHC_CACHE_SIZE      (4U)
+#endif
+
+/**
+ * @brief   Lifetime of a compression cache entry in microseconds
+ */
+#ifndef GNRC_SIXLOWPAN_IPHC_CACHE_LIFETIME
+#define GNRC_SIXLOWPAN_IPHC_CACHE_LIFETIME  (1U * US_PER_SEC)
+#endif
+
+/**
+ * @brief   Compression cache statistics
+ */
+typedef struct {
+    uint32_t hits;          /**< packets compressed from the cache */
+    uint32_t misses;        /**< packets compressed from scratch */
+    uint32_t invalidations; /**< number of times the cache was flushed */
+} gnrc_sixlowpan_iphc_cache_stats_t;
+
 /**
  * @brief   Decompresses a received 6LoWPAN IPHC frame.
  *
@@ -61,6 +107,28 @@ size_t gnrc_sixlowpan_iphc_decode(gnrc_pktsnip_t **dec_hdr, gnrc_pktsnip_t *pkt,
  */
 bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt);
 
+#if defined(MODULE_GNRC_SIXLOWPAN_IPHC_CACHE) || defined(DOXYGEN)
+/**
+ * @brief   Invalidates all entries of the compression cache
+ *
+ * To be called whenever a compression context or the link-layer address of
+ * an interface changes.
+ */
+void gnrc_sixlowpan_iphc_cache_invalidate(void);
+
+/**
+ * @brief   Returns the statistics of the compression cache
+ *
+ * @return  The statistics of the compression cache.
+ */
+const gnrc_sixlowpan_iphc_cache_stats_t *gnrc_sixlowpan_iphc_cache_get_stats(void);
+#else
+static inline void gnrc_sixlowpan_iphc_cache_invalidate(void)
+{
+    return;
+}
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2016 Martine Lenders <mlenders@inf.fu-berlin.de>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_sock
+ * @{
+ *
+ * @file
+ * @brief   GNRC-specific extensions of the UDP sock API
+ *
+ * @author  Martine Lenders <mlenders@inf.fu-berlin.de>
+ */
+#ifndef NET_GNRC_SOCK_UDP_H
+#define NET_GNRC_SOCK_UDP_H
+
+#include <stddef.h>
+#include <sys/types.h>
+
+#include "net/gnrc/pktbuf.h"
+#include "net/sock/udp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Sends a UDP message to remote end point without copying @p data
+ *
+ * Behaves like @ref sock_udp_send(), but the payload of the sent packet
+ * references @p data instead of a copy of it in the packet buffer (see
+ * @ref gnrc_pktbuf_add_ext()). This saves copying @p len bytes per message.
+ *
+ * @pre `((sock != NULL) || (remote != NULL))`
+ * @pre `(data != NULL) && (len > 0)`
+ *
+ * @param[in] sock      A UDP sock object. May be `NULL`.
+ *                      A sensible local end point should be selected by the
+ *                      implementation in that case.
+ * @param[in] data      Pointer to the payload to send. Must stay unchanged
+ *                      until @p cb was called.
+ * @param[in] len       Length of @p data.
+ * @param[in] remote    Remote end point for the sent data. May be `NULL`,
+ *                      if @p sock has a remote end point.
+ * @param[in] cb        Called exactly once when @p data is not referenced
+ *                      anymore, also if an error is returned. May run with
+ *                      the packet buffer locked and in another thread.
+ *                      May be NULL.
+ * @param[in] arg       Argument for @p cb.
+ *
+ * @return  The number of bytes sent on success.
+ * @return  See @ref sock_udp_send() for the errors.
+ */
+ssize_t gnrc_sock_udp_send_ext(sock_udp_t *sock, const void *data, size_t len,
+                               const sock_udp_ep_t *remote,
+                               gnrc_pktbuf_ext_cb_t cb, void *arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_SOCK_UDP_H */
+/** @} */
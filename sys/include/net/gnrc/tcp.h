@@ -24,6 +24,7 @@
 
 #include <stdint.h>
 #include "net/gnrc/pkt.h"
+#include "net/gnrc/pktbuf.h"
 #include "net/gnrc/tcp/tcb.h"
 
 #ifdef MODULE_GNRC_IPV6
@@ -92,7 +93,8 @@ int gnrc_tcp_open_active(gnrc_tcp_tcb_t *tcb,  const uint8_t address_family,
  * @pre if local_port is not zero.
  *
  * @note Blocks until a connection has been established (incomming connection request
- *       to @p local_port) or an error occured.
+ *       to @p local_port) or an error occured. The receive buffer of the TCB is
+ *       allocated when a connection request arrives.
  *
  * @param[in,out] tcb              TCB holding the connection information.
  * @param[in]     address_family   Address family of @p local_addr.
@@ -106,12 +108,87 @@ int gnrc_tcp_open_active(gnrc_tcp_tcb_t *tcb,  const uint8_t address_family,
  *            -EAFNOSUPPORT if local_addr != NULL and @p address_family is not supported.
  *            -EINVAL if @p address_family is not the same the address_family used in TCB.
  *            -EISCONN if TCB is already in use.
- *            -ENOMEM if the receive buffer for the TCB could not be allocated.
- *            Hint: Increase "GNRC_TCP_RCV_BUFFERS".
  */
 int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb,  const uint8_t address_family,
                           const uint8_t *local_addr, const uint16_t local_port);
 
+/**
+ * @brief Waits for incomming connections on a local port with a pool of TCBs.
+ *
+ * Every TCB in @p tcbs waits for a connection request. An established
+ * connection is handed out by gnrc_tcp_accept(). After gnrc_tcp_close() or
+ * gnrc_tcp_abort() returned for such a connection, its TCB waits for the
+ * next connection request and must not be used by the caller anymore. If
+ * gnrc_tcp_close() could not close the connection gracefully, it is aborted.
+ * Connections that were reset before they were accepted are reused as well.
+ *
+ * @pre @p queue must not be NULL.
+ * @pre @p tcbs must not be NULL and @p tcbs_len must not be 0.
+ * @pre @p local_port must not be zero.
+ * @pre if local_addr is not NULL, local_addr must be assigned to a network interface.
+ *
+ * @note @p tcbs_len is the backlog: It limits the number of connections that are
+ *       in setup, wait to be accepted or were accepted and not closed yet. A
+ *       receive buffer is allocated when a connection request arrives. Requests
+ *       that arrive while all "GNRC_TCP_RCV_BUFFERS" are in use are dropped
+ *       and retried by the peer.
+ *
+ * @param[out]    queue            Listening queue to initialize.
+ * @param[in,out] tcbs             TCBs used for incomming connections. They are
+ *                                 initialized by this function.
+ * @param[in]     tcbs_len         Number of TCBs in @p tcbs.
+ * @param[in]     address_family   Address family of @p local_addr.
+ *                                 If local_addr == NULL, address_family is ignored.
+ * @param[in]     local_addr       If not NULL connections are bound to @p local_addr.
+ *                                 If NULL a connection request to all local ip
+ *                                 addresses is valied.
+ * @param[in]     local_port       Port number to listen on.
+ *
+ * @returns   Zero on success.
+ *            -EAFNOSUPPORT if local_addr != NULL and @p address_family is not supported.
+ */
+int gnrc_tcp_listen(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t *tcbs, const size_t tcbs_len,
+                    const uint8_t address_family, const uint8_t *local_addr,
+                    const uint16_t local_port);
+
+/**
+ * @brief Accepts an established connection of a listening queue.
+ *
+ * @pre gnrc_tcp_listen() must have been successfully called on @p queue.
+ * @pre @p queue must not be NULL.
+ * @pre @p tcb must not be NULL.
+ *
+ * @param[in,out] queue                      Listening queue to take a connection from.
+ * @param[out]    tcb                        TCB of the accepted connection.
+ * @param[in]     user_timeout_duration_us   If zero and no connection is established,
+ *                                           the function returns immediately. If not
+ *                                           zero the function blocks until a connection
+ *                                           is established or @p user_timeout_duration_us
+ *                                           microseconds passed.
+ *
+ * @returns   Zero on success.
+ *            -EINVAL if @p queue is not listening or listening was stopped
+ *            while waiting.
+ *            -EAGAIN if user_timeout_duration_us is zero and no connection is established.
+ *            -ETIMEDOUT if @p user_timeout_duration_us expired.
+ */
+int gnrc_tcp_accept(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t **tcb,
+                    const uint32_t user_timeout_duration_us);
+
+/**
+ * @brief Stops waiting for incomming connections.
+ *
+ * Connections that were not accepted yet are aborted. Accepted connections stay
+ * open, their TCBs are not reused after they were closed. Threads blocked in
+ * gnrc_tcp_accept() on @p queue return -EINVAL. @p queue must stay valid until
+ * they returned.
+ *
+ * @pre @p queue must not be NULL.
+ *
+ * @param[in,out] queue   Listening queue to stop.
+ */
+void gnrc_tcp_stop_listen(gnrc_tcp_tcb_queue_t *queue);
+
 /**
  * @brief Transmit data to connected peer.
  *
@@ -120,6 +197,9 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb,  const uint8_t address_family,
  * @pre @p data must not be NULL.
  *
  * @note Blocks until up to @p len bytes were transmitted or an error occured.
+ *       Transmitted data is kept in the send queue until the peer acknowledged it,
+ *       the function does not wait for these acknowledgments. It only blocks while
+ *       the send window, the congestion window or the send queue are full.
  *
  * @param[in,out] tcb                        TCB holding the connection information.
  * @param[in]     data                       Pointer to the data that should be transmitted.
@@ -137,6 +217,47 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb,  const uint8_t address_family,
 ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                       const uint32_t user_timeout_duration_us);
 
+/**
+ * @brief Transmit data to connected peer without copying it.
+ *
+ * Behaves like gnrc_tcp_send(), but the sent segments reference @p data instead
+ * of copying it into the packet buffer (see gnrc_pktbuf_add_ext()). This saves
+ * one copy of every sent byte and the packet buffer space for the send queue.
+ *
+ * @pre gnrc_tcp_tcb_init() must have been successfully called.
+ * @pre @p tcb must not be NULL.
+ * @pre @p data must not be NULL.
+ *
+ * @note @p cb is called once for every segment built from @p data, when the
+ *       segment was acknowledged or dropped with the connection. The sizes
+ *       passed to @p cb add up to the returned number of bytes. Until then the
+ *       first that many bytes of @p data must not be changed. The rest of
+ *       @p data is not referenced.
+ *
+ * @warning @p cb is called from the TCP or network stack threads with the
+ *          packet buffer locked. It must not block or call `gnrc_pktbuf_*`
+ *          functions.
+ *
+ * @param[in,out] tcb                        TCB holding the connection information.
+ * @param[in]     data                       Pointer to the data that should be transmitted.
+ * @param[in]     len                        Number of bytes that should be transmitted.
+ * @param[in]     user_timeout_duration_us   If not zero and there was not data transmitted
+ *                                           the function returns after user_timeout_duration_us.
+ *                                           If zero, no timeout will be triggered.
+ * @param[in]     cb                         Called when a segment released its part
+ *                                           of @p data. May be NULL.
+ * @param[in]     arg                        Argument for @p cb.
+ *
+ * @returns   The number of successfully transmitted bytes.
+ *            -ENOTCONN if connection is not established.
+ *            -ECONNRESET if connection was resetted by the peer.
+ *            -ECONNABORTED if the connection was aborted.
+ *            -ETIMEDOUT if @p user_timeout_duration_us expired.
+ */
+ssize_t gnrc_tcp_send_ext(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
+                          const uint32_t user_timeout_duration_us,
+                          gnrc_pktbuf_ext_cb_t cb, void *arg);
+
 /**
  * @brief Receive Data from the peer.
  *
@@ -55,9 +55,12 @@ extern "C" {
 
 /**
  * @brief MSS Multiplicator = Number of MSS sized packets stored in receive buffer
+ *
+ * The receive buffer limits the window advertised to the peer. With a single MSS,
+ * the peer can only have one segment in flight and a transfer runs stop-and-wait.
  */
 #ifndef GNRC_TCP_MSS_MULTIPLICATOR
-#define GNRC_TCP_MSS_MULTIPLICATOR (1U)
+#define GNRC_TCP_MSS_MULTIPLICATOR (2U)
 #endif
 
 /**
@@ -69,6 +72,8 @@ extern "C" {
 
 /**
  * @brief Number of preallocated receive buffers
+ *
+ * Limits the number of connections that are in setup or open at the same time.
  */
 #ifndef GNRC_TCP_RCV_BUFFERS
 #define GNRC_TCP_RCV_BUFFERS (1U)
@@ -81,6 +86,22 @@ extern "C" {
 #define GNRC_TCP_RCV_BUF_SIZE (GNRC_TCP_DEFAULT_WINDOW)
 #endif
 
+/**
+ * @brief Maximum number of unacknowledged segments per connection (send queue size)
+ *
+ * Each queued segment stays in the packet buffer until it was acknowledged.
+ */
+#ifndef GNRC_TCP_SND_QUEUE_SIZE
+#define GNRC_TCP_SND_QUEUE_SIZE (4U)
+#endif
+
+/**
+ * @brief Number of duplicate ACKs that trigger a fast retransmit (see RFC 5681)
+ */
+#ifndef GNRC_TCP_DUP_ACK_THRESHOLD
+#define GNRC_TCP_DUP_ACK_THRESHOLD (3U)
+#endif
+
 /**
  * @brief Lower bound for RTO = 1 sec (see RFC 6298)
  */
@@ -22,6 +22,7 @@
 #ifndef NET_GNRC_TCP_TCB_H
 #define NET_GNRC_TCP_TCB_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include "kernel_types.h"
 #include "ringbuffer.h"
@@ -45,6 +46,9 @@ extern "C" {
  */
 #define GNRC_TCP_TCB_MBOX_SIZE (8U)
 
+struct _tcb_queue;
+struct _tcb_queue_waiter;
+
 /**
  * @brief Transmission control block of GNRC TCP.
  */
@@ -68,23 +72,53 @@ typedef struct _transmission_control_block {
     uint32_t iss;          /**< Initial sequence sumber */
     uint32_t irs;          /**< Initial received sequence number */
     uint16_t mss;          /**< The peers MSS */
+    uint32_t cwnd;         /**< Congestion window */
+    uint32_t ssthresh;     /**< Slow start threshold */
+    uint32_t recover;      /**< Highest SeqNo. sent when loss recovery started */
+    uint8_t dup_acks;      /**< Number of consecutive duplicate ACKs */
     uint32_t rtt_start;    /**< Timer value for rtt estimation */
+    uint32_t rtt_seq;      /**< SeqNo. whose acknowledgment ends the rtt measurement */
     int32_t rtt_var;       /**< Round trip time variance */
     int32_t srtt;          /**< Smoothed round trip time */
     int32_t rto;           /**< Retransmission timeout duration */
-    uint8_t retries;       /**< Number of retransmissions */
+    uint8_t retries;       /**< Number of retransmission timeouts */
     xtimer_t tim_tout;     /**< Timer struct for timeouts */
     msg_t msg_tout;        /**< Message, sent on timeouts */
-    gnrc_pktsnip_t *pkt_retransmit;   /**< Pointer to packet in "retransmit queue" */
+    /**
+     * @brief Unacknowledged segments, oldest first. The additional slot is kept for a FIN.
+     */
+    gnrc_pktsnip_t *snd_queue[GNRC_TCP_SND_QUEUE_SIZE + 1];
+    uint8_t snd_queue_len; /**< Number of segments in snd_queue */
     msg_t mbox_raw[GNRC_TCP_TCB_MBOX_SIZE];   /**< Msg queue for mbox */
     mbox_t mbox;             /**< TCB mbox for synchronization */
     uint8_t *rcv_buf_raw;    /**< Pointer to the receive buffer */
     ringbuffer_t rcv_buf;    /**< Receive buffer data structure */
+    /* The members below outlive a connection of a listening queue's TCB */
     mutex_t fsm_lock;        /**< Mutex for FSM access synchronization */
     mutex_t function_lock;   /**< Mutex for function call synchronization */
+    struct _tcb_queue *queue;   /**< Listening queue the TCB belongs to, NULL if none */
     struct _transmission_control_block *next;   /**< Pointer next TCB */
 } gnrc_tcp_tcb_t;
 
+/**
+ * @brief Listening queue of GNRC TCP.
+ *
+ * All TCBs of a listening queue wait for connection requests on the same local
+ * port. Each of them takes care of one incomming connection, so the number of
+ * TCBs limits the number of connections that are in setup or wait to be accepted.
+ */
+typedef struct _tcb_queue {
+    gnrc_tcp_tcb_t *tcbs;     /**< TCBs handed out to incomming connections */
+    size_t tcbs_len;          /**< Number of TCBs in tcbs */
+#ifdef MODULE_GNRC_IPV6
+    uint8_t local_addr[sizeof(ipv6_addr_t)];  /**< Local IP address, unspecified for any */
+#endif
+    uint16_t local_port;      /**< Local port number to listen on */
+    mutex_t lock;             /**< Mutex for queue access synchronization */
+    mutex_t waiters_lock;     /**< Mutex protecting waiters */
+    struct _tcb_queue_waiter *waiters;  /**< Threads blocked in gnrc_tcp_accept() */
+} gnrc_tcp_tcb_queue_t;
+
 #ifdef __cplusplus
 }
 #endif
@@ -84,6 +84,8 @@ gnrc_pktsnip_t *gnrc_udp_hdr_build(gnrc_pktsnip_t *payload, uint16_t src,
  * @brief   Initialize and start UDP
  *
  * @return  PID of the UDP thread
+ * @return  KERNEL_PID_UNDEF, with @ref net_gnrc_netapi_inline, where UDP runs
+ *          in the stack thread instead of its own
  * @return  negative value on error
  */
 int gnrc_udp_init(void);
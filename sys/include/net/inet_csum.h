@@ -73,6 +73,56 @@ static inline uint16_t inet_csum(uint16_t sum, const uint8_t *buf, uint16_t len)
     return inet_csum_slice(sum, buf, len, 0);
 }
 
+/**
+ * @brief   Updates a normalized Internet Checksum for a changed 16-bit word
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc1624">
+ *          RFC 1624
+ *      </a>
+ *
+ * @details Lets forwarding or header rewriting adjust a checksum without
+ *          summing the full domain again.
+ *
+ * @param[in] csum      The checksum as found in the header (i.e. normalized)
+ *                      in host byte order.
+ * @param[in] old_val   The old value of the word in host byte order.
+ * @param[in] new_val   The new value of the word in host byte order.
+ *
+ * @return  The updated normalized checksum in host byte order.
+ */
+static inline uint16_t inet_csum_update16(uint16_t csum, uint16_t old_val,
+                                          uint16_t new_val)
+{
+    /* RFC 1624, eqn. 3: HC' = ~(~HC + ~m + m') */
+    uint32_t sum = (uint16_t)~csum + (uint16_t)~old_val + new_val;
+
+    sum = (sum & 0xffff) + (sum >> 16);
+    sum = (sum & 0xffff) + (sum >> 16);
+    return (uint16_t)~sum;
+}
+
+/**
+ * @brief   Updates a normalized Internet Checksum for a changed field
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc1624">
+ *          RFC 1624
+ *      </a>
+ *
+ * @details Like inet_csum_update16() but for a field of @p len bytes, e.g. an
+ *          address. The field must start at an even offset within the
+ *          checksum domain.
+ *
+ * @param[in] csum      The checksum as found in the header (i.e. normalized)
+ *                      in host byte order.
+ * @param[in] old_val   The old content of the field.
+ * @param[in] new_val   The new content of the field.
+ * @param[in] len       Length of the field in byte.
+ *
+ * @return  The updated normalized checksum in host byte order.
+ */
+uint16_t inet_csum_update(uint16_t csum, const uint8_t *old_val,
+                          const uint8_t *new_val, uint16_t len);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_trace Kernel event trace
+ * @ingroup     sys
+ * @brief       Records scheduler, interrupt, mutex and message events into
+ *              a binary ring buffer
+ *
+ * When the module `trace` is used, the kernel records
+ *
+ * - context switches (@ref TRACE_SWITCH),
+ * - interrupt entry and exit (@ref TRACE_ISR_ENTER, @ref TRACE_ISR_EXIT,
+ *   currently only on native),
+ * - threads blocking on and being woken from mutexes
+ *   (@ref TRACE_MUTEX_BLOCK, @ref TRACE_MUTEX_UNBLOCK) and
+ * - messages being sent and received (@ref TRACE_MSG_SEND,
+ *   @ref TRACE_MSG_RECV)
+ *
+ * into a ring of @ref TRACE_BUF_SIZE fixed-size entries. Once the ring is
+ * full, the oldest entries are overwritten. Recording an event costs one
+ * timer read and an 8 byte copy with interrupts disabled.
+ *
+ * trace_dump() (or the shell command `trace dump`) prints the ring framed
+ * by `TRACE BEGIN` and `TRACE END`, one event per line as decimal time,
+ * type, pid and argument. The script
+ * `dist/tools/trace/trace2json.py` converts such output into a JSON
+ * timeline that can be viewed with chrome://tracing or Perfetto.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Kernel event trace interface
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of events in the trace ring, must be a power of two
+ */
+#ifndef TRACE_BUF_SIZE
+#define TRACE_BUF_SIZE      (256U)
+#endif
+
+/**
+ * @brief   Trace event types
+ */
+typedef enum {
+    TRACE_SWITCH = 0,       /**< switch to thread, arg: pid of next thread */
+    TRACE_ISR_ENTER,        /**< interrupt entry, arg: interrupt number */
+    TRACE_ISR_EXIT,         /**< interrupt exit, arg: interrupt number */
+    TRACE_MUTEX_BLOCK,      /**< thread blocks on mutex, arg: mutex address */
+    TRACE_MUTEX_UNBLOCK,    /**< mutex hands over to waiter, arg: mutex address */
+    TRACE_MSG_SEND,         /**< message sent, arg: target pid */
+    TRACE_MSG_RECV,         /**< message received, arg: sender pid */
+    TRACE_USER,             /**< application defined, first free type */
+} trace_type_t;
+
+/**
+ * @brief   A recorded trace event
+ */
+typedef struct {
+    uint32_t time;          /**< time stamp in microseconds */
+    uint8_t type;           /**< event type, see trace_type_t */
+    int8_t pid;             /**< pid of the active thread */
+    uint16_t arg;           /**< type specific argument, addresses are
+                             *   truncated to their lower 16 bit */
+} trace_event_t;
+
+#if defined(MODULE_TRACE) || defined(DOXYGEN)
+/**
+ * @brief   Record an event
+ *
+ * May be called from any context.
+ *
+ * @param[in] type  event type
+ * @param[in] arg   type specific argument
+ */
+void trace_record(unsigned type, unsigned arg);
+
+/**
+ * @brief   Start or stop recording
+ *
+ * Recording is enabled on boot.
+ *
+ * @param[in] enable    0 to pause recording, anything else to resume
+ */
+void trace_enable(int enable);
+
+/**
+ * @brief   Drop all recorded events
+ */
+void trace_clear(void);
+
+/**
+ * @brief   Copy the recorded events, oldest first
+ *
+ * @param[out] events   buffer to copy the events to
+ * @param[in] max       size of @p events in events
+ *
+ * @return  number of events copied
+ */
+unsigned trace_read(trace_event_t *events, unsigned max);
+
+/**
+ * @brief   Print the recorded events to stdio in the format understood by
+ *          `dist/tools/trace/trace2json.py`
+ *
+ * Recording is paused while printing.
+ */
+void trace_dump(void);
+
+/**
+ * @brief   Record an event, compiled out without module `trace`
+ */
+#define TRACE(type, arg)    trace_record(type, (unsigned)(uintptr_t)(arg))
+#else
+#define TRACE(type, arg)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRACE_H */
+/** @} */
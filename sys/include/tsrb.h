@@ -18,6 +18,10 @@
  * @note        This ringbuffer implementation can be used without locking if
  *              there's only one producer and one consumer.
  *
+ * Besides copying data in and out, tsrb allows producers to write directly
+ * into the buffer using tsrb_reserve() and tsrb_commit(), and consumers to
+ * read directly from it using tsrb_peek_region() and tsrb_release().
+ *
  * @attention   Buffer size must be a power of two!
  *
  * @author      Kaspar Schleiser <kaspar@schleiser.de>
@@ -110,6 +114,77 @@ static inline unsigned int tsrb_free(const tsrb_t *rb)
     return (rb->size - rb->writes + rb->reads);
 }
 
+/**
+ * @brief       Reserve a contiguous region for writing
+ *
+ * Returns the largest contiguous free region at the write position. Data
+ * written to it becomes visible to the consumer only after tsrb_commit().
+ * As the region ends at the end of the underlying buffer, call this function
+ * again after committing to get the wrapped-around part.
+ *
+ * @param[in]   rb      Ringbuffer to operate on
+ * @param[out]  region  start of the free region
+ * @return      size of the free region, 0 if the ringbuffer is full
+ */
+static inline size_t tsrb_reserve(tsrb_t *rb, char **region)
+{
+    unsigned pos = rb->writes & (rb->size - 1);
+    unsigned space = tsrb_free(rb);
+    unsigned contig = rb->size - pos;
+
+    *region = &rb->buf[pos];
+    return (space < contig) ? space : contig;
+}
+
+/**
+ * @brief       Commit data written to a region returned by tsrb_reserve()
+ * @param[in]   rb  Ringbuffer to operate on
+ * @param[in]   n   number of bytes written, must not exceed the size of the
+ *                  reserved region
+ */
+static inline void tsrb_commit(tsrb_t *rb, size_t n)
+{
+    assert(n <= tsrb_free(rb));
+    /* make sure the data is in the buffer before the consumer can see it */
+    __asm__ volatile ("" : : : "memory");
+    rb->writes += n;
+}
+
+/**
+ * @brief       Get a contiguous region of data available for reading
+ *
+ * The data stays in the ringbuffer until it is released with
+ * tsrb_release(). As the region ends at the end of the underlying buffer,
+ * call this function again after releasing to get the wrapped-around part.
+ *
+ * @param[in]   rb      Ringbuffer to operate on
+ * @param[out]  region  start of the data
+ * @return      number of contiguous bytes at @p region, 0 if empty
+ */
+static inline size_t tsrb_peek_region(tsrb_t *rb, char **region)
+{
+    unsigned pos = rb->reads & (rb->size - 1);
+    unsigned avail = tsrb_avail(rb);
+    unsigned contig = rb->size - pos;
+
+    *region = &rb->buf[pos];
+    return (avail < contig) ? avail : contig;
+}
+
+/**
+ * @brief       Release data read from a region returned by tsrb_peek_region()
+ * @param[in]   rb  Ringbuffer to operate on
+ * @param[in]   n   number of bytes to release, must not exceed the size of
+ *                  the peeked region
+ */
+static inline void tsrb_release(tsrb_t *rb, size_t n)
+{
+    assert(n <= tsrb_avail(rb));
+    /* make sure the data was read before the producer can overwrite it */
+    __asm__ volatile ("" : : : "memory");
+    rb->reads += n;
+}
+
 /**
  * @brief       Get a byte from ringbuffer
  * @param[in]   rb  Ringbuffer to operate on
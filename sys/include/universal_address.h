@@ -11,6 +11,17 @@
  * @ingroup     sys
  * @brief       universal address container
  *
+ * Addresses are interned: adding an address that is already stored returns
+ * the existing container and increases its use count. Stored addresses are
+ * found via a hash table, so adding and removing an address takes constant
+ * time on average regardless of the number of stored addresses.
+ *
+ * The containers are taken from a static table of
+ * `UNIVERSAL_ADDRESS_MAX_ENTRIES` entries (by default derived from the
+ * users of this module). Applications that store more addresses, e.g.
+ * routers with large FIBs, can hand in further chunks of containers with
+ * @ref universal_address_extend().
+ *
  * @{
  *
  * @file
@@ -53,13 +64,26 @@ extern "C" {
  */
 #define UNIVERSAL_ADDRESS_IS_ALL_ZERO_ADDRESS (2)
 
+/**
+ * @brief Maximum number of chunks that can be added with
+ *        @ref universal_address_extend()
+ */
+#ifndef UNIVERSAL_ADDRESS_CHUNKS_MAX
+#define UNIVERSAL_ADDRESS_CHUNKS_MAX (2)
+#endif
+
 /**
  * @brief The container descriptor used to identify a universal address entry
+ *
+ * @note  The address comes first, as the start of an unused entry is
+ *        overwritten by the allocator, see @ref sys_memarray.
  */
-typedef struct {
-    uint8_t use_count;                       /**< The number of entries link here */
-    uint8_t address_size;                    /**< Size in bytes of the used generic address */
+typedef struct universal_address_container {
     uint8_t address[UNIVERSAL_ADDRESS_SIZE]; /**< The generic address data */
+    /** Next container in the same bucket of the hash table */
+    struct universal_address_container *next;
+    uint16_t use_count;                      /**< The number of entries link here */
+    uint8_t address_size;                    /**< Size in bytes of the used generic address */
 } universal_address_container_t;
 
 /**
@@ -72,6 +96,21 @@ void universal_address_init(void);
  */
 void universal_address_reset(void);
 
+/**
+ * @brief Adds a chunk of containers to the universal address entries
+ *
+ * The chunk stays in use until the system is rebooted, so it must be
+ * statically allocated. universal_address_init() and
+ * universal_address_reset() clear the containers of all chunks.
+ *
+ * @param[in] chunk  array of containers, contents are ignored
+ * @param[in] num    number of containers in @p chunk
+ *
+ * @return 0 on success
+ * @return -ENOMEM if @ref UNIVERSAL_ADDRESS_CHUNKS_MAX chunks were already added
+ */
+int universal_address_extend(universal_address_container_t *chunk, size_t num);
+
 /**
  * @brief Add a given address to the universal address entries. If the entry already exists,
  *        the universal_address_container_t::use_count will be increased.
@@ -20,6 +20,11 @@
  * number of active timers.  The reason for this is that multiplexing is
  * realized by next-first singly linked lists.
  *
+ * Alternatively, the `xtimer_wheel` module replaces the lists with a
+ * hierarchical timing wheel, making insertion and removal O(1) at the cost of
+ * `XTIMER_WHEEL_LEVELS * 2^XTIMER_WHEEL_BITS` list heads of RAM. This pays off
+ * with many (tens to hundreds of) concurrently active timers.
+ *
  * @{
  * @file
  * @brief   xtimer interface definitions
@@ -69,8 +74,16 @@ typedef void (*xtimer_callback_t)(void*);
  */
 typedef struct xtimer {
     struct xtimer *next;         /**< reference to next timer in timer lists */
+#if defined(MODULE_XTIMER_WHEEL) || defined(DOXYGEN)
+    struct xtimer **pprev;       /**< reference to the pointer pointing to this
+                                     timer (xtimer_wheel only) */
+#endif
     uint32_t target;             /**< lower 32bit absolute target time */
     uint32_t long_target;        /**< upper 32bit absolute target time */
+#if defined(MODULE_XTIMER_SLACK) || defined(DOXYGEN)
+    uint32_t slack;              /**< ticks the timer may fire before target
+                                     (xtimer_slack only) */
+#endif
     xtimer_callback_t callback;  /**< callback function to call when timer
                                      expires */
     void *arg;                   /**< argument to pass to callback function */
@@ -291,6 +304,64 @@ static inline void xtimer_set_wakeup64(xtimer_t *timer, uint64_t offset, kernel_
  */
 static inline void xtimer_set(xtimer_t *timer, uint32_t offset);
 
+/**
+ * @brief Set a timer with a tolerance window
+ *
+ * Like xtimer_set(), but the callback may be executed anywhere between
+ * @p offset and @p offset + @p slack microseconds from now. The low-level
+ * timer is only programmed for the end of the window; if it fires earlier for
+ * another timer, this timer is executed in the same pass. This reduces the
+ * number of timer interrupts and context switches for timers that don't
+ * need to be exact.
+ *
+ * Coalescing needs the `xtimer_slack` module, which adds the tolerance to
+ * every xtimer_t. Without it, the callback is executed at the end of the
+ * window.
+ *
+ * @param[in] timer     the timer structure to use.
+ *                      Its xtimer_t::target and xtimer_t::long_target
+ *                      fields need to be initialized with 0 on first use
+ * @param[in] offset    earliest execution time in microseconds from now
+ * @param[in] slack     time in microseconds the execution may be delayed
+ */
+static inline void xtimer_set_slack(xtimer_t *timer, uint32_t offset, uint32_t slack);
+
+/**
+ * @brief Get the number of timer interrupts avoided by timer slack
+ *
+ * Counts the timers that were executed before the end of their tolerance
+ * window, because the low-level timer was triggered for another timer.
+ *
+ * @return  number of coalesced timer executions since boot, always 0 without
+ *          the `xtimer_slack` module
+ */
+uint32_t xtimer_coalesced(void);
+
+/**
+ * @brief Get the number of low-level timer interrupts handled by xtimer
+ *
+ * Includes the interrupts xtimer schedules for itself, e.g. on low-level timer
+ * overflows. Allows comparing the wake-ups caused by different backends.
+ *
+ * @return  number of low-level timer interrupts since boot
+ */
+uint32_t xtimer_wakeups(void);
+
+/**
+ * @brief Get the expiry of the next timer in the current low-level timer period
+ *
+ * Only considers timers that were set by users of xtimer, not the ticks
+ * xtimer itself schedules on low-level timer overflows. Used by the native
+ * port to skip idle time in virtual time mode.
+ *
+ * @param[out] target   low-level timer value the next timer expires at
+ *
+ * @return  0 on success
+ * @return  1 if the next timer expires in a later low-level timer period
+ * @return  -1 if no timer is set
+ */
+int xtimer_next_target(uint32_t *target);
+
 /**
  * @brief remove a timer
  *
@@ -527,6 +598,36 @@ int xtimer_mutex_lock_timeout(mutex_t *mutex, uint64_t us);
 #define XTIMER_SHIFT (0)
 #endif
 
+#ifndef XTIMER_WHEEL_SHIFT
+/**
+ * @brief   xtimer_wheel: log2 of the width of a level 0 slot, in ticks
+ *
+ * Timers expiring within the current level 0 slot are kept in a sorted list,
+ * so this should be small compared to typical timer offsets.
+ */
+#define XTIMER_WHEEL_SHIFT (8)
+#endif
+
+#ifndef XTIMER_WHEEL_BITS
+/**
+ * @brief   xtimer_wheel: log2 of the number of slots per wheel level
+ *
+ * Must not be larger than 5.
+ */
+#define XTIMER_WHEEL_BITS (5)
+#endif
+
+#ifndef XTIMER_WHEEL_LEVELS
+/**
+ * @brief   xtimer_wheel: number of wheel levels
+ *
+ * The wheel covers 2^(XTIMER_WHEEL_SHIFT + XTIMER_WHEEL_LEVELS *
+ * XTIMER_WHEEL_BITS) ticks, timers further in the future are kept in a list
+ * that is re-sorted once per wheel revolution.
+ */
+#define XTIMER_WHEEL_LEVELS (4)
+#endif
+
 /*
  * Default xtimer configuration
  */
@@ -65,6 +65,7 @@ uint64_t _xtimer_now64(void);
 int _xtimer_set_absolute(xtimer_t *timer, uint32_t target);
 void _xtimer_set64(xtimer_t *timer, uint32_t offset, uint32_t long_offset);
 void _xtimer_set(xtimer_t *timer, uint32_t offset);
+void _xtimer_set_slack64(xtimer_t *timer, uint32_t offset, uint32_t long_offset, uint32_t slack);
 void _xtimer_periodic_wakeup(uint32_t *last_wakeup, uint32_t period);
 void _xtimer_set_msg(xtimer_t *timer, uint32_t offset, msg_t *msg, kernel_pid_t target_pid);
 void _xtimer_set_msg64(xtimer_t *timer, uint64_t offset, msg_t *msg, kernel_pid_t target_pid);
@@ -72,6 +73,32 @@ void _xtimer_set_wakeup(xtimer_t *timer, uint32_t offset, kernel_pid_t pid);
 void _xtimer_set_wakeup64(xtimer_t *timer, uint64_t offset, kernel_pid_t pid);
 void _xtimer_set(xtimer_t *timer, uint32_t offset);
 int _xtimer_msg_receive_timeout(msg_t *msg, uint32_t ticks);
+
+/**
+ * @brief get the tolerance window of a timer, 0 without xtimer_slack
+ */
+static inline uint32_t _xtimer_slack(const xtimer_t *timer)
+{
+#ifdef MODULE_XTIMER_SLACK
+    return timer->slack;
+#else
+    (void)timer;
+    return 0;
+#endif
+}
+
+/**
+ * @brief set the tolerance window of a timer, ignored without xtimer_slack
+ */
+static inline void _xtimer_slack_set(xtimer_t *timer, uint32_t slack)
+{
+#ifdef MODULE_XTIMER_SLACK
+    timer->slack = slack;
+#else
+    (void)timer;
+    (void)slack;
+#endif
+}
 int _xtimer_msg_receive_timeout64(msg_t *msg, uint64_t ticks);
 
 /**
@@ -218,6 +245,12 @@ static inline void xtimer_set(xtimer_t *timer, uint32_t offset)
     _xtimer_set(timer, _xtimer_ticks_from_usec(offset));
 }
 
+static inline void xtimer_set_slack(xtimer_t *timer, uint32_t offset, uint32_t slack)
+{
+    _xtimer_set_slack64(timer, _xtimer_ticks_from_usec(offset), 0,
+                        _xtimer_ticks_from_usec(slack));
+}
+
 static inline int xtimer_msg_receive_timeout(msg_t *msg, uint32_t timeout)
 {
     return _xtimer_msg_receive_timeout(msg, _xtimer_ticks_from_usec(timeout));
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_memarray
+ * @{
+ *
+ * @file
+ * @brief       Memory pool implementation
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "irq.h"
+#include "memarray.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/* blocks need not be aligned for a pointer, so access the link via memcpy */
+static inline void *_get_next(const void *block)
+{
+    void *next;
+
+    memcpy(&next, block, sizeof(next));
+    return next;
+}
+
+static inline void _set_next(void *block, void *next)
+{
+    memcpy(block, &next, sizeof(next));
+}
+
+void memarray_init(memarray_t *mem, void *data, size_t size, size_t num)
+{
+    assert((mem != NULL) && ((data != NULL) || (num == 0)));
+    assert((num == 0) || (size >= sizeof(void *)));
+
+    unsigned state = irq_disable();
+    mem->free_list = NULL;
+    mem->data = data;
+    mem->size = size;
+    mem->num = num;
+    mem->used = 0;
+    mem->high_water = 0;
+    mem->failed = 0;
+    irq_restore(state);
+}
+
+void *memarray_alloc(memarray_t *mem)
+{
+    void *res = NULL;
+    unsigned state = irq_disable();
+
+    if (mem->free_list != NULL) {
+        res = mem->free_list;
+        mem->free_list = _get_next(res);
+    }
+    else if (mem->high_water < mem->num) {
+        /* free list is empty, so all blocks up to high_water are in use */
+        res = mem->data + (mem->high_water * mem->size);
+    }
+
+    if (res != NULL) {
+        if (++mem->used > mem->high_water) {
+            mem->high_water = mem->used;
+        }
+    }
+    else {
+        mem->failed++;
+    }
+    irq_restore(state);
+
+    DEBUG("memarray_alloc(%p): %p (%u used)\n", (void *)mem, res,
+          (unsigned)mem->used);
+    return res;
+}
+
+void memarray_free(memarray_t *mem, void *ptr)
+{
+    assert((ptr != NULL) && ((uint8_t *)ptr >= mem->data) &&
+           ((uint8_t *)ptr < (mem->data + (mem->high_water * mem->size))));
+    assert((((uint8_t *)ptr - mem->data) % mem->size) == 0);
+
+    unsigned state = irq_disable();
+    _set_next(ptr, mem->free_list);
+    mem->free_list = ptr;
+    mem->used--;
+    irq_restore(state);
+
+    DEBUG("memarray_free(%p): %p (%u used)\n", (void *)mem, ptr,
+          (unsigned)mem->used);
+}
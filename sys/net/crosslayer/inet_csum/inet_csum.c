@@ -14,12 +14,126 @@
 
 #include <inttypes.h>
 #include <stdio.h>
+#include <string.h>
+
+#include "byteorder.h"
 #include "od.h"
 #include "net/inet_csum.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+/* GCC vector extensions map to SSE2 on native */
+#if defined(CPU_NATIVE) && defined(__GNUC__)
+#define _VECTOR_SUM     (1)
+#endif
+
+/* fold a 64-bit one's complement sum to 16 bit */
+static inline uint16_t _fold(uint64_t acc)
+{
+    acc = (acc & 0xffffffff) + (acc >> 32);
+    acc = (acc & 0xffffffff) + (acc >> 32);
+    acc = (acc & 0xffff) + (acc >> 16);
+    acc = (acc & 0xffff) + (acc >> 16);
+    acc = (acc & 0xffff) + (acc >> 16);
+    return (uint16_t)acc;
+}
+
+/* aligned word loads from byte buffers */
+typedef uint16_t __attribute__((__may_alias__)) _u16_alias_t;
+typedef uint32_t __attribute__((__may_alias__)) _u32_alias_t;
+
+static inline uint16_t _swap(uint16_t word)
+{
+    return (word << 8) | (word >> 8);
+}
+
+/* word of the two bytes in memory order, as the host reads it */
+static inline uint16_t _word(uint8_t first, uint8_t second)
+{
+    uint8_t bytes[] = { first, second };
+    uint16_t word;
+
+    memcpy(&word, bytes, sizeof(word));
+    return word;
+}
+
+#ifdef _VECTOR_SUM
+typedef uint32_t _v4u32_t __attribute__((vector_size(16)));
+
+/* sums the 16-bit halves of 16 byte blocks in 32-bit lanes; a lane can take
+ * more than 2^15 blocks, far more than a uint16_t length allows */
+static uint64_t _sum_vector(const uint8_t **buf, uint16_t *len)
+{
+    _v4u32_t acc = { 0, 0, 0, 0 };
+    const _v4u32_t mask = { 0xffff, 0xffff, 0xffff, 0xffff };
+    uint64_t res = 0;
+
+    while (*len >= sizeof(_v4u32_t)) {
+        _v4u32_t v;
+
+        memcpy(&v, *buf, sizeof(v));
+        acc += v & mask;
+        acc += v >> 16;
+        *buf += sizeof(v);
+        *len -= sizeof(v);
+    }
+    for (unsigned i = 0; i < (sizeof(acc) / sizeof(acc[0])); i++) {
+        res += acc[i];
+    }
+    return res;
+}
+#endif
+
+/* one's complement sum of the host order 16-bit words of buf, where buf[0]
+ * is the first byte of a word */
+static uint16_t _sum(const uint8_t *buf, uint16_t len)
+{
+    uint64_t acc = 0;
+    int odd = ((uintptr_t)buf & 1);
+
+    if (odd) {
+        /* pair bytes as if buf started one byte earlier, so all loads below
+         * are aligned, and swap the result back */
+        acc = _word(0, *buf);
+        buf++;
+        len--;
+    }
+    if (((uintptr_t)buf & 2) && (len >= 2)) {
+        acc += *((const _u16_alias_t *)buf);
+        buf += 2;
+        len -= 2;
+    }
+#ifdef _VECTOR_SUM
+    acc += _sum_vector(&buf, &len);
+#endif
+    while (len >= 16) {
+        const _u32_alias_t *words = (const _u32_alias_t *)buf;
+
+        acc += words[0];
+        acc += words[1];
+        acc += words[2];
+        acc += words[3];
+        buf += 16;
+        len -= 16;
+    }
+    while (len >= 4) {
+        acc += *((const _u32_alias_t *)buf);
+        buf += 4;
+        len -= 4;
+    }
+    if (len >= 2) {
+        acc += *((const _u16_alias_t *)buf);
+        buf += 2;
+        len -= 2;
+    }
+    if (len) {
+        acc += _word(*buf, 0);
+    }
+
+    return (odd) ? _swap(_fold(acc)) : _fold(acc);
+}
+
 uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t accum_len)
 {
     uint32_t csum = sum;
@@ -41,17 +155,15 @@ uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t
         csum += *buf;         /* add first byte as bottom half of 16-byte word */
         buf++;
         len--;
-        accum_len++;
     }
 
-    for (int i = 0; i < (len >> 1); buf += 2, i++) {
-        csum += (uint16_t)(*buf << 8) + *(buf + 1); /* group bytes by 16-byte words */
-                                                    /* and add them */
+    if (len > 0) {
+        /* the one's complement sum is byte order independent (RFC 1071,
+         * section 2(B)), so summing host order words only needs the result
+         * converted */
+        csum += ntohs(_sum(buf, len));
     }
 
-    if ((accum_len + len) & 1)          /* if accumulated length is odd */
-        csum += (uint16_t)(*buf << 8);  /* add last byte as top half of 16-byte word */
-
     while (csum >> 16) {
         uint16_t carry = csum >> 16;
         csum = (csum & 0xffff) + carry;
@@ -62,4 +174,18 @@ uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t
     return csum;
 }
 
+uint16_t inet_csum_update(uint16_t csum, const uint8_t *old_val,
+                          const uint8_t *new_val, uint16_t len)
+{
+    /* RFC 1624, eqn. 3: HC' = ~(~HC + ~m + m') */
+    uint32_t sum = (uint16_t)~csum;
+
+    sum += (uint16_t)~inet_csum(0, old_val, len);
+    sum += inet_csum(0, new_val, len);
+    while (sum >> 16) {
+        sum = (sum & 0xffff) + (sum >> 16);
+    }
+    return (uint16_t)~sum;
+}
+
 /** @} */
@@ -34,10 +34,13 @@ static gnrc_pktsnip_t *_recv(gnrc_netdev_t *gnrc_netdev)
     netdev_t *dev = gnrc_netdev->dev;
     int bytes_expected = dev->driver->recv(dev, NULL, 0, NULL);
     gnrc_pktsnip_t *pkt = NULL;
+    /* receive frame behind some headroom, so the Ethernet header can be
+     * marked without moving the payload */
+    const size_t headroom = gnrc_pktbuf_headroom(sizeof(ethernet_hdr_t));
 
     if (bytes_expected > 0) {
         pkt = gnrc_pktbuf_add(NULL, NULL,
-                bytes_expected,
+                bytes_expected + headroom,
                 GNRC_NETTYPE_UNDEF);
 
         if(!pkt) {
@@ -49,7 +52,8 @@ static gnrc_pktsnip_t *_recv(gnrc_netdev_t *gnrc_netdev)
             goto out;
         }
 
-        int nread = dev->driver->recv(dev, pkt->data, bytes_expected, NULL);
+        int nread = dev->driver->recv(dev, ((uint8_t *)pkt->data) + headroom,
+                                      bytes_expected, NULL);
         if(nread <= 0) {
             DEBUG("_recv_ethernet_packet: read error.\n");
             goto safe_out;
@@ -60,17 +64,18 @@ static gnrc_pktsnip_t *_recv(gnrc_netdev_t *gnrc_netdev)
              * so free the unused space.*/
 
             DEBUG("_recv_ethernet_packet: reallocating.\n");
-            gnrc_pktbuf_realloc_data(pkt, nread);
+            gnrc_pktbuf_realloc_data(pkt, nread + headroom);
         }
 
-        /* mark ethernet header */
-        gnrc_pktsnip_t *eth_hdr = gnrc_pktbuf_mark(pkt, sizeof(ethernet_hdr_t), GNRC_NETTYPE_UNDEF);
+        /* mark ethernet header (along with the headroom) */
+        gnrc_pktsnip_t *eth_hdr = gnrc_pktbuf_mark(pkt, headroom + sizeof(ethernet_hdr_t),
+                                                   GNRC_NETTYPE_UNDEF);
         if (!eth_hdr) {
             DEBUG("gnrc_netdev_eth: no space left in packet buffer\n");
             goto safe_out;
         }
 
-        ethernet_hdr_t *hdr = (ethernet_hdr_t *)eth_hdr->data;
+        ethernet_hdr_t *hdr = (ethernet_hdr_t *)(((uint8_t *)eth_hdr->data) + headroom);
 
 #ifdef MODULE_L2FILTER
         if (!l2filter_pass(dev->filter, hdr->src, ETHERNET_ADDR_LEN)) {
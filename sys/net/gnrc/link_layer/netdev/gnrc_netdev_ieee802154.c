@@ -34,6 +34,7 @@ int gnrc_netdev_ieee802154_init(gnrc_netdev_t *gnrc_netdev,
     gnrc_netdev->send = _send;
     gnrc_netdev->recv = _recv;
     gnrc_netdev->dev = (netdev_t *)dev;
+    gnrc_netdev->rx_headroom = 0;
 
     return 0;
 }
@@ -75,13 +76,19 @@ static gnrc_pktsnip_t *_recv(gnrc_netdev_t *gnrc_netdev)
 
     if (bytes_expected > 0) {
         int nread;
+        /* the MAC header is only known after reception, so guess the headroom
+         * needed to mark it in place from the previous frame */
+        size_t headroom = (state->flags & NETDEV_IEEE802154_RAW) ?
+                          0 : gnrc_netdev->rx_headroom;
 
-        pkt = gnrc_pktbuf_add(NULL, NULL, bytes_expected, GNRC_NETTYPE_UNDEF);
+        pkt = gnrc_pktbuf_add(NULL, NULL, bytes_expected + headroom,
+                              GNRC_NETTYPE_UNDEF);
         if (pkt == NULL) {
             DEBUG("_recv_ieee802154: cannot allocate pktsnip.\n");
             return NULL;
         }
-        nread = netdev->driver->recv(netdev, pkt->data, bytes_expected, &rx_info);
+        nread = netdev->driver->recv(netdev, ((uint8_t *)pkt->data) + headroom,
+                                     bytes_expected, &rx_info);
         if (nread <= 0) {
             gnrc_pktbuf_release(pkt);
             return NULL;
@@ -92,7 +99,8 @@ static gnrc_pktsnip_t *_recv(gnrc_netdev_t *gnrc_netdev)
 #if ENABLE_DEBUG
             char src_str[GNRC_NETIF_HDR_L2ADDR_PRINT_LEN];
 #endif
-            size_t mhr_len = ieee802154_get_frame_hdr_len(pkt->data);
+            size_t mhr_len = ieee802154_get_frame_hdr_len(((uint8_t *)pkt->data) +
+                                                          headroom);
 
             if (mhr_len == 0) {
                 DEBUG("_recv_ieee802154: illegally formatted frame received\n");
@@ -100,14 +108,18 @@ static gnrc_pktsnip_t *_recv(gnrc_netdev_t *gnrc_netdev)
                 return NULL;
             }
             nread -= mhr_len;
-            /* mark IEEE 802.15.4 header */
-            ieee802154_hdr = gnrc_pktbuf_mark(pkt, mhr_len, GNRC_NETTYPE_UNDEF);
+            gnrc_netdev->rx_headroom = gnrc_pktbuf_headroom(mhr_len);
+            /* mark IEEE 802.15.4 header (along with the headroom); this only
+             * moves the frame if the guessed headroom was wrong */
+            ieee802154_hdr = gnrc_pktbuf_mark(pkt, headroom + mhr_len,
+                                              GNRC_NETTYPE_UNDEF);
             if (ieee802154_hdr == NULL) {
                 DEBUG("_recv_ieee802154: no space left in packet buffer\n");
                 gnrc_pktbuf_release(pkt);
                 return NULL;
             }
-            netif_hdr = _make_netif_hdr(ieee802154_hdr->data);
+            netif_hdr = _make_netif_hdr(((uint8_t *)ieee802154_hdr->data) +
+                                        headroom);
             if (netif_hdr == NULL) {
                 DEBUG("_recv_ieee802154: no space left in packet buffer\n");
                 gnrc_pktbuf_release(pkt);
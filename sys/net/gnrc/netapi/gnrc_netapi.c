@@ -18,8 +18,10 @@
  * @}
  */
 
+#include "irq.h"
 #include "mbox.h"
 #include "msg.h"
+#include "thread.h"
 #include "net/gnrc/netreg.h"
 #include "net/gnrc/pktbuf.h"
 #include "net/gnrc/netapi.h"
@@ -91,6 +93,67 @@ static inline int _snd_rcv_mbox(mbox_t *mbox, uint16_t type, gnrc_pktsnip_t *pkt
 }
 #endif
 
+#ifdef MODULE_GNRC_NETAPI_INLINE
+/**
+ * @brief   A callback waiting to be run by the stack thread
+ */
+typedef struct {
+    gnrc_netreg_entry_cbd_t *cbd;   /**< the callback, NULL if slot is free */
+    gnrc_pktsnip_t *pkt;            /**< the packet to hand to the callback */
+    uint16_t cmd;                   /**< the command to hand to the callback */
+} _inline_call_t;
+
+kernel_pid_t gnrc_netapi_inline_pid = KERNEL_PID_UNDEF;
+
+static _inline_call_t _inline_calls[GNRC_NETAPI_INLINE_QUEUE_SIZE];
+
+static int _snd_rcv_inline(gnrc_netreg_entry_cbd_t *cbd, uint16_t cmd,
+                           gnrc_pktsnip_t *pkt)
+{
+    msg_t msg;
+    unsigned i, state = irq_disable();
+
+    for (i = 0; i < GNRC_NETAPI_INLINE_QUEUE_SIZE; i++) {
+        if (_inline_calls[i].cbd == NULL) {
+            _inline_calls[i].cbd = cbd;
+            _inline_calls[i].pkt = pkt;
+            _inline_calls[i].cmd = cmd;
+            break;
+        }
+    }
+    irq_restore(state);
+    if (i == GNRC_NETAPI_INLINE_QUEUE_SIZE) {
+        DEBUG("gnrc_netapi: dropped inline call (no free slot)\n");
+        return 0;
+    }
+    /* set the outgoing message's fields */
+    msg.type = GNRC_NETAPI_MSG_TYPE_INLINE;
+    msg.content.value = i;
+    /* send message */
+    int ret = msg_try_send(&msg, gnrc_netapi_inline_pid);
+    if (ret < 1) {
+        DEBUG("gnrc_netapi: dropped inline call to %" PRIkernel_pid "\n",
+              gnrc_netapi_inline_pid);
+        _inline_calls[i].cbd = NULL;
+    }
+    return ret;
+}
+
+void gnrc_netapi_inline_handle(msg_t *msg)
+{
+    _inline_call_t *call = &_inline_calls[msg->content.value];
+    gnrc_netreg_entry_cbd_t *cbd = call->cbd;
+    gnrc_pktsnip_t *pkt = call->pkt;
+    uint16_t cmd = call->cmd;
+
+    assert(thread_getpid() == gnrc_netapi_inline_pid);
+    assert(cbd != NULL);
+    /* free slot before calling, the callback may dispatch further */
+    call->cbd = NULL;
+    cbd->cb(cmd, pkt, cbd->ctx);
+}
+#endif
+
 int gnrc_netapi_dispatch(gnrc_nettype_t type, uint32_t demux_ctx,
                          uint16_t cmd, gnrc_pktsnip_t *pkt)
 {
@@ -121,6 +184,18 @@ int gnrc_netapi_dispatch(gnrc_nettype_t type, uint32_t demux_ctx,
 #endif
 #ifdef MODULE_GNRC_NETAPI_CALLBACKS
                 case GNRC_NETREG_TYPE_CB:
+#ifdef MODULE_GNRC_NETAPI_INLINE
+                    if ((gnrc_netapi_inline_pid != KERNEL_PID_UNDEF) &&
+                        (thread_getpid() != gnrc_netapi_inline_pid)) {
+                        /* enter the stack thread; from there on the packet
+                         * is handed on by direct calls */
+                        if (_snd_rcv_inline(sendto->target.cbd, cmd, pkt) < 1) {
+                            /* unable to dispatch packet */
+                            release = 1;
+                        }
+                        break;
+                    }
+#endif
                     sendto->target.cbd->cb(cmd, pkt, sendto->target.cbd->ctx);
                     break;
 #endif
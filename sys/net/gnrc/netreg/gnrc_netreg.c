@@ -13,6 +13,7 @@
  */
 
 #include <errno.h>
+#include <stdbool.h>
 #include <string.h>
 
 #include "assert.h"
@@ -27,13 +28,42 @@
 
 #define _INVALID_TYPE(type) (((type) < GNRC_NETTYPE_UNDEF) || ((type) >= GNRC_NETTYPE_NUMOF))
 
-/* The registry as lookup table by gnrc_nettype_t */
-static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF];
+#if (GNRC_NETREG_BUCKETS & (GNRC_NETREG_BUCKETS - 1))
+#error "GNRC_NETREG_BUCKETS must be a power of two"
+#endif
+
+/* The registry as hash table by (gnrc_nettype_t, demux context). Entries with
+ * the same key always end up in the same bucket */
+static gnrc_netreg_entry_t *netreg[GNRC_NETREG_BUCKETS];
+
+static inline unsigned _bucket(gnrc_nettype_t type, uint32_t demux_ctx)
+{
+    /* fold upper half down, so GNRC_NETREG_DEMUX_CTX_ALL and ports mix
+     * well, then multiplicative (Fibonacci) hashing */
+    uint32_t key = demux_ctx ^ (demux_ctx >> 16) ^ ((uint32_t)type << 8);
+
+    return ((key * 2654435761U) >> 16) & (GNRC_NETREG_BUCKETS - 1);
+}
+
+static inline bool _match(const gnrc_netreg_entry_t *entry,
+                          gnrc_nettype_t type, uint32_t demux_ctx)
+{
+    return (entry->demux_ctx == demux_ctx) && (entry->nettype == type);
+}
+
+static gnrc_netreg_entry_t *_search(gnrc_netreg_entry_t *entry,
+                                    gnrc_nettype_t type, uint32_t demux_ctx)
+{
+    while ((entry != NULL) && !_match(entry, type, demux_ctx)) {
+        entry = entry->next;
+    }
+    return entry;
+}
 
 void gnrc_netreg_init(void)
 {
     /* set all pointers in registry to NULL */
-    memset(netreg, 0, GNRC_NETTYPE_NUMOF * sizeof(gnrc_netreg_entry_t *));
+    memset(netreg, 0, sizeof(netreg));
 }
 
 int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
@@ -53,7 +83,8 @@ int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return -EINVAL;
     }
 
-    LL_PREPEND(netreg[type], entry);
+    entry->nettype = type;
+    LL_PREPEND(netreg[_bucket(type, entry->demux_ctx)], entry);
 
     return 0;
 }
@@ -64,20 +95,16 @@ void gnrc_netreg_unregister(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return;
     }
 
-    LL_DELETE(netreg[type], entry);
+    LL_DELETE(netreg[_bucket(type, entry->demux_ctx)], entry);
 }
 
 gnrc_netreg_entry_t *gnrc_netreg_lookup(gnrc_nettype_t type, uint32_t demux_ctx)
 {
-    gnrc_netreg_entry_t *res;
-
     if (_INVALID_TYPE(type)) {
         return NULL;
     }
 
-    LL_SEARCH_SCALAR(netreg[type], res, demux_ctx, demux_ctx);
-
-    return res;
+    return _search(netreg[_bucket(type, demux_ctx)], type, demux_ctx);
 }
 
 int gnrc_netreg_num(gnrc_nettype_t type, uint32_t demux_ctx)
@@ -89,10 +116,10 @@ int gnrc_netreg_num(gnrc_nettype_t type, uint32_t demux_ctx)
         return 0;
     }
 
-    entry = netreg[type];
+    entry = netreg[_bucket(type, demux_ctx)];
 
     while (entry != NULL) {
-        if (entry->demux_ctx == demux_ctx) {
+        if (_match(entry, type, demux_ctx)) {
             num++;
         }
 
@@ -104,17 +131,11 @@ int gnrc_netreg_num(gnrc_nettype_t type, uint32_t demux_ctx)
 
 gnrc_netreg_entry_t *gnrc_netreg_getnext(gnrc_netreg_entry_t *entry)
 {
-    uint32_t demux_ctx;
-
     if (entry == NULL) {
         return NULL;
     }
 
-    demux_ctx = entry->demux_ctx;
-
-    LL_SEARCH_SCALAR(entry->next, entry, demux_ctx, demux_ctx);
-
-    return entry;
+    return _search(entry->next, entry->nettype, entry->demux_ctx);
 }
 
 int gnrc_netreg_calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr)
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  net_gnrc_ipv6_flowc
+ * @internal
+ * @{
+ *
+ * @file
+ * @brief       Internal definitions
+ */
+#ifndef PRIV_FLOWC_INTERNAL_H
+#define PRIV_FLOWC_INTERNAL_H
+
+#include <stdint.h>
+
+#include "kernel_types.h"
+#include "mutex.h"
+#include "net/gnrc/ipv6/nc.h"
+#include "net/ipv6/addr.h"
+
+#include "net/gnrc/ipv6/flowc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Flow cache entry
+ */
+typedef struct {
+    ipv6_addr_t dst;                            /**< destination address */
+    ipv6_addr_t src;                            /**< source address for dst */
+    uint32_t expires;                           /**< expiry time in us */
+    kernel_pid_t req_iface;                     /**< interface requested by
+                                                 *   the sender */
+    kernel_pid_t iface;                         /**< outgoing interface,
+                                                 *   KERNEL_PID_UNDEF if
+                                                 *   entry is unused */
+    uint8_t l2addr[GNRC_IPV6_NC_L2_ADDR_MAX];   /**< link-layer address of
+                                                 *   the next hop */
+    uint8_t l2addr_len;                         /**< length of l2addr */
+} _flowc_entry_t;
+
+extern _flowc_entry_t _flowc[GNRC_IPV6_FLOWC_SIZE];     /**< the flow cache */
+extern gnrc_ipv6_flowc_stats_t _flowc_stats;            /**< statistics */
+extern mutex_t _flowc_mutex;                            /**< protects the
+                                                         *   flow cache */
+extern unsigned _flowc_gen;                             /**< generation of
+                                                         *   the flow cache */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PRIV_FLOWC_INTERNAL_H */
+/** @} */
@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <string.h>
+
+#include "mutex.h"
+#include "net/gnrc/ipv6/nc.h"
+#include "net/gnrc/ipv6/netif.h"
+#include "xtimer.h"
+
+#include "net/gnrc/ipv6/flowc.h"
+
+#include "_flowc-internal.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#if (GNRC_IPV6_FLOWC_SIZE & (GNRC_IPV6_FLOWC_SIZE - 1))
+#error "GNRC_IPV6_FLOWC_SIZE must be a power of two"
+#endif
+
+#if ENABLE_DEBUG
+static char addr_str[IPV6_ADDR_MAX_STR_LEN];
+#endif
+
+_flowc_entry_t _flowc[GNRC_IPV6_FLOWC_SIZE];
+gnrc_ipv6_flowc_stats_t _flowc_stats;
+mutex_t _flowc_mutex = MUTEX_INIT;
+unsigned _flowc_gen;
+
+static inline _flowc_entry_t *_slot(kernel_pid_t iface, const ipv6_addr_t *dst)
+{
+    /* the interface identifier is the most diverse part of the address for
+     * the handful of destinations a router usually forwards to */
+    uint32_t key = dst->u32[3].u32 ^ dst->u32[2].u32 ^ (uint32_t)iface;
+
+    return &_flowc[((key * 2654435761U) >> 16) & (GNRC_IPV6_FLOWC_SIZE - 1)];
+}
+
+kernel_pid_t gnrc_ipv6_flowc_get(kernel_pid_t iface, const ipv6_addr_t *dst,
+                                 uint8_t *l2addr, uint8_t *l2addr_len,
+                                 ipv6_addr_t *src)
+{
+    _flowc_entry_t *entry = _slot(iface, dst);
+    kernel_pid_t res = KERNEL_PID_UNDEF;
+
+    mutex_lock(&_flowc_mutex);
+    if ((entry->iface != KERNEL_PID_UNDEF) && (entry->req_iface == iface) &&
+        ipv6_addr_equal(&entry->dst, dst)) {
+        if ((int32_t)(entry->expires - xtimer_now_usec()) > 0) {
+            res = entry->iface;
+            *l2addr_len = entry->l2addr_len;
+            memcpy(l2addr, entry->l2addr, entry->l2addr_len);
+            if ((src != NULL) && !ipv6_addr_is_unspecified(&entry->src)) {
+                memcpy(src, &entry->src, sizeof(ipv6_addr_t));
+            }
+        }
+        else {
+            DEBUG("ipv6 flowc: entry for %s expired\n",
+                  ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)));
+            entry->iface = KERNEL_PID_UNDEF;
+        }
+    }
+    if (res == KERNEL_PID_UNDEF) {
+        _flowc_stats.misses++;
+    }
+    else {
+        _flowc_stats.hits++;
+    }
+    mutex_unlock(&_flowc_mutex);
+    return res;
+}
+
+unsigned gnrc_ipv6_flowc_gen(void)
+{
+    unsigned gen;
+
+    mutex_lock(&_flowc_mutex);
+    gen = _flowc_gen;
+    mutex_unlock(&_flowc_mutex);
+    return gen;
+}
+
+void gnrc_ipv6_flowc_add(unsigned gen, kernel_pid_t req_iface,
+                         const ipv6_addr_t *dst, kernel_pid_t iface,
+                         const uint8_t *l2addr, uint8_t l2addr_len)
+{
+    _flowc_entry_t *entry = _slot(req_iface, dst);
+    ipv6_addr_t *src;
+
+    if ((iface == KERNEL_PID_UNDEF) || (l2addr_len > sizeof(entry->l2addr))) {
+        return;
+    }
+    src = gnrc_ipv6_netif_find_best_src_addr(iface, dst, false);
+    mutex_lock(&_flowc_mutex);
+    if (gen != _flowc_gen) {
+        /* the next hop was determined from state that is gone by now */
+        mutex_unlock(&_flowc_mutex);
+        DEBUG("ipv6 flowc: cache invalidated during next hop determination\n");
+        return;
+    }
+    memcpy(&entry->dst, dst, sizeof(ipv6_addr_t));
+    if (src != NULL) {
+        memcpy(&entry->src, src, sizeof(ipv6_addr_t));
+    }
+    else {
+        ipv6_addr_set_unspecified(&entry->src);
+    }
+    memcpy(entry->l2addr, l2addr, l2addr_len);
+    entry->l2addr_len = l2addr_len;
+    entry->expires = xtimer_now_usec() + GNRC_IPV6_FLOWC_LIFETIME;
+    entry->req_iface = req_iface;
+    entry->iface = iface;
+    mutex_unlock(&_flowc_mutex);
+    DEBUG("ipv6 flowc: added %s over interface %" PRIkernel_pid "\n",
+          ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)), iface);
+}
+
+void gnrc_ipv6_flowc_invalidate(void)
+{
+    mutex_lock(&_flowc_mutex);
+    for (unsigned i = 0; i < GNRC_IPV6_FLOWC_SIZE; i++) {
+        _flowc[i].iface = KERNEL_PID_UNDEF;
+    }
+    _flowc_gen++;
+    _flowc_stats.invalidations++;
+    mutex_unlock(&_flowc_mutex);
+}
+
+const gnrc_ipv6_flowc_stats_t *gnrc_ipv6_flowc_get_stats(void)
+{
+    return &_flowc_stats;
+}
+
+/** @} */
@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "net/gnrc/netif.h"
+#include "net/ipv6/addr.h"
+#include "xtimer.h"
+
+#include "net/gnrc/ipv6/flowc.h"
+
+#include "_flowc-internal.h"
+
+void gnrc_ipv6_flowc_print(void)
+{
+    char addr_str[IPV6_ADDR_MAX_STR_LEN];
+    uint32_t now = xtimer_now_usec();
+
+    mutex_lock(&_flowc_mutex);
+    printf("hits: %" PRIu32 ", misses: %" PRIu32 ", invalidations: %" PRIu32 "\n",
+           _flowc_stats.hits, _flowc_stats.misses, _flowc_stats.invalidations);
+    for (unsigned i = 0; i < GNRC_IPV6_FLOWC_SIZE; i++) {
+        _flowc_entry_t *entry = &_flowc[i];
+
+        if ((entry->iface == KERNEL_PID_UNDEF) ||
+            ((int32_t)(entry->expires - now) <= 0)) {
+            continue;
+        }
+        printf("%s dev #%" PRIkernel_pid " ",
+               ipv6_addr_to_str(addr_str, &entry->dst, sizeof(addr_str)),
+               entry->iface);
+        printf("lladdr %s ",
+               gnrc_netif_addr_to_str(addr_str, sizeof(addr_str),
+                                      entry->l2addr, entry->l2addr_len));
+        printf("src %s\n",
+               ipv6_addr_to_str(addr_str, &entry->src, sizeof(addr_str)));
+    }
+    mutex_unlock(&_flowc_mutex);
+}
+
+/** @} */
@@ -33,9 +33,14 @@
 #include "net/gnrc/ipv6/netif.h"
 #include "net/gnrc/ipv6/whitelist.h"
 #include "net/gnrc/ipv6/blacklist.h"
+#include "net/gnrc/ipv6/flowc.h"
 
 #include "net/gnrc/ipv6.h"
 
+#if defined(MODULE_GNRC_NETAPI_INLINE) && defined(MODULE_GNRC_SIXLOWPAN_FRAG)
+#include "net/gnrc/sixlowpan/frag.h"
+#endif
+
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
@@ -79,12 +84,23 @@ static void *_event_loop(void *args);
 /* Handles encapsulated IPv6 packets: http://tools.ietf.org/html/rfc2473 */
 static void _decapsulate(gnrc_pktsnip_t *pkt);
 
+#ifdef MODULE_GNRC_NETAPI_INLINE
+/* handles netapi commands in run-to-completion mode */
+static void _netapi_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx);
+
+static gnrc_netreg_entry_cbd_t _netapi_cbd = { _netapi_cb, NULL };
+#endif
+
 kernel_pid_t gnrc_ipv6_init(void)
 {
     if (gnrc_ipv6_pid == KERNEL_PID_UNDEF) {
         gnrc_ipv6_pid = thread_create(_stack, sizeof(_stack), GNRC_IPV6_PRIO,
                                       THREAD_CREATE_STACKTEST,
                                       _event_loop, NULL, "ipv6");
+#ifdef MODULE_GNRC_NETAPI_INLINE
+        /* the IPv6 thread runs the whole stack */
+        gnrc_netapi_inline_pid = gnrc_ipv6_pid;
+#endif
     }
 
 #ifdef MODULE_FIB
@@ -248,11 +264,29 @@ static void _dispatch_next_header(gnrc_pktsnip_t *current, gnrc_pktsnip_t *pkt,
     }
 }
 
+#ifdef MODULE_GNRC_NETAPI_INLINE
+static void _netapi_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    (void)ctx;
+    if (cmd == GNRC_NETAPI_MSG_TYPE_RCV) {
+        _receive(pkt);
+    }
+    else {
+        _send(pkt, true);
+    }
+}
+#endif
+
 static void *_event_loop(void *args)
 {
     msg_t msg, reply, msg_q[GNRC_IPV6_MSG_QUEUE_SIZE];
+#ifdef MODULE_GNRC_NETAPI_INLINE
+    gnrc_netreg_entry_t me_reg = GNRC_NETREG_ENTRY_INIT_CB(GNRC_NETREG_DEMUX_CTX_ALL,
+                                                           &_netapi_cbd);
+#else
     gnrc_netreg_entry_t me_reg = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
                                                             sched_active_pid);
+#endif
 
     (void)args;
     msg_init_queue(msg_q, GNRC_IPV6_MSG_QUEUE_SIZE);
@@ -286,10 +320,28 @@ static void *_event_loop(void *args)
                 msg_reply(&msg, &reply);
                 break;
 
+#ifdef MODULE_GNRC_NETAPI_INLINE
+            case GNRC_NETAPI_MSG_TYPE_INLINE:
+                DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_INLINE received\n");
+                gnrc_netapi_inline_handle(&msg);
+                break;
+#   ifdef MODULE_GNRC_SIXLOWPAN_FRAG
+            case GNRC_SIXLOWPAN_MSG_FRAG_SND:
+                DEBUG("ipv6: 6LoWPAN send fragmented event received\n");
+                gnrc_sixlowpan_frag_send(msg.content.ptr);
+                break;
+
+            case GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF:
+                DEBUG("ipv6: 6LoWPAN garbage collection event received\n");
+                gnrc_sixlowpan_frag_gc_rbuf();
+                break;
+#   endif
+#endif
 #ifdef MODULE_GNRC_NDP
             case GNRC_NDP_MSG_RTR_TIMEOUT:
                 DEBUG("ipv6: Router timeout received\n");
                 ((gnrc_ipv6_nc_t *)msg.content.ptr)->flags &= ~GNRC_IPV6_NC_IS_ROUTER;
+                gnrc_ipv6_flowc_invalidate();
                 break;
 
             /* XXX reactivate when https://github.com/RIOT-OS/RIOT/issues/5122 is
@@ -747,7 +799,28 @@ static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
         uint8_t l2addr_len = GNRC_IPV6_NC_L2_ADDR_MAX;
         uint8_t l2addr[l2addr_len];
 
+#ifdef MODULE_GNRC_IPV6_FLOWC
+        kernel_pid_t req_iface = iface;
+        /* only fill in the source address if the header is prepared by us */
+        ipv6_addr_t *src = (prep_hdr) ? &hdr->src : NULL;
+        /* taken before resolving so a concurrent invalidation is noticed */
+        unsigned gen = gnrc_ipv6_flowc_gen();
+
+        if ((src != NULL) && !ipv6_addr_is_unspecified(src)) {
+            src = NULL;
+        }
+        iface = gnrc_ipv6_flowc_get(req_iface, &hdr->dst, l2addr, &l2addr_len,
+                                    src);
+        if (iface == KERNEL_PID_UNDEF) {
+            l2addr_len = GNRC_IPV6_NC_L2_ADDR_MAX;
+            iface = _next_hop_l2addr(l2addr, &l2addr_len, req_iface, &hdr->dst,
+                                     pkt);
+            gnrc_ipv6_flowc_add(gen, req_iface, &hdr->dst, iface, l2addr,
+                                l2addr_len);
+        }
+#else
         iface = _next_hop_l2addr(l2addr, &l2addr_len, iface, &hdr->dst, pkt);
+#endif
 
         if (iface == KERNEL_PID_UNDEF) {
             DEBUG("ipv6: error determining next hop's link layer address\n");
@@ -35,8 +35,85 @@
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 #endif
 
+#if (GNRC_IPV6_NC_HASH_SIZE & (GNRC_IPV6_NC_HASH_SIZE - 1))
+#error "GNRC_IPV6_NC_HASH_SIZE must be a power of two"
+#endif
+
 static gnrc_ipv6_nc_t ncache[GNRC_IPV6_NC_SIZE];
 
+/* entries are linked by index + 1, so a zeroed cache is empty */
+static uint16_t _buckets[GNRC_IPV6_NC_HASH_SIZE];
+static uint16_t _free;          /* removed entries */
+static uint16_t _high_water;    /* entries from here on were never used */
+static uint16_t _lru_head;      /* most recently used entry */
+static uint16_t _lru_tail;      /* least recently used entry */
+static gnrc_ipv6_nc_stats_t _stats;
+
+static inline uint16_t _idx(const gnrc_ipv6_nc_t *entry)
+{
+    return (uint16_t)(entry - ncache) + 1;
+}
+
+static inline gnrc_ipv6_nc_t *_entry(uint16_t idx)
+{
+    return (idx == 0) ? NULL : &ncache[idx - 1];
+}
+
+static inline uint16_t *_bucket(const ipv6_addr_t *ipv6_addr)
+{
+    /* the interface identifier differs most between neighbors */
+    uint32_t key = ipv6_addr->u32[2].u32 ^ ipv6_addr->u32[3].u32;
+
+    return &_buckets[((key * 2654435761U) >> 16) & (GNRC_IPV6_NC_HASH_SIZE - 1)];
+}
+
+static void _lru_remove(gnrc_ipv6_nc_t *entry)
+{
+    if (entry->lru_prev != 0) {
+        _entry(entry->lru_prev)->lru_next = entry->lru_next;
+    }
+    else {
+        _lru_head = entry->lru_next;
+    }
+    if (entry->lru_next != 0) {
+        _entry(entry->lru_next)->lru_prev = entry->lru_prev;
+    }
+    else {
+        _lru_tail = entry->lru_prev;
+    }
+}
+
+static void _lru_push(gnrc_ipv6_nc_t *entry)
+{
+    entry->lru_prev = 0;
+    entry->lru_next = _lru_head;
+    if (_lru_head != 0) {
+        _entry(_lru_head)->lru_prev = _idx(entry);
+    }
+    else {
+        _lru_tail = _idx(entry);
+    }
+    _lru_head = _idx(entry);
+}
+
+static void _lru_touch(gnrc_ipv6_nc_t *entry)
+{
+    if (_lru_head != _idx(entry)) {
+        _lru_remove(entry);
+        _lru_push(entry);
+    }
+}
+
+/* stale neighbors can be re-resolved at any time, unless they are routers
+ * or registered via 6LoWPAN-ND */
+static inline bool _is_evictable(const gnrc_ipv6_nc_t *entry)
+{
+    return (gnrc_ipv6_nc_get_state(entry) == GNRC_IPV6_NC_STATE_STALE) &&
+           !(entry->flags & GNRC_IPV6_NC_IS_ROUTER) &&
+           ((gnrc_ipv6_nc_get_type(entry) == GNRC_IPV6_NC_TYPE_NONE) ||
+            (gnrc_ipv6_nc_get_type(entry) == GNRC_IPV6_NC_TYPE_GC));
+}
+
 static void _nc_remove(kernel_pid_t iface, gnrc_ipv6_nc_t *entry)
 {
     (void) iface;
@@ -73,9 +150,22 @@ static void _nc_remove(kernel_pid_t iface, gnrc_ipv6_nc_t *entry)
     xtimer_remove(&entry->nbr_sol_timer);
     xtimer_remove(&entry->nbr_adv_timer);
 
+    if (!ipv6_addr_is_unspecified(&(entry->ipv6_addr))) {
+        uint16_t *prev = _bucket(&(entry->ipv6_addr));
+
+        while (*prev != _idx(entry)) {
+            prev = &(_entry(*prev)->hash_next);
+        }
+        *prev = entry->hash_next;
+        _lru_remove(entry);
+        entry->hash_next = _free;
+        _free = _idx(entry);
+    }
+
     ipv6_addr_set_unspecified(&(entry->ipv6_addr));
     entry->iface = KERNEL_PID_UNDEF;
     entry->flags = 0;
+    gnrc_ipv6_flowc_invalidate();
 }
 
 void gnrc_ipv6_nc_init(void)
@@ -86,13 +176,49 @@ void gnrc_ipv6_nc_init(void)
         _nc_remove(entry->iface, entry);
     }
     memset(ncache, 0, sizeof(ncache));
+    memset(_buckets, 0, sizeof(_buckets));
+    _free = 0;
+    _high_water = 0;
+    _lru_head = 0;
+    _lru_tail = 0;
+    memset(&_stats, 0, sizeof(_stats));
 }
 
 gnrc_ipv6_nc_t *_find_free_entry(void)
 {
-    for (int i = 0; i < GNRC_IPV6_NC_SIZE; i++) {
-        if (ipv6_addr_is_unspecified(&(ncache[i].ipv6_addr))) {
-            return ncache + i;
+    gnrc_ipv6_nc_t *entry;
+
+    if (_free == 0) {
+        if (_high_water < GNRC_IPV6_NC_SIZE) {
+            return &ncache[_high_water++];
+        }
+        /* replace the least recently used stale entry */
+        for (entry = _entry(_lru_tail); entry != NULL; entry = _entry(entry->lru_prev)) {
+            if (_is_evictable(entry)) {
+                DEBUG("ipv6_nc: Evict %s\n",
+                      ipv6_addr_to_str(addr_str, &(entry->ipv6_addr), sizeof(addr_str)));
+                _nc_remove(entry->iface, entry);
+                _stats.evictions++;
+                break;
+            }
+        }
+        if (_free == 0) {
+            return NULL;
+        }
+    }
+    entry = _entry(_free);
+    _free = entry->hash_next;
+    return entry;
+}
+
+static gnrc_ipv6_nc_t *_find(kernel_pid_t iface, const ipv6_addr_t *ipv6_addr)
+{
+    for (gnrc_ipv6_nc_t *entry = _entry(*_bucket(ipv6_addr)); entry != NULL;
+         entry = _entry(entry->hash_next)) {
+        if (((entry->iface == KERNEL_PID_UNDEF) || (iface == KERNEL_PID_UNDEF) ||
+             (iface == entry->iface)) &&
+            ipv6_addr_equal(&(entry->ipv6_addr), ipv6_addr)) {
+            return entry;
         }
     }
 
@@ -114,31 +240,30 @@ gnrc_ipv6_nc_t *gnrc_ipv6_nc_add(kernel_pid_t iface, const ipv6_addr_t *ipv6_add
         return NULL;
     }
 
-    for (int i = 0; i < GNRC_IPV6_NC_SIZE; i++) {
-        if (ipv6_addr_equal(&(ncache[i].ipv6_addr), ipv6_addr)) {
-            DEBUG("ipv6_nc: Address %s already registered.\n",
-                  ipv6_addr_to_str(addr_str, ipv6_addr, sizeof(addr_str)));
+    gnrc_ipv6_nc_t *entry = _find(KERNEL_PID_UNDEF, ipv6_addr);
 
-            if ((l2_addr != NULL) && (l2_addr_len > 0)) {
-                DEBUG("ipv6_nc: Update to L2 address %s",
-                      gnrc_netif_addr_to_str(addr_str, sizeof(addr_str),
-                                             l2_addr, l2_addr_len));
+    if (entry != NULL) {
+        DEBUG("ipv6_nc: Address %s already registered.\n",
+              ipv6_addr_to_str(addr_str, ipv6_addr, sizeof(addr_str)));
 
-                memcpy(&(ncache[i].l2_addr), l2_addr, l2_addr_len);
-                ncache[i].l2_addr_len = l2_addr_len;
-                ncache[i].flags = flags;
-                DEBUG(" with flags = 0x%0x\n", flags);
+        if ((l2_addr != NULL) && (l2_addr_len > 0)) {
+            DEBUG("ipv6_nc: Update to L2 address %s",
+                  gnrc_netif_addr_to_str(addr_str, sizeof(addr_str),
+                                         l2_addr, l2_addr_len));
 
-            }
-            return &ncache[i];
-        }
+            memcpy(&(entry->l2_addr), l2_addr, l2_addr_len);
+            entry->l2_addr_len = l2_addr_len;
+            entry->flags = flags;
+            DEBUG(" with flags = 0x%0x\n", flags);
+            gnrc_ipv6_flowc_invalidate();
 
-        if (ipv6_addr_is_unspecified(&(ncache[i].ipv6_addr)) && !free_entry) {
-            /* found the first free entry */
-            free_entry = &ncache[i];
         }
+        _lru_touch(entry);
+        return entry;
     }
 
+    free_entry = _find_free_entry();
+
     if (!free_entry) {
         /* reached end of NC without finding updateable or free entry */
         DEBUG("ipv6_nc: neighbor cache full.\n");
@@ -188,6 +313,12 @@ gnrc_ipv6_nc_t *gnrc_ipv6_nc_add(kernel_pid_t iface, const ipv6_addr_t *ipv6_add
 
     free_entry->nbr_sol_msg.content.ptr = free_entry;
 
+    uint16_t *bucket = _bucket(ipv6_addr);
+    free_entry->hash_next = *bucket;
+    *bucket = _idx(free_entry);
+    _lru_push(free_entry);
+    gnrc_ipv6_flowc_invalidate();
+
     return free_entry;
 }
 
@@ -204,20 +335,21 @@ gnrc_ipv6_nc_t *gnrc_ipv6_nc_get(kernel_pid_t iface, const ipv6_addr_t *ipv6_add
         return NULL;
     }
 
-    for (int i = 0; i < GNRC_IPV6_NC_SIZE; i++) {
-        if (((ncache[i].iface == KERNEL_PID_UNDEF) || (iface == KERNEL_PID_UNDEF) ||
-             (iface == ncache[i].iface)) &&
-            ipv6_addr_equal(&(ncache[i].ipv6_addr), ipv6_addr)) {
-            DEBUG("ipv6_nc: Found entry for %s on interface %" PRIkernel_pid
-                  " (0 = all interfaces) [%p]\n",
-                  ipv6_addr_to_str(addr_str, ipv6_addr, sizeof(addr_str)),
-                  iface, (void *)(ncache + i));
+    gnrc_ipv6_nc_t *entry = _find(iface, ipv6_addr);
 
-            return ncache + i;
-        }
+    if (entry == NULL) {
+        _stats.misses++;
+        return NULL;
     }
 
-    return NULL;
+    DEBUG("ipv6_nc: Found entry for %s on interface %" PRIkernel_pid
+          " (0 = all interfaces) [%p]\n",
+          ipv6_addr_to_str(addr_str, ipv6_addr, sizeof(addr_str)),
+          iface, (void *)entry);
+    _stats.hits++;
+    _lru_touch(entry);
+
+    return entry;
 }
 
 gnrc_ipv6_nc_t *gnrc_ipv6_nc_get_next(gnrc_ipv6_nc_t *prev)
@@ -273,6 +405,9 @@ gnrc_ipv6_nc_t *gnrc_ipv6_nc_still_reachable(const ipv6_addr_t *ipv6_addr)
 
         DEBUG("ipv6_nc: Marking entry %s as reachable\n",
               ipv6_addr_to_str(addr_str, ipv6_addr, sizeof(addr_str)));
+        if (gnrc_ipv6_nc_get_state(entry) != GNRC_IPV6_NC_STATE_REACHABLE) {
+            gnrc_ipv6_flowc_invalidate();
+        }
         entry->flags &= ~(GNRC_IPV6_NC_STATE_MASK >> GNRC_IPV6_NC_STATE_POS);
         entry->flags |= (GNRC_IPV6_NC_STATE_REACHABLE >> GNRC_IPV6_NC_STATE_POS);
     }
@@ -292,4 +427,9 @@ kernel_pid_t gnrc_ipv6_nc_get_l2_addr(uint8_t *l2_addr, uint8_t *l2_addr_len,
     return entry->iface;
 }
 
+const gnrc_ipv6_nc_stats_t *gnrc_ipv6_nc_get_stats(void)
+{
+    return &_stats;
+}
+
 /** @} */
@@ -31,6 +31,7 @@
 #include "net/gnrc/netif/hdr.h"
 #include "net/gnrc/sixlowpan/nd.h"
 #include "net/gnrc/sixlowpan/netif.h"
+#include "net/gnrc/ipv6/flowc.h"
 
 #include "net/gnrc/ipv6/netif.h"
 
@@ -157,6 +158,7 @@ static ipv6_addr_t *_add_addr_to_entry(gnrc_ipv6_netif_t *entry, const ipv6_addr
 
     tmp_addr->valid_timeout_msg.type = GNRC_NDP_MSG_ADDR_TIMEOUT;
     tmp_addr->valid_timeout_msg.content.ptr = &tmp_addr->addr;
+    gnrc_ipv6_flowc_invalidate();
 
     return &(tmp_addr->addr);
 }
@@ -165,6 +167,7 @@ static void _reset_addr_from_entry(gnrc_ipv6_netif_t *entry)
 {
     DEBUG("ipv6 netif: Reset IPv6 addresses on interface %" PRIkernel_pid "\n", entry->pid);
     memset(entry->addrs, 0, sizeof(entry->addrs));
+    gnrc_ipv6_flowc_invalidate();
 }
 
 static void _ipv6_netif_remove(gnrc_ipv6_netif_t *entry)
@@ -322,6 +325,7 @@ static void _remove_addr_from_entry(gnrc_ipv6_netif_t *entry, ipv6_addr_t *addr)
                   ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)), entry->pid);
             ipv6_addr_set_unspecified(&(entry->addrs[i].addr));
             entry->addrs[i].flags = 0;
+            gnrc_ipv6_flowc_invalidate();
 #ifdef MODULE_GNRC_NDP_ROUTER
             /* Removal of prefixes MAY allow the router to retransmit up to
              * GNRC_NDP_MAX_INIT_RTR_ADV_NUMOF unsolicited RA
@@ -16,14 +16,21 @@
  * @author  Peter Kietzmann <peter.kietzmann@haw-hamburg.de>
  */
 
+#include <errno.h>
+#include <string.h>
+
 #include "kernel_types.h"
+#include "msg.h"
 #include "net/gnrc/pktbuf.h"
 #include "net/gnrc/netapi.h"
 #include "net/gnrc/netif/hdr.h"
 #include "net/gnrc/sixlowpan/frag.h"
+#include "net/gnrc/sixlowpan/frag/vrb.h"
 #include "net/gnrc/sixlowpan/netif.h"
 #include "net/sixlowpan.h"
+#include "thread.h"
 #include "utlist.h"
+#include "xtimer.h"
 
 #include "rbuf.h"
 
@@ -36,6 +43,8 @@
 #endif
 
 static uint16_t _tag;
+static xtimer_t _retry_timer;
+static msg_t _retry_msg = { .type = GNRC_SIXLOWPAN_MSG_FRAG_SND };
 
 static inline uint16_t _floor8(uint16_t length)
 {
@@ -47,8 +56,97 @@ static inline size_t _min(size_t a, size_t b)
     return (a < b) ? a : b;
 }
 
-static gnrc_pktsnip_t *_build_frag_pkt(gnrc_pktsnip_t *pkt, size_t payload_len,
-                                       size_t size)
+static bool _is_shared(gnrc_pktsnip_t *pkt)
+{
+    for (; pkt != NULL; pkt = pkt->next) {
+        /* data outside of the packet buffer can not be marked either */
+        if ((pkt->users > 1) || gnrc_pktbuf_is_ext(pkt)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* replaces a payload that is also held by someone else with a copy of it, so
+ * it can be cut into fragments. The copy is split behind the first fragment
+ * right away, so all subsequent fragments start on an 8 byte boundary */
+static int _unshare(gnrc_pktsnip_t *pkt, size_t first_len)
+{
+    gnrc_pktsnip_t *payload = pkt->next, *first, *rest = NULL;
+    size_t payload_len = gnrc_pkt_len(payload), offset = 0;
+
+    if (first_len < payload_len) {
+        rest = gnrc_pktbuf_add(NULL, NULL, payload_len - first_len,
+                               GNRC_NETTYPE_SIXLOWPAN);
+        if (rest == NULL) {
+            return -ENOBUFS;
+        }
+    }
+    first = gnrc_pktbuf_add(rest, NULL, first_len, GNRC_NETTYPE_SIXLOWPAN);
+    if (first == NULL) {
+        gnrc_pktbuf_release(rest);
+        return -ENOBUFS;
+    }
+    for (gnrc_pktsnip_t *ptr = payload; ptr != NULL; ptr = ptr->next) {
+        size_t clen = 0;
+
+        if (offset < first_len) {
+            clen = _min(first_len - offset, ptr->size);
+            memcpy(((uint8_t *)first->data) + offset, ptr->data, clen);
+        }
+        if (clen < ptr->size) {
+            memcpy(((uint8_t *)rest->data) + (offset + clen - first_len),
+                   ((uint8_t *)ptr->data) + clen, ptr->size - clen);
+        }
+        offset += ptr->size;
+    }
+    gnrc_pktbuf_release(payload);
+    pkt->next = first;
+    return 0;
+}
+
+/* cuts the first len bytes off the (unshared) payload behind pkt */
+static gnrc_pktsnip_t *_slice(gnrc_pktsnip_t *pkt, size_t len)
+{
+    gnrc_pktsnip_t *slice = pkt->next, *last = slice;
+    size_t sum = last->size;
+
+    while ((sum < len) && (last->next != NULL)) {
+        last = last->next;
+        sum += last->size;
+    }
+    if (sum > len) {
+        gnrc_pktsnip_t *rest;
+        void *data;
+        size_t size;
+
+        /* gnrc_pktbuf_mark() only splits in place if the cut is aligned
+         * within the snip. The first fragment ends at an 8 byte boundary of
+         * the uncompressed datagram, not of the compressed snip, so cutting
+         * it copies the snip once into two new allocations. The remainder
+         * then starts aligned, and the 8 byte multiples of subsequent
+         * fragments are cut without moving data as long as they don't
+         * span snips */
+        rest = gnrc_pktbuf_mark(last, last->size - (sum - len), last->type);
+        if (rest == NULL) {
+            return NULL;
+        }
+        /* the marked part is the front of the data, but it is linked behind
+         * the remainder: swap both */
+        data = last->data;
+        size = last->size;
+        last->data = rest->data;
+        last->size = rest->size;
+        rest->data = data;
+        rest->size = size;
+    }
+    pkt->next = last->next;
+    last->next = NULL;
+    return slice;
+}
+
+static gnrc_pktsnip_t *_build_frag_pkt(gnrc_pktsnip_t *pkt, size_t hdr_size,
+                                       size_t len)
 {
     gnrc_netif_hdr_t *hdr = pkt->data, *new_hdr;
     gnrc_pktsnip_t *netif, *frag;
@@ -67,163 +165,147 @@ static gnrc_pktsnip_t *_build_frag_pkt(gnrc_pktsnip_t *pkt, size_t payload_len,
     new_hdr->rssi = hdr->rssi;
     new_hdr->lqi = hdr->lqi;
 
-    frag = gnrc_pktbuf_add(NULL, NULL, _min(size, payload_len),
-                           GNRC_NETTYPE_SIXLOWPAN);
+    frag = gnrc_pktbuf_add(NULL, NULL, hdr_size, GNRC_NETTYPE_SIXLOWPAN);
 
     if (frag == NULL) {
-        DEBUG("6lo frag: error allocating first fragment\n");
+        DEBUG("6lo frag: error allocating fragment header\n");
         gnrc_pktbuf_release(netif);
         return NULL;
     }
 
     LL_PREPEND(frag, netif);
 
+    /* the fragment's payload is cut off the datagram */
+    if ((frag->next->next = _slice(pkt, len)) == NULL) {
+        DEBUG("6lo frag: error cutting fragment payload\n");
+        gnrc_pktbuf_release(frag);
+        return NULL;
+    }
+
     return frag;
 }
 
-static uint16_t _send_1st_fragment(gnrc_sixlowpan_netif_t *iface, gnrc_pktsnip_t *pkt,
-                                   size_t payload_len, size_t datagram_size)
+static inline uint16_t _1st_frag_size(gnrc_sixlowpan_netif_t *iface,
+                                      int payload_diff)
+{
+    /* virtually add payload_diff to flooring to account for offset (must be divisable by 8)
+     * in uncompressed datagram */
+    return _floor8(iface->max_frag_size + payload_diff -
+                   sizeof(sixlowpan_frag_t)) - payload_diff;
+}
+
+static gnrc_pktsnip_t *_build_1st_fragment(gnrc_sixlowpan_netif_t *iface,
+                                           gnrc_sixlowpan_msg_frag_t *fragment_msg,
+                                           size_t payload_len)
 {
     gnrc_pktsnip_t *frag;
-    uint16_t local_offset = 0;
     /* payload_len: actual size of the packet vs
      * datagram_size: size of the uncompressed IPv6 packet */
-    int payload_diff = (datagram_size - payload_len);
-    /* virtually add payload_diff to flooring to account for offset (must be divisable by 8)
-     * in uncompressed datagram */
-    uint16_t max_frag_size = _floor8(iface->max_frag_size + payload_diff -
-                                     sizeof(sixlowpan_frag_t)) - payload_diff;
+    int payload_diff = (fragment_msg->datagram_size - payload_len);
+    uint16_t max_frag_size = _1st_frag_size(iface, payload_diff);
     sixlowpan_frag_t *hdr;
-    uint8_t *data;
 
     DEBUG("6lo frag: determined max_frag_size = %" PRIu16 "\n", max_frag_size);
 
-    frag = _build_frag_pkt(pkt, payload_len,
-                           max_frag_size + sizeof(sixlowpan_frag_t));
+    frag = _build_frag_pkt(fragment_msg->pkt, sizeof(sixlowpan_frag_t),
+                           _min(max_frag_size, payload_len));
 
     if (frag == NULL) {
-        return 0;
+        return NULL;
     }
 
     hdr = frag->next->data;
-    data = (uint8_t *)(hdr + 1);
-
-    hdr->disp_size = byteorder_htons((uint16_t)datagram_size);
+    hdr->disp_size = byteorder_htons((uint16_t)fragment_msg->datagram_size);
     hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
-    hdr->tag = byteorder_htons(_tag);
+    hdr->tag = byteorder_htons(fragment_msg->tag);
 
-    pkt = pkt->next;    /* don't copy netif header */
+    DEBUG("6lo frag: build first fragment (datagram size: %u, "
+          "datagram tag: %" PRIu16 ", fragment size: %u)\n",
+          (unsigned int)fragment_msg->datagram_size, fragment_msg->tag,
+          (unsigned int)gnrc_pkt_len(frag->next->next));
+    fragment_msg->offset += gnrc_pkt_len(frag->next->next);
 
-    while (pkt != NULL) {
-        size_t clen = _min(max_frag_size - local_offset, pkt->size);
-
-        memcpy(data + local_offset, pkt->data, clen);
-        local_offset += clen;
-
-        if (local_offset >= max_frag_size) {
-            break;
-        }
-
-        pkt = pkt->next;
-    }
-
-    DEBUG("6lo frag: send first fragment (datagram size: %u, "
-          "datagram tag: %" PRIu16 ", fragment size: %" PRIu16 ")\n",
-          (unsigned int)datagram_size, _tag, local_offset);
-    if (gnrc_netapi_send(iface->pid, frag) < 1) {
-        DEBUG("6lo frag: unable to send first fragment\n");
-        gnrc_pktbuf_release(frag);
-    }
-
-    return local_offset;
+    return frag;
 }
 
-static uint16_t _send_nth_fragment(gnrc_sixlowpan_netif_t *iface, gnrc_pktsnip_t *pkt,
-                                   size_t payload_len, size_t datagram_size,
-                                   uint16_t offset)
+static gnrc_pktsnip_t *_build_nth_fragment(gnrc_sixlowpan_netif_t *iface,
+                                           gnrc_sixlowpan_msg_frag_t *fragment_msg,
+                                           size_t payload_len)
 {
     gnrc_pktsnip_t *frag;
     /* since dispatches aren't supposed to go into subsequent fragments, we need not account
      * for payload difference as for the first fragment */
     uint16_t max_frag_size = _floor8(iface->max_frag_size - sizeof(sixlowpan_frag_n_t));
-    uint16_t local_offset = 0, offset_count = 0;
+    /* payload_len is what is left of the datagram, so everything in front of
+     * it is uncompressed */
+    size_t offset = fragment_msg->datagram_size - payload_len;
     sixlowpan_frag_n_t *hdr;
-    uint8_t *data;
 
     DEBUG("6lo frag: determined max_frag_size = %" PRIu16 "\n", max_frag_size);
 
-    frag = _build_frag_pkt(pkt,
-                           payload_len - offset + sizeof(sixlowpan_frag_n_t),
-                           max_frag_size + sizeof(sixlowpan_frag_n_t));
+    frag = _build_frag_pkt(fragment_msg->pkt, sizeof(sixlowpan_frag_n_t),
+                           _min(max_frag_size, payload_len));
 
     if (frag == NULL) {
-        return 0;
+        return NULL;
     }
 
     hdr = frag->next->data;
-    data = (uint8_t *)(hdr + 1);
-
     /* XXX: truncation of datagram_size > 4095 may happen here */
-    hdr->disp_size = byteorder_htons((uint16_t)datagram_size);
+    hdr->disp_size = byteorder_htons((uint16_t)fragment_msg->datagram_size);
     hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_N_DISP;
-    hdr->tag = byteorder_htons(_tag);
-    /* don't mention payload diff in offset */
-    hdr->offset = (uint8_t)((offset + (datagram_size - payload_len)) >> 3);
-    pkt = pkt->next;    /* don't copy netif header */
-
-    while ((pkt != NULL) && (offset_count != offset)) {   /* go to offset */
-        offset_count += (uint16_t)pkt->size;
-
-        if (offset_count > offset) {    /* we overshot */
-            /* => copy rest of partly send packet snip */
-            uint16_t pkt_offset = offset - (offset_count - ((uint16_t)pkt->size));
-            size_t clen = _min(max_frag_size, pkt->size - pkt_offset);
-
-            memcpy(data, ((uint8_t *)pkt->data) + pkt_offset, clen);
-            local_offset = clen;
-            pkt = pkt->next;
-            break;
-        }
-
-        pkt = pkt->next;
-    }
+    hdr->tag = byteorder_htons(fragment_msg->tag);
+    hdr->offset = (uint8_t)(offset >> 3);
 
-    if (local_offset < max_frag_size) { /* copy other packet snips */
-        while (pkt != NULL) {
-            size_t clen = _min(max_frag_size - local_offset, pkt->size);
+    DEBUG("6lo frag: build subsequent fragment (datagram size: %u, "
+          "datagram tag: %" PRIu16 ", offset: %" PRIu8 " (%u bytes), "
+          "fragment size: %u)\n",
+          (unsigned int)fragment_msg->datagram_size, fragment_msg->tag,
+          hdr->offset, hdr->offset << 3,
+          (unsigned int)gnrc_pkt_len(frag->next->next));
+    fragment_msg->offset += gnrc_pkt_len(frag->next->next);
 
-            memcpy(data + local_offset, pkt->data, clen);
-            local_offset += clen;
+    return frag;
+}
 
-            if (local_offset == max_frag_size) {
-                break;
-            }
+/* puts the payload of fragments the interface did not accept back in front
+ * of the rest of the datagram */
+static void _unbuild(gnrc_sixlowpan_msg_frag_t *fragment_msg, msg_t *msgs,
+                     unsigned num)
+{
+    while (num > 0) {
+        gnrc_pktsnip_t *frag = msgs[--num].content.ptr;
+        gnrc_pktsnip_t *payload = frag->next->next, *last = payload;
 
-            pkt = pkt->next;
+        frag->next->next = NULL;
+        gnrc_pktbuf_release(frag);
+        fragment_msg->offset -= last->size;
+        while (last->next != NULL) {
+            last = last->next;
+            fragment_msg->offset -= last->size;
         }
+        last->next = fragment_msg->pkt->next;
+        fragment_msg->pkt->next = payload;
     }
+}
 
-    DEBUG("6lo frag: send subsequent fragment (datagram size: %u, "
-          "datagram tag: %" PRIu16 ", offset: %" PRIu8 " (%u bytes), "
-          "fragment size: %" PRIu16 ")\n",
-          (unsigned int)datagram_size, _tag, hdr->offset, hdr->offset << 3,
-          local_offset);
-    if (gnrc_netapi_send(iface->pid, frag) < 1) {
-        DEBUG("6lo frag: unable to send subsequent fragment\n");
-        gnrc_pktbuf_release(frag);
+static void _release_batch(msg_t *msgs, unsigned num)
+{
+    while (num > 0) {
+        gnrc_pktbuf_release(msgs[--num].content.ptr);
     }
+}
 
-    return local_offset;
+uint16_t gnrc_sixlowpan_frag_next_tag(void)
+{
+    /* increment tag for successive, fragmented datagrams */
+    return ++_tag;
 }
 
 void gnrc_sixlowpan_frag_send(gnrc_sixlowpan_msg_frag_t *fragment_msg)
 {
     gnrc_sixlowpan_netif_t *iface = gnrc_sixlowpan_netif_get(fragment_msg->pid);
-    uint16_t res;
-    /* payload_len: actual size of the packet vs
-     * datagram_size: size of the uncompressed IPv6 packet */
-    size_t payload_len = gnrc_pkt_len(fragment_msg->pkt->next);
-    msg_t msg;
+    msg_t msgs[GNRC_SIXLOWPAN_FRAG_BATCH_SIZE];
 
 #if defined(DEVELHELP) && defined(ENABLE_DEBUG)
     if (iface == NULL) {
@@ -236,50 +318,79 @@ void gnrc_sixlowpan_frag_send(gnrc_sixlowpan_msg_frag_t *fragment_msg)
     }
 #endif
 
-    /* Check weater to send the first or an Nth fragment */
     if (fragment_msg->offset == 0) {
-        /* increment tag for successive, fragmented datagrams */
-        _tag++;
-        if ((res = _send_1st_fragment(iface, fragment_msg->pkt, payload_len, fragment_msg->datagram_size)) == 0) {
-            /* error sending first fragment */
-            DEBUG("6lo frag: error sending 1st fragment\n");
-            gnrc_pktbuf_release(fragment_msg->pkt);
-            fragment_msg->pkt = NULL;
-            return;
+        fragment_msg->tag = gnrc_sixlowpan_frag_next_tag();
+        if (_is_shared(fragment_msg->pkt->next)) {
+            /* payload_len: actual size of the packet vs
+             * datagram_size: size of the uncompressed IPv6 packet */
+            size_t payload_len = gnrc_pkt_len(fragment_msg->pkt->next);
+            int payload_diff = (fragment_msg->datagram_size - payload_len);
+
+            DEBUG("6lo frag: datagram is shared, copying it\n");
+            if (_unshare(fragment_msg->pkt,
+                         _min(_1st_frag_size(iface, payload_diff),
+                              payload_len)) < 0) {
+                DEBUG("6lo frag: no space left in packet buffer\n");
+                gnrc_pktbuf_release(fragment_msg->pkt);
+                fragment_msg->pkt = NULL;
+                return;
+            }
         }
-        fragment_msg->offset += res;
-
-        /* send message to self*/
-        msg.type = GNRC_SIXLOWPAN_MSG_FRAG_SND;
-        msg.content.ptr = (void *)fragment_msg;
-        msg_send_to_self(&msg);
-        thread_yield();
     }
-    else {
-        /* (offset + (datagram_size - payload_len) < datagram_size) simplified */
-        if (fragment_msg->offset < payload_len) {
-            if ((res = _send_nth_fragment(iface, fragment_msg->pkt, payload_len, fragment_msg->datagram_size,
-                                          fragment_msg->offset)) == 0) {
-                /* error sending subsequent fragment */
-                DEBUG("6lo frag: error sending subsequent fragment (offset = %" PRIu16
+
+    while (fragment_msg->pkt->next != NULL) {
+        unsigned num = 0;
+        int res;
+
+        /* cut as many fragments as the interface is handed at once */
+        while ((num < GNRC_SIXLOWPAN_FRAG_BATCH_SIZE) &&
+               (fragment_msg->pkt->next != NULL)) {
+            size_t payload_len = gnrc_pkt_len(fragment_msg->pkt->next);
+            gnrc_pktsnip_t *frag;
+
+            if (fragment_msg->offset == 0) {
+                frag = _build_1st_fragment(iface, fragment_msg, payload_len);
+            }
+            else {
+                frag = _build_nth_fragment(iface, fragment_msg, payload_len);
+            }
+            if (frag == NULL) {
+                DEBUG("6lo frag: error building fragment (offset = %" PRIu16
                       ")\n", fragment_msg->offset);
+                _release_batch(msgs, num);
                 gnrc_pktbuf_release(fragment_msg->pkt);
                 fragment_msg->pkt = NULL;
                 return;
-                }
-            fragment_msg->offset += res;
-
-            /* send message to self*/
-            msg.type = GNRC_SIXLOWPAN_MSG_FRAG_SND;
-            msg.content.ptr = (void *)fragment_msg;
-            msg_send_to_self(&msg);
-            thread_yield();
+            }
+            msgs[num].type = GNRC_NETAPI_MSG_TYPE_SND;
+            msgs[num].content.ptr = frag;
+            num++;
         }
-        else {
+
+        /* wakes the interface only once for the whole batch */
+        res = msg_send_many(msgs, num, fragment_msg->pid);
+        if (res < 0) {
+            DEBUG("6lo frag: invalid interface %" PRIkernel_pid "\n",
+                  fragment_msg->pid);
+            _release_batch(msgs, num);
             gnrc_pktbuf_release(fragment_msg->pkt);
             fragment_msg->pkt = NULL;
+            return;
+        }
+        if ((unsigned)res < num) {
+            DEBUG("6lo frag: interface took %d of %u fragments, continuing "
+                  "later\n", res, num);
+            _unbuild(fragment_msg, msgs + res, num - res);
+            /* give the interface time to send what it has queued */
+            _retry_msg.content.ptr = fragment_msg;
+            xtimer_set_msg(&_retry_timer, GNRC_SIXLOWPAN_FRAG_RETRY_DELAY,
+                           &_retry_msg, sched_active_pid);
+            return;
         }
     }
+
+    gnrc_pktbuf_release(fragment_msg->pkt);
+    fragment_msg->pkt = NULL;
 }
 
 void gnrc_sixlowpan_frag_handle_pkt(gnrc_pktsnip_t *pkt)
@@ -306,9 +417,22 @@ void gnrc_sixlowpan_frag_handle_pkt(gnrc_pktsnip_t *pkt)
             return;
     }
 
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+    /* a datagram with fragments in the reassembly buffer is reassembled, its
+     * first fragment did not arrive first */
+    if (!rbuf_has(hdr, frag) && gnrc_sixlowpan_frag_vrb_forward(pkt, offset)) {
+        return;
+    }
+#endif
+
     rbuf_add(hdr, pkt, frag_size, offset);
 
     gnrc_pktbuf_release(pkt);
 }
 
+void gnrc_sixlowpan_frag_gc_rbuf(void)
+{
+    rbuf_gc();
+}
+
 /** @} */
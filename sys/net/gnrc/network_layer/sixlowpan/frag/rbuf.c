@@ -12,8 +12,10 @@
  * @file
  */
 
+#include <assert.h>
 #include <inttypes.h>
 #include <stdbool.h>
+#include <string.h>
 
 #include "rbuf.h"
 #include "net/ipv6/hdr.h"
@@ -29,23 +31,28 @@
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
-/* estimated fragment payload size to determinate RBUF_INT_SIZE, default to
- * MAC payload size - fragment header. */
-#ifndef GNRC_SIXLOWPAN_FRAG_SIZE
-/* assuming 64-bit source/destination address, source PAN ID omitted */
-#define GNRC_SIXLOWPAN_FRAG_SIZE (104 - 5)
+#if RBUF_SIZE > 255
+#error "RBUF_SIZE must not exceed 255"
 #endif
 
-#ifndef RBUF_INT_SIZE
-/* same as ((int) ceil((double) N / D)) */
-#define DIV_CEIL(N, D) (((N) + (D) - 1) / (D))
-#define RBUF_INT_SIZE (DIV_CEIL(GNRC_IPV6_NETIF_DEFAULT_MTU, GNRC_SIXLOWPAN_FRAG_SIZE) * RBUF_SIZE)
+#if (RBUF_HASH_SIZE & (RBUF_HASH_SIZE - 1))
+#error "RBUF_HASH_SIZE must be a power of two"
 #endif
 
-static rbuf_int_t rbuf_int[RBUF_INT_SIZE];
-
 static rbuf_t rbuf[RBUF_SIZE];
 
+/* entries are linked by index + 1, so a zeroed buffer is empty */
+static uint8_t _buckets[RBUF_HASH_SIZE];
+static uint8_t _free;           /* removed entries */
+static uint8_t _high_water;     /* entries from here on were never used */
+static uint8_t _oldest;         /* entry to time out next */
+static uint8_t _newest;         /* entry that received the last fragment */
+
+static xtimer_t _gc_timer;
+static msg_t _gc_msg = { .type = GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF };
+static uint32_t _gc_due;
+static bool _gc_armed = false;
+
 #if ENABLE_DEBUG
 static char l2addr_str[3 * RBUF_L2ADDR_MAX_LEN];
 #endif
@@ -53,21 +60,74 @@ static char l2addr_str[3 * RBUF_L2ADDR_MAX_LEN];
 /* ------------------------------------
  * internal function definitions
  * ------------------------------------*/
-/* checks whether start and end overlaps, but not identical to, given interval i */
-static inline bool _rbuf_int_overlap_partially(rbuf_int_t *i, uint16_t start, uint16_t end);
-/* gets a free entry from interval buffer */
-static rbuf_int_t *_rbuf_int_get_free(void);
+/* checks how many of the 8-octet units from first to last were received */
+static unsigned _rbuf_units_received(rbuf_t *entry, unsigned first, unsigned last);
 /* remove entry from reassembly buffer */
 static void _rbuf_rem(rbuf_t *entry);
-/* update interval buffer of entry */
-static bool _rbuf_update_ints(rbuf_t *entry, uint16_t offset, size_t frag_size);
-/* checks timeouts and removes entries if necessary (oldest if full) */
-static void _rbuf_gc(void);
+/* removes timed out entries and schedules the next garbage collection */
+static void _rbuf_gc(uint32_t now_usec);
+/* schedules the garbage collection for the oldest entry */
+static void _rbuf_gc_arm(uint32_t now_usec);
+/* finds an entry identified by its tupel in its bucket */
+static rbuf_t *_rbuf_find(const void *src, size_t src_len,
+                          const void *dst, size_t dst_len,
+                          size_t size, uint16_t tag, uint8_t bucket);
 /* gets an entry identified by its tupel */
 static rbuf_t *_rbuf_get(const void *src, size_t src_len,
                          const void *dst, size_t dst_len,
                          size_t size, uint16_t tag);
 
+static inline uint8_t _idx(const rbuf_t *entry)
+{
+    return (uint8_t)(entry - rbuf) + 1;
+}
+
+static inline rbuf_t *_entry(uint8_t idx)
+{
+    return (idx == 0) ? NULL : &rbuf[idx - 1];
+}
+
+static uint8_t _bucket(const uint8_t *src, size_t src_len, size_t size,
+                       uint16_t tag)
+{
+    /* the destination is usually this node, so it is left out */
+    uint32_t key = ((uint32_t)size << 16) | tag;
+
+    for (unsigned i = 0; i < src_len; i++) {
+        key = (key ^ src[i]) * 16777619U;
+    }
+    return ((key * 2654435761U) >> 16) & (RBUF_HASH_SIZE - 1);
+}
+
+static void _age_remove(rbuf_t *entry)
+{
+    if (entry->older != 0) {
+        _entry(entry->older)->newer = entry->newer;
+    }
+    else {
+        _oldest = entry->newer;
+    }
+    if (entry->newer != 0) {
+        _entry(entry->newer)->older = entry->older;
+    }
+    else {
+        _newest = entry->older;
+    }
+}
+
+static void _age_push(rbuf_t *entry)
+{
+    entry->newer = 0;
+    entry->older = _newest;
+    if (_newest != 0) {
+        _entry(_newest)->newer = _idx(entry);
+    }
+    else {
+        _oldest = _idx(entry);
+    }
+    _newest = _idx(entry);
+}
+
 void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
               size_t frag_size, size_t offset)
 {
@@ -77,10 +137,10 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
     unsigned int data_offset = 0;
     size_t original_size = frag_size;
     sixlowpan_frag_t *frag = pkt->data;
-    rbuf_int_t *ptr;
+    unsigned first, last, received;
     uint8_t *data = ((uint8_t *)pkt->data) + sizeof(sixlowpan_frag_t);
 
-    _rbuf_gc();
+    _rbuf_gc(xtimer_now_usec());
     entry = _rbuf_get(gnrc_netif_hdr_get_src_addr(netif_hdr), netif_hdr->src_l2addr_len,
                       gnrc_netif_hdr_get_dst_addr(netif_hdr), netif_hdr->dst_l2addr_len,
                       byteorder_ntohs(frag->disp_size) & SIXLOWPAN_FRAG_SIZE_MASK,
@@ -91,8 +151,6 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
         return;
     }
 
-    ptr = entry->ints;
-
     /* dispatches in the first fragment are ignored */
     if (offset == 0) {
         if (data[0] == SIXLOWPAN_UNCOMP) {
@@ -123,8 +181,9 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
         data++; /* FRAGN header is one byte longer (offset) */
     }
 
-    if ((offset + frag_size) > entry->pkt->size) {
-        DEBUG("6lo rfrag: fragment too big for resulting datagram, discarding datagram\n");
+    if ((frag_size == 0) || ((offset + frag_size) > entry->pkt->size)) {
+        DEBUG("6lo rfrag: fragment empty or too big for resulting datagram, "
+              "discarding datagram\n");
         gnrc_pktbuf_release(entry->pkt);
         _rbuf_rem(entry);
         return;
@@ -132,26 +191,37 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
 
     /* If the fragment overlaps another fragment and differs in either the size
      * or the offset of the overlapped fragment, discards the datagram
-     * https://tools.ietf.org/html/rfc4944#section-5.3 */
-    while (ptr != NULL) {
-        if (_rbuf_int_overlap_partially(ptr, offset, offset + frag_size - 1)) {
-            DEBUG("6lo rfrag: overlapping intervals, discarding datagram\n");
-            gnrc_pktbuf_release(entry->pkt);
-            _rbuf_rem(entry);
-
-            /* "A fresh reassembly may be commenced with the most recently
-             * received link fragment"
-             * https://tools.ietf.org/html/rfc4944#section-5.3 */
-            rbuf_add(netif_hdr, pkt, original_size, offset);
+     * https://tools.ietf.org/html/rfc4944#section-5.3
+     * As all offsets are multiples of 8, a fragment that covers only units
+     * that were already received is taken as a duplicate. */
+    first = offset / 8;
+    last = (offset + frag_size - 1) / 8;
+    received = _rbuf_units_received(entry, first, last);
+
+    if ((received > 0) && (received <= (last - first))) {
+        DEBUG("6lo rfrag: overlapping intervals, discarding datagram\n");
+        gnrc_pktbuf_release(entry->pkt);
+        _rbuf_rem(entry);
 
-            return;
-        }
+        /* "A fresh reassembly may be commenced with the most recently
+         * received link fragment"
+         * https://tools.ietf.org/html/rfc4944#section-5.3 */
+        rbuf_add(netif_hdr, pkt, original_size, offset);
 
-        ptr = ptr->next;
+        return;
     }
 
-    if (_rbuf_update_ints(entry, offset, frag_size)) {
-        DEBUG("6lo rbuf: add fragment data\n");
+    if (received == 0) {
+        DEBUG("6lo rfrag: add interval (%u, %u) to entry (%s, ",
+              (unsigned)offset, (unsigned)(offset + frag_size - 1),
+              gnrc_netif_addr_to_str(l2addr_str, sizeof(l2addr_str),
+                                     entry->src, entry->src_len));
+        DEBUG("%s, %u, %u)\n", gnrc_netif_addr_to_str(l2addr_str,
+                sizeof(l2addr_str), entry->dst, entry->dst_len),
+              (unsigned)entry->pkt->size, entry->tag);
+        for (unsigned i = first; i <= last; i++) {
+            bf_set(entry->received, i);
+        }
         entry->cur_size += (uint16_t)frag_size;
         memcpy(((uint8_t *)entry->pkt->data) + offset + data_offset, data,
                frag_size - data_offset);
@@ -189,132 +259,156 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
     }
 }
 
-static inline bool _rbuf_int_overlap_partially(rbuf_int_t *i, uint16_t start, uint16_t end)
+bool rbuf_has(gnrc_netif_hdr_t *netif_hdr, sixlowpan_frag_t *frag)
+{
+    const uint8_t *src = gnrc_netif_hdr_get_src_addr(netif_hdr);
+    size_t size = byteorder_ntohs(frag->disp_size) & SIXLOWPAN_FRAG_SIZE_MASK;
+    uint16_t tag = byteorder_ntohs(frag->tag);
+
+    return _rbuf_find(src, netif_hdr->src_l2addr_len,
+                      gnrc_netif_hdr_get_dst_addr(netif_hdr),
+                      netif_hdr->dst_l2addr_len, size, tag,
+                      _bucket(src, netif_hdr->src_l2addr_len, size, tag)) != NULL;
+}
+
+void rbuf_gc(void)
 {
-    /* start and ends are both inclusive, so using <= for both */
-    return ((i->start <= end) && (start <= i->end)) && /* overlaps */
-        ((start != i->start) || (end != i->end)); /* not identical */
+    _gc_armed = false;
+    _rbuf_gc(xtimer_now_usec());
 }
 
-static rbuf_int_t *_rbuf_int_get_free(void)
+static unsigned _rbuf_units_received(rbuf_t *entry, unsigned first, unsigned last)
 {
-    for (unsigned int i = 0; i < RBUF_INT_SIZE; i++) {
-        if (rbuf_int[i].end == 0) { /* start must be smaller than end anyways*/
-            return rbuf_int + i;
+    unsigned res = 0;
+
+    for (unsigned i = first; i <= last; i++) {
+        if (bf_isset(entry->received, i)) {
+            res++;
         }
     }
-
-    return NULL;
+    return res;
 }
 
 static void _rbuf_rem(rbuf_t *entry)
 {
-    while (entry->ints != NULL) {
-        rbuf_int_t *next = entry->ints->next;
+    /* entry->pkt may already be released here */
+    uint8_t *ptr = &_buckets[entry->bucket];
 
-        entry->ints->start = 0;
-        entry->ints->end = 0;
-        entry->ints->next = NULL;
-        entry->ints = next;
+    while (*ptr != _idx(entry)) {
+        assert(*ptr != 0);
+        ptr = &_entry(*ptr)->next;
     }
+    *ptr = entry->next;
+    _age_remove(entry);
 
     entry->pkt = NULL;
+    entry->next = _free;
+    _free = _idx(entry);
 }
 
-static bool _rbuf_update_ints(rbuf_t *entry, uint16_t offset, size_t frag_size)
+static void _rbuf_gc(uint32_t now_usec)
 {
-    rbuf_int_t *new;
-    uint16_t end = (uint16_t)(offset + frag_size - 1);
+    rbuf_t *entry;
 
-    new = _rbuf_int_get_free();
+    /* entries are ordered by arrival of their last fragment, so only the
+     * oldest entries need to be looked at */
+    while (((entry = _entry(_oldest)) != NULL) &&
+           ((now_usec - entry->arrival) >= RBUF_TIMEOUT)) {
+        /* since pkt occupies pktbuf, aggressivly collect garbage */
+        DEBUG("6lo rfrag: entry (%s, ", gnrc_netif_addr_to_str(l2addr_str,
+                sizeof(l2addr_str), entry->src, entry->src_len));
+        DEBUG("%s, %u, %u) timed out\n",
+              gnrc_netif_addr_to_str(l2addr_str, sizeof(l2addr_str), entry->dst,
+                                     entry->dst_len),
+              (unsigned)entry->pkt->size, entry->tag);
 
-    if (new == NULL) {
-        DEBUG("6lo rfrag: no space left in rbuf interval buffer.\n");
-        return false;
+        gnrc_pktbuf_release(entry->pkt);
+        _rbuf_rem(entry);
     }
 
-    new->start = offset;
-    new->end = end;
-
-    DEBUG("6lo rfrag: add interval (%" PRIu16 ", %" PRIu16 ") to entry (%s, ",
-          new->start, new->end, gnrc_netif_addr_to_str(l2addr_str,
-                  sizeof(l2addr_str), entry->src, entry->src_len));
-    DEBUG("%s, %u, %u)\n", gnrc_netif_addr_to_str(l2addr_str,
-            sizeof(l2addr_str), entry->dst, entry->dst_len),
-          (unsigned)entry->pkt->size, entry->tag);
+    _rbuf_gc_arm(now_usec);
+}
 
-    LL_PREPEND(entry->ints, new);
+static void _rbuf_gc_arm(uint32_t now_usec)
+{
+    rbuf_t *entry = _entry(_oldest);
+    kernel_pid_t pid = sched_active_pid;
 
-    return true;
+#ifdef MODULE_GNRC_NETAPI_INLINE
+    /* the reassembly buffer belongs to the thread running the stack */
+    if (gnrc_netapi_inline_pid != KERNEL_PID_UNDEF) {
+        pid = gnrc_netapi_inline_pid;
+    }
+#endif
+    /* The timer is only armed for the oldest entry at that time. If this
+     * entry receives more fragments in between, the timer fires early and is
+     * re-armed by _rbuf_gc(). A timer that is overdue lost its message, since
+     * the target's queue was full. */
+    if ((entry != NULL) &&
+        (!_gc_armed || ((int32_t)(now_usec - _gc_due) > 0))) {
+        uint32_t offset = RBUF_TIMEOUT - (now_usec - entry->arrival);
+
+        _gc_due = now_usec + offset;
+        _gc_armed = true;
+        xtimer_set_msg(&_gc_timer, offset, &_gc_msg, pid);
+    }
 }
 
-static void _rbuf_gc(void)
+static rbuf_t *_rbuf_find(const void *src, size_t src_len,
+                          const void *dst, size_t dst_len,
+                          size_t size, uint16_t tag, uint8_t bucket)
 {
-    uint32_t now_usec = xtimer_now_usec();
-    unsigned int i;
-
-    for (i = 0; i < RBUF_SIZE; i++) {
-        /* since pkt occupies pktbuf, aggressivly collect garbage */
-        if ((rbuf[i].pkt != NULL) &&
-              ((now_usec - rbuf[i].arrival) > RBUF_TIMEOUT)) {
-            DEBUG("6lo rfrag: entry (%s, ", gnrc_netif_addr_to_str(l2addr_str,
-                    sizeof(l2addr_str), rbuf[i].src, rbuf[i].src_len));
-            DEBUG("%s, %u, %u) timed out\n",
-                  gnrc_netif_addr_to_str(l2addr_str, sizeof(l2addr_str), rbuf[i].dst,
-                                         rbuf[i].dst_len),
-                  (unsigned)rbuf[i].pkt->size, rbuf[i].tag);
-
-            gnrc_pktbuf_release(rbuf[i].pkt);
-            _rbuf_rem(&(rbuf[i]));
+    for (rbuf_t *res = _entry(_buckets[bucket]); res != NULL;
+         res = _entry(res->next)) {
+        if ((res->pkt->size == size) && (res->tag == tag) &&
+            (res->src_len == src_len) && (res->dst_len == dst_len) &&
+            (memcmp(res->src, src, src_len) == 0) &&
+            (memcmp(res->dst, dst, dst_len) == 0)) {
+            DEBUG("6lo rfrag: entry %p (%s, ", (void *)res,
+                  gnrc_netif_addr_to_str(l2addr_str, sizeof(l2addr_str),
+                                         res->src, res->src_len));
+            DEBUG("%s, %u, %u) found\n",
+                  gnrc_netif_addr_to_str(l2addr_str, sizeof(l2addr_str),
+                                         res->dst, res->dst_len),
+                  (unsigned)res->pkt->size, res->tag);
+            return res;
         }
     }
+    return NULL;
 }
 
 static rbuf_t *_rbuf_get(const void *src, size_t src_len,
                          const void *dst, size_t dst_len,
                          size_t size, uint16_t tag)
 {
-    rbuf_t *res = NULL, *oldest = NULL;
+    rbuf_t *res;
+    uint8_t bucket = _bucket(src, src_len, size, tag);
     uint32_t now_usec = xtimer_now_usec();
 
-    for (unsigned int i = 0; i < RBUF_SIZE; i++) {
-        /* check first if entry already available */
-        if ((rbuf[i].pkt != NULL) && (rbuf[i].pkt->size == size) &&
-            (rbuf[i].tag == tag) && (rbuf[i].src_len == src_len) &&
-            (rbuf[i].dst_len == dst_len) &&
-            (memcmp(rbuf[i].src, src, src_len) == 0) &&
-            (memcmp(rbuf[i].dst, dst, dst_len) == 0)) {
-            DEBUG("6lo rfrag: entry %p (%s, ", (void *)(&rbuf[i]),
-                  gnrc_netif_addr_to_str(l2addr_str, sizeof(l2addr_str),
-                                         rbuf[i].src, rbuf[i].src_len));
-            DEBUG("%s, %u, %u) found\n",
-                  gnrc_netif_addr_to_str(l2addr_str, sizeof(l2addr_str),
-                                         rbuf[i].dst, rbuf[i].dst_len),
-                  (unsigned)rbuf[i].pkt->size, rbuf[i].tag);
-            rbuf[i].arrival = now_usec;
-            return &(rbuf[i]);
-        }
-
-        /* if there is a free spot: remember it */
-        if ((res == NULL) && (rbuf[i].pkt == NULL)) {
-            res = &(rbuf[i]);
-        }
-
-        /* remember oldest slot */
-        /* note that xtimer_now will overflow in ~1.2 hours */
-        if ((oldest == NULL) || (oldest->arrival - rbuf[i].arrival < UINT32_MAX / 2)) {
-            oldest = &(rbuf[i]);
-        }
+    /* check first if entry already available */
+    if ((res = _rbuf_find(src, src_len, dst, dst_len, size, tag, bucket)) != NULL) {
+        res->arrival = now_usec;
+        _age_remove(res);
+        _age_push(res);
+        _rbuf_gc_arm(now_usec);
+        return res;
     }
 
-    /* entry not in buffer and no empty spot found */
-    if (res == NULL) {
-        assert(oldest != NULL);
-        assert(oldest->pkt != NULL); /* if oldest->pkt == NULL, res must not be NULL */
+    if (_free != 0) {
+        res = _entry(_free);
+        _free = res->next;
+    }
+    else if (_high_water < RBUF_SIZE) {
+        res = &rbuf[_high_water++];
+    }
+    else {
+        /* entry not in buffer and no empty spot found */
+        res = _entry(_oldest);
+        assert(res != NULL);
         DEBUG("6lo rfrag: reassembly buffer full, remove oldest entry\n");
-        gnrc_pktbuf_release(oldest->pkt);
-        _rbuf_rem(oldest);
-        res = oldest;
+        gnrc_pktbuf_release(res->pkt);
+        _rbuf_rem(res);
+        _free = res->next;
     }
 
     /* now we have an empty spot */
@@ -322,18 +416,27 @@ static rbuf_t *_rbuf_get(const void *src, size_t src_len,
     res->pkt = gnrc_pktbuf_add(NULL, NULL, size, GNRC_NETTYPE_IPV6);
     if (res->pkt == NULL) {
         DEBUG("6lo rfrag: can not allocate reassembly buffer space.\n");
+        res->next = _free;
+        _free = _idx(res);
         return NULL;
     }
 
     *((uint64_t *)res->pkt->data) = 0;  /* clean first few bytes for later
                                          * look-ups */
     res->arrival = now_usec;
+    memset(res->received, 0, sizeof(res->received));
     memcpy(res->src, src, src_len);
     memcpy(res->dst, dst, dst_len);
     res->src_len = src_len;
     res->dst_len = dst_len;
     res->tag = tag;
     res->cur_size = 0;
+    res->bucket = bucket;
+    res->next = _buckets[bucket];
+    _buckets[bucket] = _idx(res);
+    _age_push(res);
+    /* the garbage collection before may have found nothing to time out */
+    _rbuf_gc_arm(now_usec);
 
     DEBUG("6lo rfrag: entry %p (%s, ", (void *)res,
           gnrc_netif_addr_to_str(l2addr_str, sizeof(l2addr_str), res->src,
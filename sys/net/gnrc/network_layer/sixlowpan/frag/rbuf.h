@@ -20,37 +20,52 @@
 #define RBUF_H
 
 #include <inttypes.h>
+#include <stdbool.h>
 
+#include "bitfield.h"
 #include "net/gnrc/netif/hdr.h"
 #include "net/gnrc/pkt.h"
 
 #include "net/gnrc/sixlowpan/frag.h"
-#ifdef __cplusplus
+#include "net/sixlowpan.h"
+#include "timex.h"
 
+#ifdef __cplusplus
 extern "C" {
 #endif
 
 #define RBUF_L2ADDR_MAX_LEN (8U)               /**< maximum length for link-layer addresses */
+
+#ifndef RBUF_SIZE
 #define RBUF_SIZE           (4U)               /**< size of the reassembly buffer */
+#endif
+
+#ifndef RBUF_TIMEOUT
 #define RBUF_TIMEOUT        (3U * US_PER_SEC) /**< timeout for reassembly in microseconds */
+#endif
 
+#ifndef RBUF_HASH_SIZE
 /**
- * @brief   Fragment intervals to identify limits of fragments.
+ * @brief   number of buckets of the hash table over the reassembly buffer
  *
- * @note    Fragments MUST NOT overlap and overlapping fragments are to be
- *          discarded
- *
- * @see <a href="https://tools.ietf.org/html/rfc4944#section-5.3">
- *          RFC 4944, section 5.3
- *      </a>
+ * @note    Must be a power of two.
+ */
+#if RBUF_SIZE > 64
+#define RBUF_HASH_SIZE      (64U)
+#elif RBUF_SIZE > 16
+#define RBUF_HASH_SIZE      (16U)
+#else
+#define RBUF_HASH_SIZE      (4U)
+#endif
+#endif
+
+/**
+ * @brief   number of 8-octet units in the largest possible datagram
  *
- * @internal
+ * Fragment offsets are given in units of 8 octets, so the reception of a
+ * datagram is tracked at this granularity.
  */
-typedef struct rbuf_int {
-    struct rbuf_int *next;  /**< next element in interval list */
-    uint16_t start;         /**< start byte of interval */
-    uint16_t end;           /**< end byte of interval */
-} rbuf_int_t;
+#define RBUF_UNITS          ((SIXLOWPAN_FRAG_MAX_LEN + 7) / 8)
 
 /**
  * @brief   An entry in the 6LoWPAN reassembly buffer.
@@ -71,14 +86,22 @@ typedef struct rbuf_int {
  * @internal
  */
 typedef struct {
-    rbuf_int_t *ints;                   /**< intervals of the fragment */
     gnrc_pktsnip_t *pkt;                /**< the reassembled packet in packet buffer */
     uint32_t arrival;                   /**< time in microseconds of arrival of
                                          *   last received fragment */
+    BITFIELD(received, RBUF_UNITS);     /**< 8-octet units of the datagram
+                                         *   received so far */
     uint8_t src[RBUF_L2ADDR_MAX_LEN];   /**< source address */
     uint8_t dst[RBUF_L2ADDR_MAX_LEN];   /**< destination address */
     uint8_t src_len;                    /**< length of source address */
     uint8_t dst_len;                    /**< length of destination address */
+    uint8_t bucket;                     /**< hash bucket of the entry */
+    uint8_t next;                       /**< next entry in hash bucket or free
+                                         *   list (index + 1) */
+    uint8_t older;                      /**< entry that received its last
+                                         *   fragment before this one (index + 1) */
+    uint8_t newer;                      /**< entry that received its last
+                                         *   fragment after this one (index + 1) */
     uint16_t tag;                       /**< the datagram's tag */
     uint16_t cur_size;                  /**< the datagram's current size */
 } rbuf_t;
@@ -100,6 +123,28 @@ typedef struct {
 void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *frag,
               size_t frag_size, size_t offset);
 
+/**
+ * @brief   Checks if the datagram of a fragment is in the reassembly buffer.
+ *
+ * @param[in] netif_hdr     The interface header of the fragment.
+ * @param[in] frag          The fragmentation header of the fragment.
+ *
+ * @return  true, if fragments of the datagram of @p frag were received before.
+ * @return  false, otherwise.
+ *
+ * @internal
+ */
+bool rbuf_has(gnrc_netif_hdr_t *netif_hdr, sixlowpan_frag_t *frag);
+
+/**
+ * @brief   Removes all entries from the reassembly buffer that timed out.
+ *
+ * Called on reception of @ref GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF.
+ *
+ * @internal
+ */
+void rbuf_gc(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,345 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "bitfield.h"
+#include "byteorder.h"
+#include "net/gnrc/ipv6/flowc.h"
+#include "net/gnrc/ipv6/nc.h"
+#include "net/gnrc/ipv6/netif.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan/frag.h"
+#include "net/gnrc/sixlowpan/iphc.h"
+#include "net/gnrc/sixlowpan/netif.h"
+#include "net/ipv6/hdr.h"
+#include "net/sixlowpan.h"
+#include "net/udp.h"
+#include "xtimer.h"
+
+#include "net/gnrc/sixlowpan/frag/vrb.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#define VRB_L2ADDR_MAX_LEN  (8U)    /**< maximum length for link-layer addresses */
+
+/**
+ * @brief   Number of possible fragment offsets in a datagram
+ *
+ * Fragment offsets are given in units of 8 octets.
+ */
+#define VRB_OFFSETS         ((SIXLOWPAN_FRAG_MAX_LEN + 7) / 8)
+
+/**
+ * @brief   Length of the inline traffic class and flow label by IPHC TF field
+ */
+static const uint8_t _iphc_tf_len[] = { 4, 3, 1, 0 };
+
+/**
+ * @brief   A datagram forwarded without reassembly
+ */
+typedef struct {
+    uint8_t src[VRB_L2ADDR_MAX_LEN];        /**< link-layer source of the datagram */
+    uint8_t out_dst[GNRC_IPV6_NC_L2_ADDR_MAX];  /**< link-layer address of the next hop */
+    uint32_t arrival;                       /**< time in microseconds of the
+                                             *   last fragment */
+    uint16_t datagram_size;                 /**< size of the datagram */
+    uint16_t tag;                           /**< tag of the datagram as received */
+    uint16_t out_tag;                       /**< tag of the datagram as forwarded */
+    uint16_t remaining;                     /**< bytes of the datagram not forwarded
+                                             *   yet */
+    BITFIELD(forwarded, VRB_OFFSETS);       /**< offsets of the fragments
+                                             *   forwarded so far */
+    kernel_pid_t out_iface;                 /**< interface to forward over;
+                                             *   KERNEL_PID_UNDEF if unused */
+    uint8_t src_len;                        /**< length of _vrb_entry_t::src */
+    uint8_t out_dst_len;                    /**< length of _vrb_entry_t::out_dst */
+} _vrb_entry_t;
+
+static _vrb_entry_t _vrb[GNRC_SIXLOWPAN_FRAG_VRB_SIZE];
+static gnrc_sixlowpan_frag_vrb_stats_t _stats;
+
+/* finds the entry of a datagram, drops timed out entries on the way and
+ * returns an unused (or the oldest) entry in *free */
+static _vrb_entry_t *_find(const uint8_t *src, size_t src_len,
+                           uint16_t datagram_size, uint16_t tag,
+                           _vrb_entry_t **free)
+{
+    uint32_t now = xtimer_now_usec();
+    _vrb_entry_t *res = NULL;
+
+    *free = NULL;
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
+        _vrb_entry_t *entry = &_vrb[i];
+
+        if ((entry->out_iface != KERNEL_PID_UNDEF) &&
+            ((now - entry->arrival) > GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT)) {
+            DEBUG("6lo vrb: entry %u timed out\n", i);
+            entry->out_iface = KERNEL_PID_UNDEF;
+        }
+        if (entry->out_iface == KERNEL_PID_UNDEF) {
+            if ((*free == NULL) || ((*free)->out_iface != KERNEL_PID_UNDEF)) {
+                *free = entry;
+            }
+        }
+        else if ((entry->datagram_size == datagram_size) &&
+                 (entry->tag == tag) && (entry->src_len == src_len) &&
+                 (memcmp(entry->src, src, src_len) == 0)) {
+            res = entry;
+        }
+        else if ((*free == NULL) ||
+                 (((*free)->out_iface != KERNEL_PID_UNDEF) &&
+                  ((int32_t)(entry->arrival - (*free)->arrival) < 0))) {
+            *free = entry;
+        }
+    }
+    return res;
+}
+
+/**
+ * @brief   Header information of a first fragment
+ */
+typedef struct {
+    ipv6_addr_t src;        /**< IPv6 source address */
+    ipv6_addr_t dst;        /**< IPv6 destination address */
+    uint16_t covered;       /**< uncompressed bytes of the datagram carried */
+    uint16_t hl_offset;     /**< position of the (inline) hop limit */
+    uint8_t hl;             /**< hop limit */
+    bool hl_inline;         /**< hop limit is carried inline */
+} _frag1_info_t;
+
+/* determines addresses and hop limit of a first fragment and the uncompressed
+ * number of bytes it carries. Returns false if the datagram can not be
+ * forwarded as is. */
+static bool _parse_1st(gnrc_pktsnip_t *pkt, uint16_t datagram_size,
+                       _frag1_info_t *info)
+{
+    uint8_t *data = ((uint8_t *)pkt->data) + sizeof(sixlowpan_frag_t);
+    size_t data_len = pkt->size - sizeof(sixlowpan_frag_t);
+
+    if (data[0] == SIXLOWPAN_UNCOMP) {
+        ipv6_hdr_t hdr;
+
+        if (data_len < (1 + sizeof(ipv6_hdr_t))) {
+            return false;
+        }
+        memcpy(&hdr, data + 1, sizeof(hdr));
+        memcpy(&info->src, &hdr.src, sizeof(ipv6_addr_t));
+        memcpy(&info->dst, &hdr.dst, sizeof(ipv6_addr_t));
+        info->covered = data_len - 1;
+        info->hl_offset = sizeof(sixlowpan_frag_t) + 1 + offsetof(ipv6_hdr_t, hl);
+        info->hl = hdr.hl;
+        info->hl_inline = true;
+        return true;
+    }
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC
+    else if (sixlowpan_iphc_is(data)) {
+        gnrc_pktsnip_t *tmp;
+        size_t iphc_len, nh_len = 0;
+
+        /* addresses derived from the link-layer addresses change on every hop */
+        if (((data[1] & SIXLOWPAN_IPHC2_SAM) == SIXLOWPAN_IPHC2_SAM) ||
+            (data[1] & SIXLOWPAN_IPHC2_M) ||
+            ((data[1] & SIXLOWPAN_IPHC2_DAM) == SIXLOWPAN_IPHC2_DAM)) {
+            DEBUG("6lo vrb: addresses derived from link-layer\n");
+            return false;
+        }
+        tmp = gnrc_pktbuf_add(NULL, NULL, sizeof(ipv6_hdr_t) + sizeof(udp_hdr_t),
+                              GNRC_NETTYPE_IPV6);
+        if (tmp == NULL) {
+            return false;
+        }
+        iphc_len = gnrc_sixlowpan_iphc_decode(&tmp, pkt, datagram_size,
+                                              sizeof(sixlowpan_frag_t), &nh_len);
+        if ((iphc_len == 0) || (iphc_len > data_len)) {
+            gnrc_pktbuf_release(tmp);
+            return false;
+        }
+        memcpy(&info->src, &((ipv6_hdr_t *)tmp->data)->src, sizeof(ipv6_addr_t));
+        memcpy(&info->dst, &((ipv6_hdr_t *)tmp->data)->dst, sizeof(ipv6_addr_t));
+        info->hl = ((ipv6_hdr_t *)tmp->data)->hl;
+        gnrc_pktbuf_release(tmp);
+        info->covered = data_len - iphc_len + sizeof(ipv6_hdr_t) + nh_len;
+        /* hop limit follows the IPHC header, the context identifier extension,
+         * the traffic class and flow label and the next header */
+        info->hl_offset = sizeof(sixlowpan_frag_t) + SIXLOWPAN_IPHC_HDR_LEN +
+                          ((data[1] & SIXLOWPAN_IPHC2_CID_EXT) ?
+                           SIXLOWPAN_IPHC_CID_EXT_LEN : 0) +
+                          _iphc_tf_len[(data[0] & SIXLOWPAN_IPHC1_TF) >> 3] +
+                          ((data[0] & SIXLOWPAN_IPHC1_NH) ? 0 : 1);
+        info->hl_inline = !(data[0] & SIXLOWPAN_IPHC1_HL);
+        return true;
+    }
+#else
+    (void)datagram_size;
+#endif
+    return false;
+}
+
+/* decrements the hop limit of a writable first fragment */
+static int _dec_hl(gnrc_pktsnip_t *pkt, const _frag1_info_t *info)
+{
+    uint8_t *hl;
+
+    if (!info->hl_inline) {
+        /* the decremented hop limit can not be compressed anymore */
+        if (gnrc_pktbuf_realloc_data(pkt, pkt->size + 1) != 0) {
+            return -1;
+        }
+        hl = ((uint8_t *)pkt->data) + info->hl_offset;
+        memmove(hl + 1, hl, pkt->size - info->hl_offset - 1);
+        ((uint8_t *)pkt->data)[sizeof(sixlowpan_frag_t)] &= ~SIXLOWPAN_IPHC1_HL;
+    }
+    hl = ((uint8_t *)pkt->data) + info->hl_offset;
+    *hl = info->hl - 1;
+    return 0;
+}
+
+/* looks up the next hop for the datagram of a first fragment. Returns the
+ * interface to forward over or KERNEL_PID_UNDEF if it is to be reassembled */
+static kernel_pid_t _next_hop(gnrc_pktsnip_t *pkt, uint16_t datagram_size,
+                              _frag1_info_t *info, uint8_t *l2addr,
+                              uint8_t *l2addr_len)
+{
+    gnrc_sixlowpan_netif_t *iface;
+    kernel_pid_t res;
+
+    if (!_parse_1st(pkt, datagram_size, info)) {
+        return KERNEL_PID_UNDEF;
+    }
+    /* link-local datagrams are not forwarded (see RFC 4291, section 2.5.6)
+     * and datagrams for this node are reassembled */
+    if ((info->hl <= 1) || ipv6_addr_is_link_local(&info->src) ||
+        ipv6_addr_is_link_local(&info->dst) ||
+        ipv6_addr_is_multicast(&info->dst) ||
+        (gnrc_ipv6_netif_find_by_addr(NULL, &info->dst) != KERNEL_PID_UNDEF)) {
+        return KERNEL_PID_UNDEF;
+    }
+    res = gnrc_ipv6_flowc_get(KERNEL_PID_UNDEF, &info->dst, l2addr, l2addr_len,
+                              NULL);
+    if ((res == KERNEL_PID_UNDEF) ||
+        ((iface = gnrc_sixlowpan_netif_get(res)) == NULL) ||
+        ((pkt->size + !info->hl_inline) > iface->max_frag_size)) {
+        DEBUG("6lo vrb: no 6LoWPAN next hop cached\n");
+        return KERNEL_PID_UNDEF;
+    }
+    return res;
+}
+
+bool gnrc_sixlowpan_frag_vrb_forward(gnrc_pktsnip_t *pkt, size_t offset)
+{
+    gnrc_netif_hdr_t *netif_hdr = pkt->next->data;
+    sixlowpan_frag_t *frag = pkt->data;
+    uint16_t datagram_size = byteorder_ntohs(frag->disp_size) &
+                             SIXLOWPAN_FRAG_SIZE_MASK;
+    uint16_t tag = byteorder_ntohs(frag->tag);
+    _vrb_entry_t *entry, *free;
+    gnrc_pktsnip_t *netif;
+
+    if (netif_hdr->src_l2addr_len > VRB_L2ADDR_MAX_LEN) {
+        return false;
+    }
+    entry = _find(gnrc_netif_hdr_get_src_addr(netif_hdr),
+                  netif_hdr->src_l2addr_len, datagram_size, tag, &free);
+    if (entry == NULL) {
+        _frag1_info_t info;
+        uint8_t out_dst[GNRC_IPV6_NC_L2_ADDR_MAX];
+        uint8_t out_dst_len = sizeof(out_dst);
+        kernel_pid_t out_iface;
+
+        if ((offset != 0) ||
+            ((out_iface = _next_hop(pkt, datagram_size, &info, out_dst,
+                                    &out_dst_len)) == KERNEL_PID_UNDEF) ||
+            ((pkt = gnrc_pktbuf_start_write(pkt)) == NULL)) {
+            return false;
+        }
+        if (_dec_hl(pkt, &info) < 0) {
+            DEBUG("6lo vrb: unable to decrement hop limit\n");
+            gnrc_pktbuf_release(pkt);
+            return true;
+        }
+        entry = free;
+        if (entry->out_iface != KERNEL_PID_UNDEF) {
+            DEBUG("6lo vrb: buffer full, remove oldest entry\n");
+            _stats.evictions++;
+        }
+        memcpy(entry->src, gnrc_netif_hdr_get_src_addr(netif_hdr),
+               netif_hdr->src_l2addr_len);
+        entry->src_len = netif_hdr->src_l2addr_len;
+        memcpy(entry->out_dst, out_dst, out_dst_len);
+        entry->out_dst_len = out_dst_len;
+        entry->datagram_size = datagram_size;
+        entry->tag = tag;
+        entry->out_tag = gnrc_sixlowpan_frag_next_tag();
+        entry->remaining = (info.covered < datagram_size) ?
+                           (datagram_size - info.covered) : 0;
+        memset(entry->forwarded, 0, sizeof(entry->forwarded));
+        bf_set(entry->forwarded, 0);
+        entry->out_iface = out_iface;
+        _stats.datagrams++;
+    }
+    else if (bf_isset(entry->forwarded, offset / 8)) {
+        /* a duplicate must not be counted again, or the entry would be
+         * removed before the last fragment of the datagram arrived */
+        DEBUG("6lo vrb: duplicate fragment (offset %u)\n", (unsigned)offset);
+        gnrc_pktbuf_release(pkt);
+        return true;
+    }
+    else {
+        size_t payload_len = pkt->size - sizeof(sixlowpan_frag_n_t);
+
+        if ((pkt = gnrc_pktbuf_start_write(pkt)) == NULL) {
+            return false;
+        }
+        bf_set(entry->forwarded, offset / 8);
+        entry->remaining = (payload_len < entry->remaining) ?
+                           (entry->remaining - payload_len) : 0;
+    }
+    entry->arrival = xtimer_now_usec();
+    frag = pkt->data;
+    frag->tag = byteorder_htons(entry->out_tag);
+
+    netif = gnrc_netif_hdr_build(NULL, 0, entry->out_dst, entry->out_dst_len);
+    if (netif == NULL) {
+        DEBUG("6lo vrb: error allocating interface header\n");
+        gnrc_pktbuf_release(pkt);
+        return true;
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = entry->out_iface;
+    gnrc_pktbuf_remove_snip(pkt, pkt->next);
+    netif->next = pkt;
+    DEBUG("6lo vrb: forward fragment (tag %u => %u, offset %u)\n",
+          (unsigned)tag, (unsigned)entry->out_tag, (unsigned)offset);
+    if (gnrc_netapi_send(entry->out_iface, netif) < 1) {
+        DEBUG("6lo vrb: unable to send fragment\n");
+        gnrc_pktbuf_release(netif);
+    }
+    _stats.fragments++;
+    if (entry->remaining == 0) {
+        entry->out_iface = KERNEL_PID_UNDEF;
+    }
+    return true;
+}
+
+const gnrc_sixlowpan_frag_vrb_stats_t *gnrc_sixlowpan_frag_vrb_get_stats(void)
+{
+    return &_stats;
+}
+
+/** @} */
@@ -12,6 +12,8 @@
  * @file
  */
 
+#include <stdbool.h>
+
 #include "kernel_types.h"
 #include "net/gnrc.h"
 #include "thread.h"
@@ -32,23 +34,53 @@
 #include <inttypes.h>
 #endif
 
-static kernel_pid_t _pid = KERNEL_PID_UNDEF;
-
 #ifdef MODULE_GNRC_SIXLOWPAN_FRAG
-static gnrc_sixlowpan_msg_frag_t fragment_msg = {KERNEL_PID_UNDEF, NULL, 0, 0};
+static gnrc_sixlowpan_msg_frag_t fragment_msg = {KERNEL_PID_UNDEF, NULL, 0, 0, 0};
 #endif
 
+/* handles GNRC_NETAPI_MSG_TYPE_RCV commands */
+static void _receive(gnrc_pktsnip_t *pkt);
+/* handles GNRC_NETAPI_MSG_TYPE_SND commands */
+static void _send(gnrc_pktsnip_t *pkt);
+
+#ifdef MODULE_GNRC_NETAPI_INLINE
+/* handles netapi commands in run-to-completion mode */
+static void _netapi_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx);
+
+static gnrc_netreg_entry_cbd_t _netapi_cbd = { _netapi_cb, NULL };
+static gnrc_netreg_entry_t _netapi_reg = GNRC_NETREG_ENTRY_INIT_CB(GNRC_NETREG_DEMUX_CTX_ALL,
+                                                                   &_netapi_cbd);
+static bool _registered = false;
+
+kernel_pid_t gnrc_sixlowpan_init(void)
+{
+    if (!_registered) {
+        /* register interest in all 6LoWPAN packets */
+        gnrc_netreg_register(GNRC_NETTYPE_SIXLOWPAN, &_netapi_reg);
+        _registered = true;
+    }
+    return KERNEL_PID_UNDEF;
+}
+
+static void _netapi_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    (void)ctx;
+    if (cmd == GNRC_NETAPI_MSG_TYPE_RCV) {
+        _receive(pkt);
+    }
+    else {
+        _send(pkt);
+    }
+}
+#else
+static kernel_pid_t _pid = KERNEL_PID_UNDEF;
+
 #if ENABLE_DEBUG
 static char _stack[GNRC_SIXLOWPAN_STACK_SIZE + THREAD_EXTRA_STACKSIZE_PRINTF];
 #else
 static char _stack[GNRC_SIXLOWPAN_STACK_SIZE];
 #endif
 
-
-/* handles GNRC_NETAPI_MSG_TYPE_RCV commands */
-static void _receive(gnrc_pktsnip_t *pkt);
-/* handles GNRC_NETAPI_MSG_TYPE_SND commands */
-static void _send(gnrc_pktsnip_t *pkt);
 /* Main event loop for 6LoWPAN */
 static void *_event_loop(void *args);
 
@@ -63,6 +95,7 @@ kernel_pid_t gnrc_sixlowpan_init(void)
 
     return _pid;
 }
+#endif
 
 static void _receive(gnrc_pktsnip_t *pkt)
 {
@@ -280,19 +313,13 @@ static void _send(gnrc_pktsnip_t *pkt)
     else if (datagram_size <= SIXLOWPAN_FRAG_MAX_LEN) {
         DEBUG("6lo: Send fragmented (%u > %" PRIu16 ")\n",
               (unsigned int)datagram_size, iface->max_frag_size);
-        msg_t msg;
-
         fragment_msg.pid = hdr->if_pid;
         fragment_msg.pkt = pkt2;
         fragment_msg.datagram_size = datagram_size;
         /* Sending the first fragment has an offset==0 */
         fragment_msg.offset = 0;
 
-        /* set the outgoing message's fields */
-        msg.type = GNRC_SIXLOWPAN_MSG_FRAG_SND;
-        msg.content.ptr = &fragment_msg;
-        /* send message to self */
-        msg_send_to_self(&msg);
+        gnrc_sixlowpan_frag_send(&fragment_msg);
     }
     else {
         DEBUG("6lo: packet too big (%u > %" PRIu16 ")\n",
@@ -307,6 +334,35 @@ static void _send(gnrc_pktsnip_t *pkt)
 #endif
 }
 
+#ifndef MODULE_GNRC_NETAPI_INLINE
+/* handles GNRC_NETAPI_MSG_TYPE_SET commands */
+static int _set(gnrc_netapi_opt_t *opt)
+{
+    kernel_pid_t iface = (kernel_pid_t)opt->context;
+    int res;
+
+    switch (opt->opt) {
+        case NETOPT_ADDRESS:
+        case NETOPT_ADDRESS_LONG:
+        case NETOPT_SRC_LEN:
+            break;
+        default:
+            DEBUG("6lo: unsupported option %d\n", (int)opt->opt);
+            return -ENOTSUP;
+    }
+    if (gnrc_sixlowpan_netif_get(iface) == NULL) {
+        DEBUG("6lo: %" PRIkernel_pid " is not a 6LoWPAN interface\n", iface);
+        return -ENOTSUP;
+    }
+    res = gnrc_netapi_set(iface, opt->opt, 0, opt->data, opt->data_len);
+    if (res >= 0) {
+        /* addresses are elided based on the link-layer address of the
+         * interface, so compressed headers might be stale now */
+        gnrc_sixlowpan_iphc_cache_invalidate();
+    }
+    return res;
+}
+
 static void *_event_loop(void *args)
 {
     msg_t msg, reply, msg_q[GNRC_SIXLOWPAN_MSG_QUEUE_SIZE];
@@ -338,9 +394,14 @@ static void *_event_loop(void *args)
                 _send(msg.content.ptr);
                 break;
 
-            case GNRC_NETAPI_MSG_TYPE_GET:
             case GNRC_NETAPI_MSG_TYPE_SET:
-                DEBUG("6lo: reply to unsupported get/set\n");
+                DEBUG("6lo: GNRC_NETAPI_MSG_TYPE_SET received\n");
+                reply.content.value = (uint32_t)_set(msg.content.ptr);
+                msg_reply(&msg, &reply);
+                break;
+
+            case GNRC_NETAPI_MSG_TYPE_GET:
+                DEBUG("6lo: reply to unsupported get\n");
                 reply.content.value = -ENOTSUP;
                 msg_reply(&msg, &reply);
                 break;
@@ -349,6 +410,11 @@ static void *_event_loop(void *args)
                 DEBUG("6lo: send fragmented event received\n");
                 gnrc_sixlowpan_frag_send(msg.content.ptr);
                 break;
+
+            case GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF:
+                DEBUG("6lo: garbage collect reassembly buffer event received\n");
+                gnrc_sixlowpan_frag_gc_rbuf();
+                break;
 #endif
 
             default:
@@ -359,5 +425,6 @@ static void *_event_loop(void *args)
 
     return NULL;
 }
+#endif
 
 /** @} */
@@ -17,8 +17,10 @@
  */
 
 #include <stdbool.h>
+#include <string.h>
 
 #include "byteorder.h"
+#include "mutex.h"
 #include "net/ieee802154.h"
 #include "net/ipv6/hdr.h"
 #include "net/gnrc.h"
@@ -27,6 +29,7 @@
 #include "utlist.h"
 #include "net/gnrc/nettype.h"
 #include "net/gnrc/udp.h"
+#include "xtimer.h"
 
 #include "net/gnrc/sixlowpan/iphc.h"
 
@@ -520,6 +523,20 @@ size_t gnrc_sixlowpan_iphc_decode(gnrc_pktsnip_t **dec_hdr, gnrc_pktsnip_t *pkt,
 }
 
 #ifdef MODULE_GNRC_SIXLOWPAN_IPHC_NHC
+static void _nhc_udp_shrink(gnrc_pktsnip_t *udp, size_t nhc_len)
+{
+    uint8_t *udp_data = udp->data;
+
+    /* In case payload is in this snip (e.g. a forwarded packet):
+     * move data to right place */
+    size_t diff = sizeof(udp_hdr_t) - nhc_len;
+    for (size_t i = nhc_len; i < (udp->size - diff); i++) {
+      udp_data[i] = udp_data[i + diff];
+    }
+    /* NOTE: gnrc_pktbuf_realloc_data overflow if (udp->size - diff) < 4 */
+    gnrc_pktbuf_realloc_data(udp, (udp->size - diff));
+}
+
 inline static size_t iphc_nhc_udp_encode(gnrc_pktsnip_t *udp, ipv6_hdr_t *ipv6_hdr)
 {
     udp_hdr_t *udp_hdr = udp->data;
@@ -568,36 +585,204 @@ inline static size_t iphc_nhc_udp_encode(gnrc_pktsnip_t *udp, ipv6_hdr_t *ipv6_h
     /* Set UDP header ID (rfc6282#section-5). */
     ipv6_hdr->nh |= NHC_UDP_ID;
 
-    /* In case payload is in this snip (e.g. a forwarded packet):
-     * move data to right place */
-    size_t diff = sizeof(udp_hdr_t) - nhc_len;
-    for (size_t i = nhc_len; i < (udp->size - diff); i++) {
-      udp_data[i] = udp_data[i + diff];
-    }
-    /* NOTE: gnrc_pktbuf_realloc_data overflow if (udp->size - diff) < 4 */
-    gnrc_pktbuf_realloc_data(udp, (udp->size - diff));
+    _nhc_udp_shrink(udp, nhc_len);
 
     return nhc_len;
 }
 #endif
 
-bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_CACHE
+#if (GNRC_SIXLOWPAN_IPHC_CACHE_SIZE & (GNRC_SIXLOWPAN_IPHC_CACHE_SIZE - 1))
+#error "GNRC_SIXLOWPAN_IPHC_CACHE_SIZE must be a power of two"
+#endif
+
+/* dispatch, CID extension, traffic class and flow label, next header, hop
+ * limit, both addresses inline and NHC dispatch */
+#define CACHE_IPHC_MAX_LEN          (SIXLOWPAN_IPHC_HDR_LEN + \
+                                     SIXLOWPAN_IPHC_CID_EXT_LEN + 4 + 1 + 1 + \
+                                     (2 * sizeof(ipv6_addr_t)) + 1)
+/* both ports and the checksum inline */
+#define CACHE_NHC_MAX_LEN           (sizeof(udp_hdr_t) - 2)
+
+typedef struct {
+    ipv6_addr_t src;
+    ipv6_addr_t dst;
+    uint32_t v_tc_fl;           /* version, traffic class and flow label */
+    network_uint16_t src_port;
+    network_uint16_t dst_port;
+    kernel_pid_t iface;         /* KERNEL_PID_UNDEF, if entry is free */
+    uint8_t nh;
+    uint8_t hl;
+    uint8_t src_l2addr_len;
+    uint8_t dst_l2addr_len;
+    uint8_t src_l2addr[GNRC_NETIF_HDR_L2ADDR_MAX_LEN];
+    uint8_t dst_l2addr[GNRC_NETIF_HDR_L2ADDR_MAX_LEN];
+} _cache_key_t;
+
+typedef struct {
+    _cache_key_t key;
+    uint32_t expires;
+    uint8_t iphc_len;
+    uint8_t nhc_len;            /* 0 if the next header is not compressed */
+    uint8_t iphc[CACHE_IPHC_MAX_LEN];
+    uint8_t nhc[CACHE_NHC_MAX_LEN];
+} _cache_entry_t;
+
+static _cache_entry_t _cache[GNRC_SIXLOWPAN_IPHC_CACHE_SIZE];
+static gnrc_sixlowpan_iphc_cache_stats_t _cache_stats;
+static mutex_t _cache_mutex = MUTEX_INIT;
+/* counts invalidations, so a packet compressed while the cache was
+ * invalidated is not added with stale link-layer information */
+static unsigned _cache_gen;
+
+static inline _cache_entry_t *_cache_slot(const _cache_key_t *key)
+{
+    uint32_t hash = key->dst.u32[3].u32 ^ key->src.u32[3].u32 ^
+                    ((uint32_t)key->src_port.u16 << 16) ^ key->dst_port.u16 ^
+                    (uint32_t)key->iface;
+
+    return &_cache[((hash * 2654435761U) >> 16) &
+                   (GNRC_SIXLOWPAN_IPHC_CACHE_SIZE - 1)];
+}
+
+/* leaves key->iface KERNEL_PID_UNDEF, if the packet can't be cached */
+static void _cache_key(_cache_key_t *key, gnrc_pktsnip_t *pkt)
 {
     gnrc_netif_hdr_t *netif_hdr = pkt->data;
     ipv6_hdr_t *ipv6_hdr = pkt->next->data;
-    uint8_t *iphc_hdr;
-    uint16_t inline_pos = SIXLOWPAN_IPHC_HDR_LEN;
-    bool addr_comp = false, nhc_comp = false;
-    gnrc_sixlowpan_ctx_t *src_ctx = NULL, *dst_ctx = NULL;
-    gnrc_pktsnip_t *dispatch = gnrc_pktbuf_add(NULL, NULL, pkt->next->size,
-                                               GNRC_NETTYPE_SIXLOWPAN);
 
-    if (dispatch == NULL) {
-        DEBUG("6lo iphc: error allocating dispatch space\n");
-        return false;
+    /* keys are compared as a whole, including padding */
+    memset(key, 0, sizeof(_cache_key_t));
+    if ((netif_hdr->src_l2addr_len > GNRC_NETIF_HDR_L2ADDR_MAX_LEN) ||
+        (netif_hdr->dst_l2addr_len > GNRC_NETIF_HDR_L2ADDR_MAX_LEN)) {
+        return;
+    }
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_NHC
+    if (ipv6_hdr->nh == PROTNUM_UDP) {
+        gnrc_pktsnip_t *udp = pkt->next->next;
+
+        if ((udp == NULL) || (udp->size < sizeof(udp_hdr_t))) {
+            return;
+        }
+        key->src_port = ((udp_hdr_t *)udp->data)->src_port;
+        key->dst_port = ((udp_hdr_t *)udp->data)->dst_port;
     }
+#endif
+    memcpy(&key->src, &ipv6_hdr->src, sizeof(ipv6_addr_t));
+    memcpy(&key->dst, &ipv6_hdr->dst, sizeof(ipv6_addr_t));
+    key->v_tc_fl = ipv6_hdr->v_tc_fl.u32;
+    key->nh = ipv6_hdr->nh;
+    key->hl = ipv6_hdr->hl;
+    key->src_l2addr_len = netif_hdr->src_l2addr_len;
+    key->dst_l2addr_len = netif_hdr->dst_l2addr_len;
+    memcpy(key->src_l2addr, gnrc_netif_hdr_get_src_addr(netif_hdr),
+           netif_hdr->src_l2addr_len);
+    memcpy(key->dst_l2addr, gnrc_netif_hdr_get_dst_addr(netif_hdr),
+           netif_hdr->dst_l2addr_len);
+    key->iface = netif_hdr->if_pid;
+}
 
-    iphc_hdr = dispatch->data;
+static uint16_t _cache_get(_cache_key_t *key, unsigned *gen,
+                           gnrc_pktsnip_t *pkt, uint8_t *iphc_hdr)
+{
+    _cache_entry_t *entry;
+    uint16_t iphc_len = 0;
+
+    _cache_key(key, pkt);
+    if (key->iface == KERNEL_PID_UNDEF) {
+        return 0;
+    }
+    entry = _cache_slot(key);
+    mutex_lock(&_cache_mutex);
+    *gen = _cache_gen;
+    if ((entry->key.iface != KERNEL_PID_UNDEF) &&
+        (memcmp(&entry->key, key, sizeof(_cache_key_t)) == 0)) {
+        if ((int32_t)(entry->expires - xtimer_now_usec()) > 0) {
+            iphc_len = entry->iphc_len;
+            memcpy(iphc_hdr, entry->iphc, iphc_len);
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_NHC
+            if (entry->nhc_len > 0) {
+                gnrc_pktsnip_t *udp = pkt->next->next;
+                uint8_t *udp_data = udp->data;
+                network_uint16_t checksum = ((udp_hdr_t *)udp_data)->checksum;
+
+                /* the checksum is the only field of the compressed UDP
+                 * header that changes within a flow, it is carried last */
+                memcpy(udp_data, entry->nhc, entry->nhc_len - 2);
+                udp_data[entry->nhc_len - 2] = checksum.u8[0];
+                udp_data[entry->nhc_len - 1] = checksum.u8[1];
+                _nhc_udp_shrink(udp, entry->nhc_len);
+            }
+#endif
+        }
+        else {
+            DEBUG("6lo iphc: cache entry expired\n");
+            entry->key.iface = KERNEL_PID_UNDEF;
+        }
+    }
+    if (iphc_len == 0) {
+        _cache_stats.misses++;
+    }
+    else {
+        _cache_stats.hits++;
+    }
+    mutex_unlock(&_cache_mutex);
+    return iphc_len;
+}
+
+static void _cache_add(const _cache_key_t *key, unsigned gen,
+                       const uint8_t *iphc_hdr, uint16_t iphc_len,
+                       gnrc_pktsnip_t *udp, size_t nhc_len)
+{
+    _cache_entry_t *entry = _cache_slot(key);
+
+    if ((key->iface == KERNEL_PID_UNDEF) || (iphc_len > CACHE_IPHC_MAX_LEN) ||
+        (nhc_len > CACHE_NHC_MAX_LEN)) {
+        return;
+    }
+    mutex_lock(&_cache_mutex);
+    if (gen != _cache_gen) {
+        DEBUG("6lo iphc: cache invalidated during compression\n");
+        mutex_unlock(&_cache_mutex);
+        return;
+    }
+    memcpy(&entry->key, key, sizeof(_cache_key_t));
+    memcpy(entry->iphc, iphc_hdr, iphc_len);
+    entry->iphc_len = iphc_len;
+    if (nhc_len > 0) {
+        /* the compressed UDP header is now in front of the UDP snip */
+        memcpy(entry->nhc, udp->data, nhc_len);
+    }
+    entry->nhc_len = nhc_len;
+    entry->expires = xtimer_now_usec() + GNRC_SIXLOWPAN_IPHC_CACHE_LIFETIME;
+    mutex_unlock(&_cache_mutex);
+}
+
+void gnrc_sixlowpan_iphc_cache_invalidate(void)
+{
+    mutex_lock(&_cache_mutex);
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_IPHC_CACHE_SIZE; i++) {
+        _cache[i].key.iface = KERNEL_PID_UNDEF;
+    }
+    _cache_gen++;
+    _cache_stats.invalidations++;
+    mutex_unlock(&_cache_mutex);
+}
+
+const gnrc_sixlowpan_iphc_cache_stats_t *gnrc_sixlowpan_iphc_cache_get_stats(void)
+{
+    return &_cache_stats;
+}
+#endif
+
+static uint16_t _iphc_encode(gnrc_pktsnip_t *pkt, uint8_t *iphc_hdr,
+                             size_t *nhc_len)
+{
+    gnrc_netif_hdr_t *netif_hdr = pkt->data;
+    ipv6_hdr_t *ipv6_hdr = pkt->next->data;
+    uint16_t inline_pos = SIXLOWPAN_IPHC_HDR_LEN;
+    bool addr_comp = false, nhc_comp = false;
+    gnrc_sixlowpan_ctx_t *src_ctx = NULL, *dst_ctx = NULL;
 
     /* set initial dispatch value*/
     iphc_hdr[IPHC1_IDX] = SIXLOWPAN_IPHC1_DISP;
@@ -671,7 +856,7 @@ bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
     switch (ipv6_hdr->nh) {
 #ifdef MODULE_GNRC_SIXLOWPAN_IPHC_NHC
         case PROTNUM_UDP:
-            iphc_nhc_udp_encode(pkt->next->next, ipv6_hdr);
+            *nhc_len = iphc_nhc_udp_encode(pkt->next->next, ipv6_hdr);
             iphc_hdr[IPHC1_IDX] |= SIXLOWPAN_IPHC1_NH;
             nhc_comp = true;
             break;
@@ -881,6 +1066,35 @@ bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
         iphc_hdr[inline_pos++] = ipv6_hdr->nh;
     }
 
+    return inline_pos;
+}
+
+bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
+{
+    uint16_t inline_pos;
+    size_t nhc_len = 0;
+    gnrc_pktsnip_t *dispatch = gnrc_pktbuf_add(NULL, NULL, pkt->next->size,
+                                               GNRC_NETTYPE_SIXLOWPAN);
+
+    if (dispatch == NULL) {
+        DEBUG("6lo iphc: error allocating dispatch space\n");
+        return false;
+    }
+
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_CACHE
+    _cache_key_t key;
+    unsigned gen = 0;
+
+    /* the key is taken from the headers before they are compressed */
+    if ((inline_pos = _cache_get(&key, &gen, pkt, dispatch->data)) == 0) {
+        inline_pos = _iphc_encode(pkt, dispatch->data, &nhc_len);
+        _cache_add(&key, gen, dispatch->data, inline_pos, pkt->next->next,
+                   nhc_len);
+    }
+#else
+    inline_pos = _iphc_encode(pkt, dispatch->data, &nhc_len);
+#endif
+
     /* shrink dispatch allocation to final size */
     /* NOTE: Since this only shrinks the data nothing bad SHOULD happen ;-) */
     gnrc_pktbuf_realloc_data(dispatch, (size_t)inline_pos);
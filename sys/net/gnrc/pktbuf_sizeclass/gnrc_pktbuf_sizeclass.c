@@ -0,0 +1,774 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup net_gnrc_pktbuf
+ * @{
+ *
+ * @file
+ * @brief   Packet buffer backend using segregated size-class free lists
+ *
+ * Free regions of the static packet buffer are kept in doubly linked lists,
+ * one per size class. There are four classes per power of two, so looking
+ * up a fitting free block boils down to a bitmap search. Each free region
+ * stores its size at its start and its end and a bitmap marks the first
+ * and the last word of each free region, so adjacent free regions are
+ * merged on release without walking any list. List links are 16-bit offsets
+ * into the buffer to keep the minimum block size at 8 byte.
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+#include <sys/types.h>
+
+#include "bitarithm.h"
+#include "mutex.h"
+#include "utlist.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/nettype.h"
+#include "net/gnrc/pkt.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define _GRANULE            (sizeof(void *))
+#define _ALIGNMENT_MASK     (_GRANULE - 1)
+
+/**
+ * @brief   Usable size of the packet buffer (multiple of @ref _GRANULE)
+ */
+#define _POOL_SIZE          (GNRC_PKTBUF_SIZE & ~(_ALIGNMENT_MASK))
+
+/**
+ * @brief   log2 of the number of size classes per power of two
+ */
+#define _SL_LOG2            (2U)
+
+/**
+ * @brief   Number of size classes
+ *
+ * The last class is unbounded and takes all blocks that are too large for
+ * the others.
+ */
+#define _CLASS_NUMOF        (32U)
+
+/**
+ * @brief   Marks the end of a size class list
+ */
+#define _NIL                (0xffffU)
+
+#if GNRC_PKTBUF_SIZE >= 0xffff
+#error "gnrc_pktbuf_sizeclass: GNRC_PKTBUF_SIZE must be smaller than 65535"
+#endif
+
+/**
+ * @brief   A free block in one of the size class lists
+ *
+ * @note    @p size must be the first member: free regions too small to hold
+ *          this structure (slivers) only store their size.
+ */
+typedef struct {
+    uint16_t size;      /**< size of the block in byte */
+    uint16_t next;      /**< offset of next block in the class or _NIL */
+    uint16_t prev;      /**< offset of previous block in the class or _NIL */
+} _free_block_t;
+
+/**
+ * @brief   A snip created by gnrc_pktbuf_add_ext()
+ */
+typedef struct {
+    gnrc_pktsnip_t pkt;         /**< the snip, must be the first member */
+    gnrc_pktbuf_ext_cb_t cb;    /**< release callback */
+    void *arg;                  /**< argument for cb */
+} _ext_snip_t;
+
+/**
+ * @brief   Minimum size of an allocation (free block + size at its end)
+ */
+#define _MIN_SIZE           ((sizeof(_free_block_t) + sizeof(uint16_t) + \
+                              _ALIGNMENT_MASK) & ~(_ALIGNMENT_MASK))
+
+static mutex_t _mutex = MUTEX_INIT;
+static uint8_t _pktbuf[GNRC_PKTBUF_SIZE] __attribute__((aligned(sizeof(void *))));
+/* first and last word of every free region */
+static uint8_t _edges[((_POOL_SIZE / _GRANULE) + 7) / 8];
+static uint16_t _classes[_CLASS_NUMOF];
+static uint32_t _class_map;
+static unsigned _fl_min;
+
+/* statistics */
+static size_t _used;
+static size_t _max_used;
+static unsigned _failed;
+static uint32_t _moved;     /* bytes moved by gnrc_pktbuf_mark/realloc_data() */
+static uint32_t _ext;       /* bytes referenced by gnrc_pktbuf_add_ext() */
+
+/* internal gnrc_pktbuf functions */
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, void *data, size_t size,
+                                    gnrc_nettype_t type);
+static void *_pktbuf_alloc(size_t size);
+static void _pktbuf_free(void *data, size_t size);
+static void _region_add(uint8_t *region, uint16_t size);
+
+static inline bool _pktbuf_contains(void *ptr)
+{
+    return (unsigned)((uint8_t *)ptr - _pktbuf) < _POOL_SIZE;
+}
+
+static inline bool _is_ext(const gnrc_pktsnip_t *pkt)
+{
+    return (pkt->data != NULL) && !_pktbuf_contains(pkt->data);
+}
+
+/* fits size to byte alignment */
+static inline size_t _align(size_t size)
+{
+    return (size + _ALIGNMENT_MASK) & ~(_ALIGNMENT_MASK);
+}
+
+static inline void _set_pktsnip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *next,
+                                void *data, size_t size, gnrc_nettype_t type)
+{
+    pkt->next = next;
+    pkt->data = data;
+    pkt->size = size;
+    pkt->type = type;
+    pkt->users = 1;
+#ifdef MODULE_GNRC_NETERR
+    pkt->err_sub = KERNEL_PID_UNDEF;
+#endif
+}
+
+void gnrc_pktbuf_init(void)
+{
+    mutex_lock(&_mutex);
+    memset(_edges, 0, sizeof(_edges));
+    memset(_classes, 0xff, sizeof(_classes));
+    _class_map = 0;
+    _fl_min = bitarithm_msb(_MIN_SIZE);
+    _used = 0;
+    _max_used = 0;
+    _failed = 0;
+    _moved = 0;
+    _ext = 0;
+    _region_add(_pktbuf, _POOL_SIZE);
+    mutex_unlock(&_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, void *data, size_t size,
+                                gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt;
+
+    if (size > GNRC_PKTBUF_SIZE) {
+        DEBUG("pktbuf: size (%u) > GNRC_PKTBUF_SIZE (%u)\n",
+              (unsigned)size, GNRC_PKTBUF_SIZE);
+        return NULL;
+    }
+    mutex_lock(&_mutex);
+    pkt = _create_snip(next, data, size, type);
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_add_ext(gnrc_pktsnip_t *next, const void *data,
+                                    size_t size, gnrc_nettype_t type,
+                                    gnrc_pktbuf_ext_cb_t cb, void *arg)
+{
+    _ext_snip_t *ext;
+
+    assert((data != NULL) && (size > 0));
+    mutex_lock(&_mutex);
+    ext = _pktbuf_alloc(sizeof(_ext_snip_t));
+    if (ext == NULL) {
+        DEBUG("pktbuf: error allocating new packet snip\n");
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    _set_pktsnip(&ext->pkt, next, (void *)data, size, type);
+    ext->cb = cb;
+    ext->arg = arg;
+    _ext += size;
+    mutex_unlock(&_mutex);
+    return &ext->pkt;
+}
+
+bool gnrc_pktbuf_is_ext(const gnrc_pktsnip_t *pkt)
+{
+    return _is_ext(pkt);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *marked_snip;
+    /* size required for chunk */
+    size_t required_new_size = (size < _MIN_SIZE) ? _MIN_SIZE : _align(size);
+    void *new_data_marked;
+
+    mutex_lock(&_mutex);
+    if ((size == 0) || (pkt == NULL) || (size > pkt->size) || (pkt->data == NULL)) {
+        DEBUG("pktbuf: size == 0 (was %u) or pkt == NULL (was %p) or "
+              "size > pkt->size (was %u) or pkt->data == NULL (was %p)\n",
+              (unsigned)size, (void *)pkt, (pkt ? (unsigned)pkt->size : 0),
+              (pkt ? pkt->data : NULL));
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    if (_is_ext(pkt)) {
+        DEBUG("pktbuf: can not mark data outside of packet buffer\n");
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    /* create new snip descriptor for marked data */
+    marked_snip = _pktbuf_alloc(sizeof(gnrc_pktsnip_t));
+    if (marked_snip == NULL) {
+        DEBUG("pktbuf: could not reallocate marked section.\n");
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    /* marked data could not be released on its own => move data around */
+    if ((pkt->size != size) &&
+        ((size < required_new_size) || ((pkt->size - size) < _MIN_SIZE))) {
+        void *new_data_rest;
+        new_data_marked = _pktbuf_alloc(size);
+        if (new_data_marked == NULL) {
+            DEBUG("pktbuf: could not reallocate marked section.\n");
+            _pktbuf_free(marked_snip, sizeof(gnrc_pktsnip_t));
+            mutex_unlock(&_mutex);
+            return NULL;
+        }
+        new_data_rest = _pktbuf_alloc(pkt->size - size);
+        if (new_data_rest == NULL) {
+            DEBUG("pktbuf: could not reallocate remaining section.\n");
+            _pktbuf_free(marked_snip, sizeof(gnrc_pktsnip_t));
+            _pktbuf_free(new_data_marked, size);
+            mutex_unlock(&_mutex);
+            return NULL;
+        }
+        memcpy(new_data_marked, pkt->data, size);
+        memcpy(new_data_rest, ((uint8_t *)pkt->data) + size, pkt->size - size);
+        _moved += pkt->size;
+        _pktbuf_free(pkt->data, pkt->size);
+        marked_snip->data = new_data_marked;
+        pkt->data = new_data_rest;
+    }
+    else {
+        new_data_marked = pkt->data;
+        /* if (pkt->size - size) != 0 take remainder of data, otherwise set NULL */
+        pkt->data = (pkt->size != size) ? (((uint8_t *)pkt->data) + size) :
+                                          NULL;
+    }
+    pkt->size -= size;
+    _set_pktsnip(marked_snip, pkt->next, new_data_marked, size, type);
+    pkt->next = marked_snip;
+    mutex_unlock(&_mutex);
+    return marked_snip;
+}
+
+int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
+{
+    size_t aligned_size = (size < _MIN_SIZE) ? _MIN_SIZE : _align(size);
+
+    mutex_lock(&_mutex);
+    assert(pkt != NULL);
+    assert(((pkt->size == 0) && (pkt->data == NULL)) ||
+           ((pkt->size > 0) && (pkt->data != NULL) && _pktbuf_contains(pkt->data)));
+    /* new size and old size are equal */
+    if (size == pkt->size) {
+        /* nothing to do */
+        mutex_unlock(&_mutex);
+        return 0;
+    }
+    /* new size is 0 and data pointer isn't already NULL */
+    if ((size == 0) && (pkt->data != NULL)) {
+        /* set data pointer to NULL */
+        _pktbuf_free(pkt->data, pkt->size);
+        pkt->data = NULL;
+    }
+    /* if new size is bigger than old size */
+    else if ((size > pkt->size) ||                      /* new size does not fit */
+             ((pkt->size - aligned_size) < _MIN_SIZE)) { /* remainder could not be released */
+        void *new_data = _pktbuf_alloc(size);
+        if (new_data == NULL) {
+            DEBUG("pktbuf: error allocating new data section\n");
+            mutex_unlock(&_mutex);
+            return ENOMEM;
+        }
+        if (pkt->data != NULL) {            /* if old data exist */
+            memcpy(new_data, pkt->data, (pkt->size < size) ? pkt->size : size);
+            _moved += (pkt->size < size) ? pkt->size : size;
+        }
+        _pktbuf_free(pkt->data, pkt->size);
+        pkt->data = new_data;
+    }
+    else if (_align(pkt->size) > aligned_size) {
+        _pktbuf_free(((uint8_t *)pkt->data) + aligned_size,
+                     pkt->size - aligned_size);
+    }
+    pkt->size = size;
+    mutex_unlock(&_mutex);
+    return 0;
+}
+
+void gnrc_pktbuf_hold(gnrc_pktsnip_t *pkt, unsigned int num)
+{
+    mutex_lock(&_mutex);
+    while (pkt) {
+        pkt->users += num;
+        pkt = pkt->next;
+    }
+    mutex_unlock(&_mutex);
+}
+
+/* frees pkt and its data, but not pkt->next */
+static void _free_snip(gnrc_pktsnip_t *pkt)
+{
+    if (_is_ext(pkt)) {
+        _ext_snip_t *ext = (_ext_snip_t *)pkt;
+
+        if (ext->cb != NULL) {
+            ext->cb(ext->arg, pkt->data, pkt->size);
+        }
+        _pktbuf_free(pkt, sizeof(_ext_snip_t));
+        return;
+    }
+    _pktbuf_free(pkt->data, pkt->size);
+    _pktbuf_free(pkt, sizeof(gnrc_pktsnip_t));
+}
+
+static void _release_error_locked(gnrc_pktsnip_t *pkt, uint32_t err)
+{
+    while (pkt) {
+        gnrc_pktsnip_t *tmp;
+        assert(_pktbuf_contains(pkt));
+        tmp = pkt->next;
+        if (pkt->users == 1) {
+            pkt->users = 0; /* not necessary but to be on the safe side */
+            _free_snip(pkt);
+        }
+        else {
+            pkt->users--;
+        }
+        DEBUG("pktbuf: report status code %" PRIu32 "\n", err);
+        gnrc_neterr_report(pkt, err);
+        pkt = tmp;
+    }
+}
+
+void gnrc_pktbuf_release_error(gnrc_pktsnip_t *pkt, uint32_t err)
+{
+    mutex_lock(&_mutex);
+    _release_error_locked(pkt, err);
+    mutex_unlock(&_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
+{
+    mutex_lock(&_mutex);
+    if ((pkt == NULL) || (pkt->size == 0)) {
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    if ((pkt->users > 1) || _is_ext(pkt)) {
+        gnrc_pktsnip_t *new;
+        new = _create_snip(pkt->next, pkt->data, pkt->size, pkt->type);
+        if ((new != NULL) && (--pkt->users == 0)) {
+            /* was the only user of the snip referencing external data */
+            _free_snip(pkt);
+        }
+        mutex_unlock(&_mutex);
+        return new;
+    }
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_duplicate_upto(gnrc_pktsnip_t *pkt, gnrc_nettype_t type)
+{
+    mutex_lock(&_mutex);
+
+    bool is_shared = pkt->users > 1;
+    size_t size = gnrc_pkt_len_upto(pkt, type);
+
+    DEBUG("ipv6_ext: duplicating %d octets\n", (int) size);
+
+    gnrc_pktsnip_t *tmp;
+    gnrc_pktsnip_t *target = gnrc_pktsnip_search_type(pkt, type);
+    gnrc_pktsnip_t *next = (target == NULL) ? NULL : target->next;
+    gnrc_pktsnip_t *new = _create_snip(next, NULL, size, type);
+
+    if (new == NULL) {
+        mutex_unlock(&_mutex);
+
+        return NULL;
+    }
+
+    /* copy payloads */
+    for (tmp = pkt; tmp != NULL; tmp = tmp->next) {
+        uint8_t *dest = ((uint8_t *)new->data) + (size - tmp->size);
+
+        memcpy(dest, tmp->data, tmp->size);
+
+        size -= tmp->size;
+
+        if (tmp->type == type) {
+            break;
+        }
+    }
+
+    /* decrements reference counters */
+
+    if (target != NULL) {
+        target->next = NULL;
+    }
+
+    _release_error_locked(pkt, GNRC_NETERR_SUCCESS);
+
+    if (is_shared && (target != NULL)) {
+        target->next = next;
+    }
+
+    mutex_unlock(&_mutex);
+
+    return new;
+}
+
+/* bitmap of region edges, indexed by word */
+static inline unsigned _word(const uint8_t *ptr)
+{
+    return (unsigned)(ptr - _pktbuf) / _GRANULE;
+}
+
+static inline bool _is_edge(const uint8_t *ptr)
+{
+    unsigned word = _word(ptr);
+    return _edges[word / 8] & (1 << (word % 8));
+}
+
+static inline void _edge_set(const uint8_t *ptr)
+{
+    unsigned word = _word(ptr);
+    _edges[word / 8] |= (1 << (word % 8));
+}
+
+static inline void _edge_clear(const uint8_t *ptr)
+{
+    unsigned word = _word(ptr);
+    _edges[word / 8] &= ~(1 << (word % 8));
+}
+
+/* size class of blocks with size in [lower bound of class, next class) */
+static unsigned _class(size_t size)
+{
+    unsigned fl = bitarithm_msb(size);
+    unsigned cls = ((fl - _fl_min) << _SL_LOG2) |
+                   ((size >> (fl - _SL_LOG2)) & ((1 << _SL_LOG2) - 1));
+
+    return (cls < _CLASS_NUMOF) ? cls : (_CLASS_NUMOF - 1);
+}
+
+/* smallest size class of which every block is at least size bytes long */
+static unsigned _class_fitting(size_t size)
+{
+    unsigned fl = bitarithm_msb(size);
+
+    return _class(size + (1 << (fl - _SL_LOG2)) - 1);
+}
+
+static unsigned _class_first(uint32_t map)
+{
+    /* bitarithm_lsb() takes an unsigned int which might only be 16 bit wide */
+    uint16_t low = (uint16_t)map;
+
+    return (low) ? bitarithm_lsb(low) : (16 + bitarithm_lsb(map >> 16));
+}
+
+static inline _free_block_t *_block(uint16_t offset)
+{
+    return (_free_block_t *)&_pktbuf[offset];
+}
+
+static inline uint16_t _region_size(const uint8_t *region)
+{
+    uint16_t size;
+
+    memcpy(&size, region, sizeof(size));
+    return size;
+}
+
+/* turn [region, region + size) into a free region */
+static void _region_add(uint8_t *region, uint16_t size)
+{
+    memcpy(region, &size, sizeof(size));
+    memcpy(region + size - sizeof(size), &size, sizeof(size));
+    _edge_set(region);
+    _edge_set(region + size - _GRANULE);
+    if (size >= _MIN_SIZE) {
+        _free_block_t *block = (_free_block_t *)region;
+        uint16_t offset = region - _pktbuf;
+        unsigned cls = _class(size);
+
+        block->prev = _NIL;
+        block->next = _classes[cls];
+        if (block->next != _NIL) {
+            _block(block->next)->prev = offset;
+        }
+        _classes[cls] = offset;
+        _class_map |= ((uint32_t)1 << cls);
+    }
+    /* else: a sliver that is only reclaimed when a neighbour is released */
+}
+
+static void _region_remove(uint8_t *region, uint16_t size)
+{
+    _edge_clear(region);
+    _edge_clear(region + size - _GRANULE);
+    if (size >= _MIN_SIZE) {
+        _free_block_t *block = (_free_block_t *)region;
+        unsigned cls = _class(size);
+
+        if (block->prev != _NIL) {
+            _block(block->prev)->next = block->next;
+        }
+        else {
+            _classes[cls] = block->next;
+            if (block->next == _NIL) {
+                _class_map &= ~((uint32_t)1 << cls);
+            }
+        }
+        if (block->next != _NIL) {
+            _block(block->next)->prev = block->prev;
+        }
+    }
+}
+
+/* first block in size class cls that is at least size bytes long */
+static _free_block_t *_find_in(unsigned cls, size_t size)
+{
+    for (uint16_t offset = _classes[cls]; offset != _NIL;
+         offset = _block(offset)->next) {
+        if (_block(offset)->size >= size) {
+            return _block(offset);
+        }
+    }
+    return NULL;
+}
+
+static _free_block_t *_find(size_t size)
+{
+    unsigned cls = _class_fitting(size);
+    uint32_t map = _class_map & (UINT32_MAX << cls);
+    _free_block_t *block;
+
+    if (map && (cls < (_CLASS_NUMOF - 1))) {
+        return _block(_classes[_class_first(map)]);
+    }
+    /* no class that is guaranteed to fit has a block left (or size only fits
+     * the unbounded class): blocks in the class of size itself and in the
+     * unbounded class might still be large enough */
+    cls = _class(size);
+    block = _find_in(cls, size);
+    if ((block == NULL) && (cls < (_CLASS_NUMOF - 1))) {
+        block = _find_in(_CLASS_NUMOF - 1, size);
+    }
+    return block;
+}
+
+#ifdef DEVELHELP
+static size_t _largest_free(unsigned *blocks, size_t *listed)
+{
+    size_t largest = 0;
+
+    *blocks = 0;
+    *listed = 0;
+    for (unsigned cls = 0; cls < _CLASS_NUMOF; cls++) {
+        for (uint16_t offset = _classes[cls]; offset != _NIL;
+             offset = _block(offset)->next) {
+            _free_block_t *block = _block(offset);
+
+            (*blocks)++;
+            *listed += block->size;
+            if (block->size > largest) {
+                largest = block->size;
+            }
+        }
+    }
+    return largest;
+}
+
+void gnrc_pktbuf_stats(void)
+{
+    unsigned blocks;
+    size_t listed, largest;
+    size_t free_bytes;
+
+    mutex_lock(&_mutex);
+    largest = _largest_free(&blocks, &listed);
+    free_bytes = _POOL_SIZE - _used;
+    printf("packet buffer: first byte: %p, last byte: %p (size: %u)\n",
+           (void *)&_pktbuf[0], (void *)&_pktbuf[_POOL_SIZE], (unsigned)_POOL_SIZE);
+    printf("  used: %u bytes (max. %u), failed allocations: %u\n",
+           (unsigned)_used, (unsigned)_max_used, _failed);
+    printf("  bytes moved by mark/realloc: %" PRIu32 "\n", _moved);
+    printf("  bytes referenced by add_ext: %" PRIu32 "\n", _ext);
+    printf("  free: %u bytes in %u blocks, %u bytes in slivers\n",
+           (unsigned)listed, blocks, (unsigned)(free_bytes - listed));
+    printf("  largest free block: %u bytes, fragmentation: %u%%\n",
+           (unsigned)largest,
+           (free_bytes) ? (unsigned)(100 - ((largest * 100) / free_bytes)) : 0);
+    for (unsigned cls = 0; cls < _CLASS_NUMOF; cls++) {
+        unsigned num = 0;
+
+        for (uint16_t offset = _classes[cls]; offset != _NIL;
+             offset = _block(offset)->next) {
+            num++;
+        }
+        if (num > 0) {
+            unsigned fl = _fl_min + (cls >> _SL_LOG2);
+            unsigned lower = (1 << fl) +
+                             ((cls & ((1 << _SL_LOG2) - 1)) << (fl - _SL_LOG2));
+            printf("  class %2u (>= %4u bytes): %u blocks\n", cls, lower, num);
+        }
+    }
+    mutex_unlock(&_mutex);
+}
+#endif
+
+#ifdef TEST_SUITES
+bool gnrc_pktbuf_is_empty(void)
+{
+    _free_block_t *block = (_free_block_t *)_pktbuf;
+
+    return _is_edge(_pktbuf) && (block->size == _POOL_SIZE);
+}
+
+bool gnrc_pktbuf_is_sane(void)
+{
+    /* Invariants of this implementation:
+     *  - forall blocks in class list c: block is in _pktbuf, word aligned
+     *    and c == _class(block->size)
+     *  - forall blocks: block->size is stored at the end of the block as well
+     *    and the edges of the block are marked in _edges
+     *  - forall blocks: block->next == _NIL || block->next->prev == block
+     *  - forall blocks: the regions directly adjacent to block are not free
+     *  - bit c of _class_map is set iff class list c is not empty
+     */
+    for (unsigned cls = 0; cls < _CLASS_NUMOF; cls++) {
+        if ((_classes[cls] == _NIL) == ((_class_map & ((uint32_t)1 << cls)) != 0)) {
+            return false;
+        }
+        for (uint16_t offset = _classes[cls]; offset != _NIL;
+             offset = _block(offset)->next) {
+            _free_block_t *block = _block(offset);
+            uint8_t *start = (uint8_t *)block;
+            uint8_t *end = start + block->size;
+
+            if (!_pktbuf_contains(start) || ((start - _pktbuf) & _ALIGNMENT_MASK) ||
+                (end > &_pktbuf[_POOL_SIZE]) || (_class(block->size) != cls)) {
+                return false;
+            }
+            if ((_region_size(end - sizeof(uint16_t)) != block->size) ||
+                !_is_edge(start) || !_is_edge(end - _GRANULE)) {
+                return false;
+            }
+            if ((block->next != _NIL) && (_block(block->next)->prev != offset)) {
+                return false;
+            }
+            if (((start > _pktbuf) && _is_edge(start - _GRANULE)) ||
+                ((end < &_pktbuf[_POOL_SIZE]) && _is_edge(end))) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+#endif
+
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, void *data, size_t size,
+                                    gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt = _pktbuf_alloc(sizeof(gnrc_pktsnip_t));
+    void *_data = NULL;
+
+    if (pkt == NULL) {
+        DEBUG("pktbuf: error allocating new packet snip\n");
+        return NULL;
+    }
+    if (size > 0) {
+        _data = _pktbuf_alloc(size);
+        if (_data == NULL) {
+            DEBUG("pktbuf: error allocating data for new packet snip\n");
+            _pktbuf_free(pkt, sizeof(gnrc_pktsnip_t));
+            return NULL;
+        }
+    }
+    _set_pktsnip(pkt, next, _data, size, type);
+    if (data != NULL) {
+        memcpy(_data, data, size);
+    }
+    return pkt;
+}
+
+static void *_pktbuf_alloc(size_t size)
+{
+    _free_block_t *block;
+    uint16_t block_size;
+
+    size = (size < _MIN_SIZE) ? _MIN_SIZE : _align(size);
+    if ((size > _POOL_SIZE) || ((block = _find(size)) == NULL)) {
+        DEBUG("pktbuf: no space left in packet buffer\n");
+        _failed++;
+        return NULL;
+    }
+    block_size = block->size;
+    _region_remove((uint8_t *)block, block_size);
+    if (block_size > size) {
+        _region_add(((uint8_t *)block) + size, block_size - size);
+    }
+    _used += size;
+    if (_used > _max_used) {
+        _max_used = _used;
+    }
+    return block;
+}
+
+static void _pktbuf_free(void *data, size_t size)
+{
+    uint8_t *start = data, *end;
+
+    if (!_pktbuf_contains(data)) {
+        return;
+    }
+    size = (size < _MIN_SIZE) ? _MIN_SIZE : _align(size);
+    _used -= size;
+    end = start + size;
+    /* merge with free region after the released one */
+    if ((end < &_pktbuf[_POOL_SIZE]) && _is_edge(end)) {
+        uint16_t next_size = _region_size(end);
+
+        _region_remove(end, next_size);
+        end += next_size;
+    }
+    /* merge with free region before the released one */
+    if ((start > _pktbuf) && _is_edge(start - _GRANULE)) {
+        uint16_t prev_size = _region_size(start - sizeof(uint16_t));
+
+        start -= prev_size;
+        _region_remove(start, prev_size);
+    }
+    _region_add(start, end - start);
+}
+
+/** @} */
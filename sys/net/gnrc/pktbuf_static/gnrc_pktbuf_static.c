@@ -40,6 +40,13 @@ typedef struct _unused {
     unsigned int size;
 } _unused_t;
 
+/* snip created by gnrc_pktbuf_add_ext() */
+typedef struct {
+    gnrc_pktsnip_t pkt;
+    gnrc_pktbuf_ext_cb_t cb;
+    void *arg;
+} _ext_snip_t;
+
 static mutex_t _mutex = MUTEX_INIT;
 static uint8_t _pktbuf[GNRC_PKTBUF_SIZE];
 static _unused_t *_first_unused;
@@ -47,6 +54,11 @@ static _unused_t *_first_unused;
 #ifdef DEVELHELP
 /* maximum number of bytes allocated */
 static uint16_t max_byte_count = 0;
+/* number of bytes moved around by gnrc_pktbuf_mark() and
+ * gnrc_pktbuf_realloc_data() */
+static uint32_t moved_byte_count = 0;
+/* number of bytes referenced by gnrc_pktbuf_add_ext() instead of copying */
+static uint32_t ext_byte_count = 0;
 #endif
 
 /* internal gnrc_pktbuf functions */
@@ -60,6 +72,11 @@ static inline bool _pktbuf_contains(void *ptr)
     return (unsigned)((uint8_t *)ptr - _pktbuf) < GNRC_PKTBUF_SIZE;
 }
 
+static inline bool _is_ext(const gnrc_pktsnip_t *pkt)
+{
+    return (pkt->data != NULL) && !_pktbuf_contains(pkt->data);
+}
+
 /* fits size to byte alignment */
 static inline size_t _align(size_t size)
 {
@@ -104,6 +121,35 @@ gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, void *data, size_t size,
     return pkt;
 }
 
+gnrc_pktsnip_t *gnrc_pktbuf_add_ext(gnrc_pktsnip_t *next, const void *data,
+                                    size_t size, gnrc_nettype_t type,
+                                    gnrc_pktbuf_ext_cb_t cb, void *arg)
+{
+    _ext_snip_t *ext;
+
+    assert((data != NULL) && (size > 0));
+    mutex_lock(&_mutex);
+    ext = _pktbuf_alloc(sizeof(_ext_snip_t));
+    if (ext == NULL) {
+        DEBUG("pktbuf: error allocating new packet snip\n");
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    _set_pktsnip(&ext->pkt, next, (void *)data, size, type);
+    ext->cb = cb;
+    ext->arg = arg;
+#ifdef DEVELHELP
+    ext_byte_count += size;
+#endif
+    mutex_unlock(&_mutex);
+    return &ext->pkt;
+}
+
+bool gnrc_pktbuf_is_ext(const gnrc_pktsnip_t *pkt)
+{
+    return _is_ext(pkt);
+}
+
 gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t type)
 {
     gnrc_pktsnip_t *marked_snip;
@@ -121,6 +167,11 @@ gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_
         mutex_unlock(&_mutex);
         return NULL;
     }
+    if (_is_ext(pkt)) {
+        DEBUG("pktbuf: can not mark data outside of packet buffer\n");
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
     /* create new snip descriptor for marked data */
     marked_snip = _pktbuf_alloc(sizeof(gnrc_pktsnip_t));
     if (marked_snip == NULL) {
@@ -150,6 +201,9 @@ gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_
         }
         memcpy(new_data_marked, pkt->data, size);
         memcpy(new_data_rest, ((uint8_t *)pkt->data) + size, pkt->size - size);
+#ifdef DEVELHELP
+        moved_byte_count += pkt->size;
+#endif
         _pktbuf_free(pkt->data, pkt->size);
         marked_snip->data = new_data_marked;
         pkt->data = new_data_rest;
@@ -199,6 +253,9 @@ int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
         }
         if (pkt->data != NULL) {            /* if old data exist */
             memcpy(new_data, pkt->data, (pkt->size < size) ? pkt->size : size);
+#ifdef DEVELHELP
+            moved_byte_count += (pkt->size < size) ? pkt->size : size;
+#endif
         }
         _pktbuf_free(pkt->data, pkt->size);
         pkt->data = new_data;
@@ -222,6 +279,22 @@ void gnrc_pktbuf_hold(gnrc_pktsnip_t *pkt, unsigned int num)
     mutex_unlock(&_mutex);
 }
 
+/* frees pkt and its data, but not pkt->next */
+static void _free_snip(gnrc_pktsnip_t *pkt)
+{
+    if (_is_ext(pkt)) {
+        _ext_snip_t *ext = (_ext_snip_t *)pkt;
+
+        if (ext->cb != NULL) {
+            ext->cb(ext->arg, pkt->data, pkt->size);
+        }
+        _pktbuf_free(pkt, sizeof(_ext_snip_t));
+        return;
+    }
+    _pktbuf_free(pkt->data, pkt->size);
+    _pktbuf_free(pkt, sizeof(gnrc_pktsnip_t));
+}
+
 static void _release_error_locked(gnrc_pktsnip_t *pkt, uint32_t err)
 {
     while (pkt) {
@@ -230,8 +303,7 @@ static void _release_error_locked(gnrc_pktsnip_t *pkt, uint32_t err)
         tmp = pkt->next;
         if (pkt->users == 1) {
             pkt->users = 0; /* not necessary but to be on the safe side */
-            _pktbuf_free(pkt->data, pkt->size);
-            _pktbuf_free(pkt, sizeof(gnrc_pktsnip_t));
+            _free_snip(pkt);
         }
         else {
             pkt->users--;
@@ -256,11 +328,12 @@ gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
         mutex_unlock(&_mutex);
         return NULL;
     }
-    if (pkt->users > 1) {
+    if ((pkt->users > 1) || _is_ext(pkt)) {
         gnrc_pktsnip_t *new;
         new = _create_snip(pkt->next, pkt->data, pkt->size, pkt->type);
-        if (new != NULL) {
-            pkt->users--;
+        if ((new != NULL) && (--pkt->users == 0)) {
+            /* was the only user of the snip referencing external data */
+            _free_snip(pkt);
         }
         mutex_unlock(&_mutex);
         return new;
@@ -295,6 +368,8 @@ void gnrc_pktbuf_stats(void)
     printf("packet buffer: first byte: %p, last byte: %p (size: %u)\n",
            (void *)&_pktbuf[0], (void *)&_pktbuf[GNRC_PKTBUF_SIZE], GNRC_PKTBUF_SIZE);
     printf("  position of last byte used: %" PRIu16 "\n", max_byte_count);
+    printf("  bytes moved by mark/realloc: %" PRIu32 "\n", moved_byte_count);
+    printf("  bytes referenced by add_ext: %" PRIu32 "\n", ext_byte_count);
     if (ptr == NULL) {  /* packet buffer is completely full */
         _print_chunk(chunk, GNRC_PKTBUF_SIZE, count++);
     }
@@ -131,6 +131,7 @@ ssize_t gnrc_sock_send(gnrc_pktsnip_t *payload, sock_ip_ep_t *local,
             pkt = gnrc_ipv6_hdr_build(payload, (ipv6_addr_t *)&local->addr.ipv6,
                                       (ipv6_addr_t *)&remote->addr.ipv6);
             if (pkt == NULL) {
+                gnrc_pktbuf_release(payload);
                 return -ENOMEM;
             }
             if (payload->type == GNRC_NETTYPE_UNDEF) {
@@ -21,6 +21,7 @@
 #include "net/af.h"
 #include "net/protnum.h"
 #include "net/gnrc/ipv6.h"
+#include "net/gnrc/sock/udp.h"
 #include "net/gnrc/udp.h"
 #include "net/sock/udp.h"
 #include "net/udp.h"
@@ -209,17 +210,12 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
     return (int)pkt->size;
 }
 
-ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
-                      const sock_udp_ep_t *remote)
+/* checks the end points of a send call and binds sock if required */
+static int _send_ep(sock_udp_t *sock, const sock_udp_ep_t *remote,
+                    sock_ip_ep_t *local, sock_ip_ep_t **rem,
+                    uint16_t *src_port, uint16_t *dst_port)
 {
-    int res;
-    gnrc_pktsnip_t *payload, *pkt;
-    uint16_t src_port = 0, dst_port;
-    sock_ip_ep_t local;
-    sock_ip_ep_t *rem;
-
     assert((sock != NULL) || (remote != NULL));
-    assert((len == 0) || (data != NULL)); /* (len != 0) => (data != NULL) */
 
     if (remote != NULL) {
         if (remote->port == 0) {
@@ -247,20 +243,20 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
     /* cppcheck-suppress nullPointer */
     if ((sock == NULL) || (sock->local.family == AF_UNSPEC)) {
         /* no sock or sock currently unbound */
-        memset(&local, 0, sizeof(local));
-        if ((src_port = _get_dyn_port(sock)) == GNRC_SOCK_DYN_PORTRANGE_ERR) {
+        memset(local, 0, sizeof(*local));
+        if ((*src_port = _get_dyn_port(sock)) == GNRC_SOCK_DYN_PORTRANGE_ERR) {
             return -EINVAL;
         }
         if (sock != NULL) {
             /* bind sock object implicitly */
-            sock->local.port = src_port;
+            sock->local.port = *src_port;
             if (remote == NULL) {
                 sock->local.family = sock->remote.family;
             }
             else {
                 sock->local.family = remote->family;
             }
-            gnrc_sock_create(&sock->reg, GNRC_NETTYPE_UDP, src_port);
+            gnrc_sock_create(&sock->reg, GNRC_NETTYPE_UDP, *src_port);
 #ifdef MODULE_GNRC_SOCK_CHECK_REUSE
             /* prepend to current socks */
             sock->reg.next = (gnrc_sock_reg_t *)_udp_socks;
@@ -269,40 +265,97 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
         }
     }
     else {
-        src_port = sock->local.port;
-        memcpy(&local, &sock->local, sizeof(local));
+        *src_port = sock->local.port;
+        memcpy(local, &sock->local, sizeof(*local));
     }
     /* sock can't be NULL at this point */
     if (remote == NULL) {
-        rem = (sock_ip_ep_t *)&sock->remote;
-        dst_port = sock->remote.port;
+        *rem = (sock_ip_ep_t *)&sock->remote;
+        *dst_port = sock->remote.port;
     }
     else {
-        rem = (sock_ip_ep_t *)remote;
-        dst_port = remote->port;
+        *rem = (sock_ip_ep_t *)remote;
+        *dst_port = remote->port;
     }
     /* check for matching address families in local and remote */
-    if (local.family == AF_UNSPEC) {
-        local.family = rem->family;
+    if (local->family == AF_UNSPEC) {
+        local->family = (*rem)->family;
     }
-    else if (local.family != rem->family) {
+    else if (local->family != (*rem)->family) {
         return -EINVAL;
     }
-    /* generate payload and header snips */
-    payload = gnrc_pktbuf_add(NULL, (void *)data, len, GNRC_NETTYPE_UNDEF);
-    if (payload == NULL) {
-        return -ENOMEM;
-    }
+    return 0;
+}
+
+/* prepends the UDP header to payload and sends it, payload is released on error */
+static ssize_t _send_payload(gnrc_pktsnip_t *payload, sock_ip_ep_t *local,
+                             const sock_ip_ep_t *rem, uint16_t src_port,
+                             uint16_t dst_port)
+{
+    gnrc_pktsnip_t *pkt;
+    int res;
+
     pkt = gnrc_udp_hdr_build(payload, src_port, dst_port);
     if (pkt == NULL) {
         gnrc_pktbuf_release(payload);
         return -ENOMEM;
     }
-    res = gnrc_sock_send(pkt, &local, rem, PROTNUM_UDP);
+    res = gnrc_sock_send(pkt, local, rem, PROTNUM_UDP);
     if (res > 0) {
         res -= sizeof(udp_hdr_t);
     }
     return res;
 }
 
+ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
+                      const sock_udp_ep_t *remote)
+{
+    int res;
+    gnrc_pktsnip_t *payload;
+    uint16_t src_port = 0, dst_port;
+    sock_ip_ep_t local;
+    sock_ip_ep_t *rem;
+
+    assert((len == 0) || (data != NULL)); /* (len != 0) => (data != NULL) */
+
+    res = _send_ep(sock, remote, &local, &rem, &src_port, &dst_port);
+    if (res < 0) {
+        return res;
+    }
+    /* generate payload and header snips */
+    payload = gnrc_pktbuf_add(NULL, (void *)data, len, GNRC_NETTYPE_UNDEF);
+    if (payload == NULL) {
+        return -ENOMEM;
+    }
+    return _send_payload(payload, &local, rem, src_port, dst_port);
+}
+
+ssize_t gnrc_sock_udp_send_ext(sock_udp_t *sock, const void *data, size_t len,
+                               const sock_udp_ep_t *remote,
+                               gnrc_pktbuf_ext_cb_t cb, void *arg)
+{
+    int res;
+    gnrc_pktsnip_t *payload = NULL;
+    uint16_t src_port = 0, dst_port;
+    sock_ip_ep_t local;
+    sock_ip_ep_t *rem;
+
+    assert((data != NULL) && (len > 0));
+
+    res = _send_ep(sock, remote, &local, &rem, &src_port, &dst_port);
+    if (res == 0) {
+        /* reference payload instead of copying it */
+        payload = gnrc_pktbuf_add_ext(NULL, data, len, GNRC_NETTYPE_UNDEF, cb, arg);
+        res = -ENOMEM;
+    }
+    if (payload == NULL) {
+        /* data was not referenced, so it is released right away */
+        if (cb != NULL) {
+            cb(arg, data, len);
+        }
+        return res;
+    }
+    return _send_payload(payload, &local, rem, src_port, dst_port);
+}
+
 /** @} */
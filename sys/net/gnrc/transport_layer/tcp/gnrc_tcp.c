@@ -18,6 +18,7 @@
  */
 
 #include <errno.h>
+#include <stddef.h>
 #include <utlist.h>
 #include "net/af.h"
 #include "net/gnrc/tcp.h"
@@ -79,6 +80,21 @@ static void _cb_mbox_put_msg(void *arg)
     mbox_try_put(((cb_arg_t *) arg)->mbox_ptr, &msg);
 }
 
+/**
+ * @brief Callback for xtimer, signals the timeout to a thread in gnrc_tcp_accept().
+ *
+ * @param[in] arg   Ptr to queue_waiter_t of the waiting thread.
+ */
+static void _cb_queue_waiter_timeout(void *arg)
+{
+    queue_waiter_t *waiter = (queue_waiter_t *) arg;
+    msg_t msg;
+    msg.type = MSG_TYPE_USER_SPEC_TIMEOUT;
+    /* The flag survives if the mbox is full of wake-ups already */
+    waiter->timed_out = 1;
+    mbox_try_put(&(waiter->mbox), &msg);
+}
+
 /**
  * @brief Setup timer with a callback function.
  *
@@ -208,6 +224,86 @@ static int _gnrc_tcp_open(gnrc_tcp_tcb_t *tcb, const uint8_t *target_addr, uint1
     return ret;
 }
 
+/**
+ * @brief   Resets the connection information of a TCB.
+ *
+ * @note The locks, the listening queue and the list pointer are kept, they
+ *       are placed behind the connection information in gnrc_tcp_tcb_t.
+ *
+ * @param[out] tcb   TCB to reset.
+ */
+static void _tcb_reset(gnrc_tcp_tcb_t *tcb)
+{
+    memset(tcb, 0, offsetof(gnrc_tcp_tcb_t, fsm_lock));
+#ifdef MODULE_GNRC_IPV6
+    tcb->address_family = AF_INET6;
+#else
+    DEBUG("gnrc_tcp.c : _tcb_reset() : Address unspec, add netlayer module to makefile\n");
+#endif
+    tcb->rtt_var = RTO_UNINITIALIZED;
+    tcb->srtt = RTO_UNINITIALIZED;
+    tcb->rto = RTO_UNINITIALIZED;
+    mbox_init(&(tcb->mbox), tcb->mbox_raw, GNRC_TCP_TCB_MBOX_SIZE);
+}
+
+/**
+ * @brief   Puts a TCB of a listening queue into LISTEN state.
+ *
+ * @note Must be called with @p queue locked. @p tcb must be in state CLOSED and
+ *       must not be used by anybody else.
+ *
+ * @param[in,out] queue   Listening queue @p tcb belongs to.
+ * @param[in,out] tcb     TCB that should wait for a connection request.
+ */
+static void _queue_listen(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t *tcb)
+{
+    /* The TCP thread may still hold fsm_lock of a TCB that was just closed */
+    _tcb_reset(tcb);
+    tcb->next = NULL;
+    tcb->queue = queue;
+    tcb->status |= STATUS_PASSIVE;
+#ifdef MODULE_GNRC_IPV6
+    if (ipv6_addr_is_unspecified((ipv6_addr_t *) queue->local_addr)) {
+        tcb->status |= STATUS_ALLOW_ANY_ADDR;
+    }
+    else {
+        memcpy(tcb->local_addr, queue->local_addr, sizeof(ipv6_addr_t));
+    }
+#else
+    tcb->status |= STATUS_ALLOW_ANY_ADDR;
+#endif
+    tcb->local_port = queue->local_port;
+    _fsm(tcb, FSM_EVENT_CALL_OPEN, NULL, NULL, 0);
+}
+
+/**
+ * @brief   Hands a closed TCB back to its listening queue.
+ *
+ * @note A connection that is not closed yet (e.g. close timed out waiting
+ *       for the peer) is aborted, so the TCB is never lost for the queue.
+ *
+ * @param[in,out] tcb   TCB that was closed.
+ */
+static void _queue_release(gnrc_tcp_tcb_t *tcb)
+{
+    gnrc_tcp_tcb_queue_t *queue = tcb->queue;
+
+    if (queue == NULL) {
+        return;
+    }
+    mutex_lock(&(queue->lock));
+    /* Listening might have been stopped meanwhile */
+    if (tcb->queue == queue) {
+        mutex_lock(&(tcb->function_lock));
+        if (tcb->state != FSM_STATE_CLOSED) {
+            _fsm(tcb, FSM_EVENT_CALL_ABORT, NULL, NULL, 0);
+        }
+        mutex_unlock(&(tcb->function_lock));
+        _queue_listen(queue, tcb);
+    }
+    mutex_unlock(&(queue->lock));
+}
+
 /* External GNRC TCP API */
 int gnrc_tcp_init(void)
 {
@@ -231,18 +327,11 @@ int gnrc_tcp_init(void)
 
 void gnrc_tcp_tcb_init(gnrc_tcp_tcb_t *tcb)
 {
-    memset(tcb, 0, sizeof(gnrc_tcp_tcb_t));
-#ifdef MODULE_GNRC_IPV6
-    tcb->address_family = AF_INET6;
-#else
-    DEBUG("gnrc_tcp.c : gnrc_tcp_tcb_init() : Address unspec, add netlayer module to makefile\n");
-#endif
-    tcb->rtt_var = RTO_UNINITIALIZED;
-    tcb->srtt = RTO_UNINITIALIZED;
-    tcb->rto = RTO_UNINITIALIZED;
-    mbox_init(&(tcb->mbox), tcb->mbox_raw, GNRC_TCP_TCB_MBOX_SIZE);
+    _tcb_reset(tcb);
     mutex_init(&(tcb->fsm_lock));
     mutex_init(&(tcb->function_lock));
+    tcb->queue = NULL;
+    tcb->next = NULL;
 }
 
 int gnrc_tcp_open_active(gnrc_tcp_tcb_t *tcb,  const uint8_t address_family,
@@ -294,12 +383,168 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb,  const uint8_t address_family,
     return _gnrc_tcp_open(tcb, NULL, 0, local_addr, local_port, 1);
 }
 
-ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
-                      const uint32_t timeout_duration_us)
+int gnrc_tcp_listen(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t *tcbs, const size_t tcbs_len,
+                    const uint8_t address_family, const uint8_t *local_addr,
+                    const uint16_t local_port)
 {
+    assert(queue != NULL);
+    assert(tcbs != NULL);
+    assert(tcbs_len > 0);
+    assert(local_port != PORT_UNSPEC);
+
+    /* Check AF-Family support if local address was supplied */
+    if (local_addr != NULL) {
+#ifdef MODULE_GNRC_IPV6
+        if (address_family != AF_INET6) {
+            return -EAFNOSUPPORT;
+        }
+#else
+        return -EAFNOSUPPORT;
+#endif
+    }
+
+    /* Initialize queue */
+    memset(queue, 0, sizeof(gnrc_tcp_tcb_queue_t));
+    mutex_init(&(queue->lock));
+    mutex_init(&(queue->waiters_lock));
+#ifdef MODULE_GNRC_IPV6
+    if (local_addr != NULL) {
+        memcpy(queue->local_addr, local_addr, sizeof(ipv6_addr_t));
+    }
+#endif
+    queue->local_port = local_port;
+    queue->tcbs = tcbs;
+    queue->tcbs_len = tcbs_len;
+
+    /* Let all TCBs wait for connection requests */
+    mutex_lock(&(queue->lock));
+    for (size_t i = 0; i < tcbs_len; i++) {
+        _queue_listen(queue, &(tcbs[i]));
+    }
+    mutex_unlock(&(queue->lock));
+    return 0;
+}
+
+int gnrc_tcp_accept(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t **tcb,
+                    const uint32_t timeout_duration_us)
+{
+    assert(queue != NULL);
     assert(tcb != NULL);
-    assert(data != NULL);
 
+    msg_t msg;
+    xtimer_t user_timeout;
+    queue_waiter_t waiter;
+    int ret = 0;
+
+    *tcb = NULL;
+
+    /* Register for wake-ups before the TCBs are checked the first time */
+    mbox_init(&(waiter.mbox), waiter.mbox_raw, 1);
+    waiter.timed_out = 0;
+    mutex_lock(&(queue->waiters_lock));
+    LL_PREPEND(queue->waiters, &waiter);
+    mutex_unlock(&(queue->waiters_lock));
+
+    /* Setup user specified timeout if timeout_us is greater than zero */
+    if (timeout_duration_us > 0) {
+        user_timeout.callback = _cb_queue_waiter_timeout;
+        user_timeout.arg = &waiter;
+        xtimer_set(&user_timeout, timeout_duration_us);
+    }
+
+    while (*tcb == NULL) {
+        mutex_lock(&(queue->lock));
+        if (queue->tcbs == NULL) {
+            mutex_unlock(&(queue->lock));
+            ret = -EINVAL;
+            break;
+        }
+        for (size_t i = 0; i < queue->tcbs_len; i++) {
+            gnrc_tcp_tcb_t *iter = &(queue->tcbs[i]);
+
+            if (iter->status & STATUS_ACCEPTED) {
+                continue;
+            }
+            /* Connection was closed before it was accepted: Listen again */
+            if (iter->state == FSM_STATE_CLOSED) {
+                _queue_listen(queue, iter);
+            }
+            /* Hand out the first established connection */
+            else if (*tcb == NULL && (iter->state == FSM_STATE_ESTABLISHED ||
+                                      iter->state == FSM_STATE_CLOSE_WAIT)) {
+                mutex_lock(&(iter->fsm_lock));
+                iter->status |= STATUS_ACCEPTED;
+                mutex_unlock(&(iter->fsm_lock));
+                *tcb = iter;
+            }
+        }
+        mutex_unlock(&(queue->lock));
+
+        if (*tcb != NULL) {
+            break;
+        }
+        /* Non-blocking call: return immediately */
+        if (timeout_duration_us == 0) {
+            ret = -EAGAIN;
+            break;
+        }
+        if (waiter.timed_out) {
+            DEBUG("gnrc_tcp.c : gnrc_tcp_accept() : USER_SPEC_TIMEOUT\n");
+            ret = -ETIMEDOUT;
+            break;
+        }
+        /* Wait until a TCB of the queue changed its state, listening was
+         * stopped or the timeout expired */
+        mbox_get(&(waiter.mbox), &msg);
+    }
+
+    /* Cleanup */
+    if (timeout_duration_us > 0) {
+        xtimer_remove(&user_timeout);
+    }
+    mutex_lock(&(queue->waiters_lock));
+    LL_DELETE(queue->waiters, &waiter);
+    mutex_unlock(&(queue->waiters_lock));
+    return ret;
+}
+
+void gnrc_tcp_stop_listen(gnrc_tcp_tcb_queue_t *queue)
+{
+    assert(queue != NULL);
+
+    mutex_lock(&(queue->lock));
+    for (size_t i = 0; i < queue->tcbs_len; i++) {
+        gnrc_tcp_tcb_t *iter = &(queue->tcbs[i]);
+
+        /* Accepted connections stay open, all others are aborted */
+        iter->queue = NULL;
+        if (!(iter->status & STATUS_ACCEPTED)) {
+            gnrc_tcp_abort(iter);
+        }
+    }
+    queue->tcbs = NULL;
+    queue->tcbs_len = 0;
+    mutex_unlock(&(queue->lock));
+
+    /* Threads blocked in gnrc_tcp_accept() see the stopped queue and return */
+    _queue_wakeup(queue);
+}
+
+/**
+ * @brief Transmits data to connected peer.
+ *
+ * @param[in,out] tcb                   TCB holding the connection information.
+ * @param[in]     data                  Pointer to the data that should be transmitted.
+ * @param[in]     len                   Number of bytes that should be transmitted.
+ * @param[in]     timeout_duration_us   User specified timeout, zero disables it.
+ * @param[in]     ext                   If not NULL, the sent segments reference
+ *                                      @p data instead of copying it.
+ *
+ * @returns   See gnrc_tcp_send().
+ */
+static ssize_t _gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
+                              const uint32_t timeout_duration_us, const fsm_send_ext_t *ext)
+{
     msg_t msg;
     xtimer_t connection_timeout;
     cb_arg_t connection_timeout_arg = {MSG_TYPE_CONNECTION_TIMEOUT, &(tcb->mbox)};
@@ -336,8 +581,8 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
         _setup_timeout(&user_timeout, timeout_duration_us, _cb_mbox_put_msg, &user_timeout_arg);
     }
 
-    /* Loop until something was sent and acked */
-    while (ret == 0 || tcb->pkt_retransmit != NULL) {
+    /* Loop until something was sent. Unacknowledged data is retransmitted by the FSM */
+    while (ret == 0) {
         /* Check if the connections state is closed. If so, a reset was received */
         if (tcb->state == FSM_STATE_CLOSED) {
             ret = -ECONNRESET;
@@ -356,9 +601,17 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                            &probe_timeout_arg);
         }
 
-        /* Try to send data in case there nothing has been sent and we are not probing */
-        if (ret == 0 && !probing_mode) {
-            ret = _fsm(tcb, FSM_EVENT_CALL_SEND, NULL, (void *) data, len);
+        /* Try to send data in case we are not probing */
+        if (!probing_mode) {
+            if (ext != NULL) {
+                ret = _fsm(tcb, FSM_EVENT_CALL_SEND_EXT, NULL, (void *) ext, len);
+            }
+            else {
+                ret = _fsm(tcb, FSM_EVENT_CALL_SEND, NULL, (void *) data, len);
+            }
+            if (ret > 0) {
+                break;
+            }
         }
 
         /* Wait for responses */
@@ -372,7 +625,6 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
 
             case MSG_TYPE_USER_SPEC_TIMEOUT:
                 DEBUG("gnrc_tcp.c : gnrc_tcp_send() : USER_SPEC_TIMEOUT\n");
-                _fsm(tcb, FSM_EVENT_CLEAR_RETRANSMIT, NULL, NULL, 0);
                 ret = -ETIMEDOUT;
                 break;
 
@@ -419,6 +671,26 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
     return ret;
 }
 
+ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
+                      const uint32_t timeout_duration_us)
+{
+    assert(tcb != NULL);
+    assert(data != NULL);
+
+    return _gnrc_tcp_send(tcb, data, len, timeout_duration_us, NULL);
+}
+
+ssize_t gnrc_tcp_send_ext(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
+                          const uint32_t timeout_duration_us,
+                          gnrc_pktbuf_ext_cb_t cb, void *arg)
+{
+    assert(tcb != NULL);
+    assert(data != NULL);
+
+    fsm_send_ext_t ext = {data, cb, arg};
+    return _gnrc_tcp_send(tcb, data, len, timeout_duration_us, &ext);
+}
+
 ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
                       const uint32_t timeout_duration_us)
 {
@@ -488,8 +760,7 @@ ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
                     break;
 
                 case MSG_TYPE_USER_SPEC_TIMEOUT:
-                    DEBUG("gnrc_tcp.c : gnrc_tcp_send() : USER_SPEC_TIMEOUT\n");
-                    _fsm(tcb, FSM_EVENT_CLEAR_RETRANSMIT, NULL, NULL, 0);
+                    DEBUG("gnrc_tcp.c : gnrc_tcp_recv() : USER_SPEC_TIMEOUT\n");
                     ret = -ETIMEDOUT;
                     break;
 
@@ -525,6 +796,7 @@ void gnrc_tcp_close(gnrc_tcp_tcb_t *tcb)
     /* Return if connection is closed */
     if (tcb->state == FSM_STATE_CLOSED) {
         mutex_unlock(&(tcb->function_lock));
+        _queue_release(tcb);
         return;
     }
 
@@ -564,6 +836,7 @@ void gnrc_tcp_close(gnrc_tcp_tcb_t *tcb)
     xtimer_remove(&connection_timeout);
     tcb->status &= ~STATUS_WAIT_FOR_MSG;
     mutex_unlock(&(tcb->function_lock));
+    _queue_release(tcb);
 }
 
 void gnrc_tcp_abort(gnrc_tcp_tcb_t *tcb)
@@ -577,6 +850,7 @@ void gnrc_tcp_abort(gnrc_tcp_tcb_t *tcb)
         _fsm(tcb, FSM_EVENT_CALL_ABORT, NULL, NULL, 0);
     }
     mutex_unlock(&(tcb->function_lock));
+    _queue_release(tcb);
 }
 
 int gnrc_tcp_calc_csum(const gnrc_pktsnip_t *hdr, const gnrc_pktsnip_t *pseudo_hdr)
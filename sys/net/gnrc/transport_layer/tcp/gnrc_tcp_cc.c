@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc
+ * @{
+ *
+ * @file
+ * @brief       Implementation of internal/cc.h
+ * @}
+ */
+#include "internal/common.h"
+#include "internal/cc.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/**
+ * @brief Calculates the new slow start threshold after a loss (see RFC 5681, equation 4).
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   Half of the data in flight, but at least two segments.
+ */
+static uint32_t _loss_ssthresh(const gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t half = (tcb->snd_nxt - tcb->snd_una) / 2;
+    uint32_t min = 2 * _cc_smss(tcb);
+
+    return (half > min) ? half : min;
+}
+
+void _cc_init(gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t smss = _cc_smss(tcb);
+
+    /* Initial window (see RFC 5681, section 3.1) */
+    if (smss > 2190) {
+        tcb->cwnd = 2 * smss;
+    }
+    else if (smss > 1095) {
+        tcb->cwnd = 3 * smss;
+    }
+    else {
+        tcb->cwnd = 4 * smss;
+    }
+    /* The window field limits the amount of data in flight to 64 KiB anyway */
+    tcb->ssthresh = UINT16_MAX;
+    tcb->recover = tcb->snd_una;
+    tcb->dup_acks = 0;
+    tcb->status &= ~STATUS_FAST_RECOVERY;
+}
+
+uint32_t _cc_usable_window(const gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t wnd = (tcb->cwnd < tcb->snd_wnd) ? tcb->cwnd : tcb->snd_wnd;
+    uint32_t flight = tcb->snd_nxt - tcb->snd_una;
+
+    return (wnd > flight) ? (wnd - flight) : 0;
+}
+
+bool _cc_ack(gnrc_tcp_tcb_t *tcb, uint32_t acked)
+{
+    uint32_t smss = _cc_smss(tcb);
+
+    tcb->dup_acks = 0;
+    if (tcb->status & STATUS_FAST_RECOVERY) {
+        /* Full acknowledgment: leave fast recovery with a deflated window */
+        if (LEQ_32_BIT(tcb->recover, tcb->snd_una)) {
+            uint32_t flight = tcb->snd_nxt - tcb->snd_una;
+
+            flight = (flight > smss) ? flight : smss;
+            tcb->cwnd = (tcb->ssthresh < flight + smss) ? tcb->ssthresh : flight + smss;
+            tcb->status &= ~STATUS_FAST_RECOVERY;
+            DEBUG("gnrc_tcp_cc.c : _cc_ack() : Leave fast recovery, cwnd=%lu\n",
+                  (unsigned long)tcb->cwnd);
+            return false;
+        }
+        /* Partial acknowledgment: the next segment was lost as well (see RFC 6582, 3.2) */
+        tcb->cwnd = (tcb->cwnd > acked) ? (tcb->cwnd - acked) : 0;
+        if (acked >= smss) {
+            tcb->cwnd += smss;
+        }
+        return true;
+    }
+
+    /* Slow start or congestion avoidance (see RFC 5681, section 3.1) */
+    if (tcb->cwnd < tcb->ssthresh) {
+        tcb->cwnd += (acked < smss) ? acked : smss;
+    }
+    else {
+        uint32_t inc = (smss * smss) / tcb->cwnd;
+        tcb->cwnd += (inc > 0) ? inc : 1;
+    }
+
+    /* Segments sent before a retransmission timeout are retransmitted one by one */
+    if (LSS_32_BIT(tcb->snd_una, tcb->recover)) {
+        return true;
+    }
+    tcb->recover = tcb->snd_una;
+    return false;
+}
+
+bool _cc_dup_ack(gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t smss = _cc_smss(tcb);
+
+    /* Each duplicate ACK signals a segment that left the network: inflate window */
+    if (tcb->status & STATUS_FAST_RECOVERY) {
+        tcb->cwnd += smss;
+        return false;
+    }
+
+    tcb->dup_acks += 1;
+    /* Don't start another fast retransmit for segments sent before the last loss */
+    if (tcb->dup_acks != GNRC_TCP_DUP_ACK_THRESHOLD || LSS_32_BIT(tcb->snd_una, tcb->recover)) {
+        return false;
+    }
+
+    tcb->ssthresh = _loss_ssthresh(tcb);
+    tcb->cwnd = tcb->ssthresh + GNRC_TCP_DUP_ACK_THRESHOLD * smss;
+    tcb->recover = tcb->snd_nxt;
+    tcb->status |= STATUS_FAST_RECOVERY;
+    DEBUG("gnrc_tcp_cc.c : _cc_dup_ack() : Fast retransmit, ssthresh=%lu\n",
+          (unsigned long)tcb->ssthresh);
+    return true;
+}
+
+void _cc_timeout(gnrc_tcp_tcb_t *tcb)
+{
+    /* Keep ssthresh if the same segment times out again (see RFC 5681, section 3.1) */
+    if (tcb->retries == 0) {
+        tcb->ssthresh = _loss_ssthresh(tcb);
+    }
+    tcb->cwnd = _cc_smss(tcb);
+    tcb->recover = tcb->snd_nxt;
+    tcb->dup_acks = 0;
+    tcb->status &= ~STATUS_FAST_RECOVERY;
+    DEBUG("gnrc_tcp_cc.c : _cc_timeout() : ssthresh=%lu\n", (unsigned long)tcb->ssthresh);
+}
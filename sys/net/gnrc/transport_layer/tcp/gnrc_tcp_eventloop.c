@@ -160,21 +160,10 @@ static int _receive(gnrc_pktsnip_t *pkt)
 #ifdef MODULE_GNRC_IPV6
         /* Check if current TCB is fitting for the incomming packet */
         if (ip->type == GNRC_NETTYPE_IPV6 && tcb->address_family == AF_INET6) {
-            /* If SYN is set, a connection is listening on that port ... */
-            ipv6_addr_t *tmp_addr = NULL;
-            if (syn && tcb->local_port == dst && tcb->state == FSM_STATE_LISTEN) {
-                /* ... and local addr is unspec or pre configured */
-                tmp_addr = &((ipv6_hdr_t *)ip->data)->dst;
-                if (ipv6_addr_equal((ipv6_addr_t *) tcb->local_addr, (ipv6_addr_t *) tmp_addr) ||
-                    ipv6_addr_is_unspecified((ipv6_addr_t *) tcb->local_addr)) {
-                    break;
-                }
-            }
-
-            /* If SYN is not set and the ports match ... */
-            if (!syn && tcb->local_port == dst && tcb->peer_port == src) {
+            /* If the ports match ... */
+            if (tcb->local_port == dst && tcb->peer_port == src) {
                 /* .. and the IPv6 addresses match */
-                tmp_addr = &((ipv6_hdr_t * )ip->data)->src;
+                ipv6_addr_t *tmp_addr = &((ipv6_hdr_t * )ip->data)->src;
                 if (ipv6_addr_equal((ipv6_addr_t *) tcb->peer_addr, (ipv6_addr_t *) tmp_addr)) {
                     break;
                 }
@@ -182,12 +171,31 @@ static int _receive(gnrc_pktsnip_t *pkt)
         }
 #else
         /* Supress compiler warnings if TCP is build without network layer */
-        (void) syn;
         (void) src;
         (void) dst;
 #endif
         tcb = tcb->next;
     }
+
+    /* A SYN not belonging to a known connection (a retransmitted one goes to the
+     * TCB in SYN_RCVD found above) is handed to a connection listening on that port */
+    if (tcb == NULL && syn) {
+        tcb = _list_tcb_head;
+        while (tcb) {
+#ifdef MODULE_GNRC_IPV6
+            if (ip->type == GNRC_NETTYPE_IPV6 && tcb->address_family == AF_INET6 &&
+                tcb->local_port == dst && tcb->state == FSM_STATE_LISTEN) {
+                /* Local addr is unspec or pre configured */
+                ipv6_addr_t *tmp_addr = &((ipv6_hdr_t *)ip->data)->dst;
+                if (ipv6_addr_equal((ipv6_addr_t *) tcb->local_addr, (ipv6_addr_t *) tmp_addr) ||
+                    ipv6_addr_is_unspecified((ipv6_addr_t *) tcb->local_addr)) {
+                    break;
+                }
+            }
+#endif
+            tcb = tcb->next;
+        }
+    }
     mutex_unlock(&_list_tcb_lock);
 
     /* Call FSM with event RCVD_PKT if a fitting TCB was found */
@@ -21,6 +21,7 @@
 #include "net/af.h"
 #include "internal/common.h"
 #include "internal/pkt.h"
+#include "internal/cc.h"
 #include "internal/option.h"
 #include "internal/rcvbuf.h"
 #include "internal/fsm.h"
@@ -80,10 +81,46 @@ static uint16_t _get_random_local_port(void)
  */
 static int _clear_retransmit(gnrc_tcp_tcb_t *tcb)
 {
-    if (tcb->pkt_retransmit != NULL) {
-        gnrc_pktbuf_release(tcb->pkt_retransmit);
+    if (tcb->snd_queue_len > 0) {
+        for (unsigned i = 0; i < tcb->snd_queue_len; i++) {
+            gnrc_pktbuf_release(tcb->snd_queue[i]);
+        }
         xtimer_remove(&(tcb->tim_tout));
-        tcb->pkt_retransmit = NULL;
+        tcb->snd_queue_len = 0;
+    }
+    return 0;
+}
+
+/**
+ * @brief Retransmits the oldest segment in the retransmit queue without timer backoff.
+ *
+ * @param[in,out] tcb   TCB holding the retransmit queue.
+ *
+ * @return   Zero on success.
+ */
+static int _retransmit_first(gnrc_tcp_tcb_t *tcb)
+{
+    if (tcb->snd_queue_len > 0) {
+        /* Increase users: every send attempt consumes a user */
+        gnrc_pktbuf_hold(tcb->snd_queue[0], 1);
+        _pkt_send(tcb, tcb->snd_queue[0], 0, true);
+    }
+    return 0;
+}
+
+/**
+ * @brief Signals the listening queue of a TCB that it has to be looked at.
+ *
+ * @note The TCB is ready to be accepted or has to be put back into LISTEN state.
+ *
+ * @param[in] tcb   TCB whose listening queue should be signaled.
+ *
+ * @return   Zero on success.
+ */
+static int _notify_queue(gnrc_tcp_tcb_t *tcb)
+{
+    if (tcb->queue != NULL && !(tcb->status & STATUS_ACCEPTED)) {
+        _queue_wakeup(tcb->queue);
     }
     return 0;
 }
@@ -117,6 +154,7 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
     DEBUG("_transition_to: %d\n", state);
 
     gnrc_tcp_tcb_t *iter = NULL;
+    bool notify = false;
 
     switch (state) {
         case FSM_STATE_CLOSED:
@@ -131,6 +169,7 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
             /* Free potencially allocated receive buffer */
             _rcvbuf_release_buffer(tcb);
             tcb->status |= STATUS_NOTIFY_USER;
+            notify = true;
             break;
 
         case FSM_STATE_LISTEN:
@@ -145,10 +184,8 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
 #endif
             tcb->peer_port = PORT_UNSPEC;
 
-            /* Allocate receive buffer */
-            if (_rcvbuf_get_buffer(tcb) == -ENOMEM) {
-                return -ENOMEM;
-            }
+            /* The receive buffer is allocated as soon as a SYN arrives */
+            _rcvbuf_release_buffer(tcb);
 
             /* Add connection to active connections (if not already active) */
             mutex_lock(&_list_tcb_lock);
@@ -189,8 +226,14 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
             break;
 
         case FSM_STATE_ESTABLISHED:
+            _cc_init(tcb);
+            tcb->status |= STATUS_NOTIFY_USER;
+            notify = true;
+            break;
+
         case FSM_STATE_CLOSE_WAIT:
             tcb->status |= STATUS_NOTIFY_USER;
+            notify = true;
             break;
 
         case FSM_STATE_TIME_WAIT:
@@ -201,6 +244,10 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
             break;
     }
     tcb->state = state;
+    /* The accepting thread may preempt this one and must see the new state */
+    if (notify) {
+        _notify_queue(tcb);
+    }
     return 0;
 }
 
@@ -222,10 +269,7 @@ static int _fsm_call_open(gnrc_tcp_tcb_t *tcb)
 
     if (tcb->status & STATUS_PASSIVE) {
         /* Passive open, T: CLOSED -> LISTEN */
-        if (_transition_to(tcb, FSM_STATE_LISTEN) == -ENOMEM) {
-            _transition_to(tcb, FSM_STATE_CLOSED);
-            return -ENOMEM;
-        }
+        _transition_to(tcb, FSM_STATE_LISTEN);
     }
     else {
         /* Active Open, set TCB values, send SYN, T: CLOSED -> SYN_SENT */
@@ -253,34 +297,57 @@ static int _fsm_call_open(gnrc_tcp_tcb_t *tcb)
 /**
  * @brief FSM Handling function for sending data.
  *
+ * @note Sends as many segments as the send window, the congestion window and the
+ *       retransmit queue allow.
+ *
  * @param[in,out] tcb   TCB holding the connection information.
  * @param[in,out] buf   Buffer containing data to send.
  * @param[in]     len   Maximum Number of Bytes to send from @p buf.
+ * @param[in]     ext   If not NULL, @p buf is ignored and the segments reference
+ *                      ext->data instead of copying it.
  *
  * @returns   Number of successfully transmitted bytes.
  */
-static int _fsm_call_send(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
+static int _fsm_call_send(gnrc_tcp_tcb_t *tcb, void *buf, size_t len,
+                          const fsm_send_ext_t *ext)
 {
     DEBUG("gnrc_tcp_fsm.c : _fsm_call_send()\n");
 
-    size_t payload = (tcb->snd_una + tcb->snd_wnd) - tcb->snd_nxt;
+    size_t sent = 0;
+    size_t smss = _cc_smss(tcb);
 
-    /* Check if window is open and all packets were transmitted */
-    if (payload > 0 && tcb->snd_wnd > 0 && tcb->pkt_retransmit == NULL) {
+    /* Keep the last slot of the retransmit queue for the FIN */
+    while (sent < len && tcb->snd_queue_len < GNRC_TCP_SND_QUEUE_SIZE) {
         /* Calculate segment size */
-        payload = (payload < GNRC_TCP_MSS) ? payload : GNRC_TCP_MSS;
-        payload = (payload < tcb->mss) ? payload : tcb->mss;
-        payload = (payload < len) ? payload : len;
+        size_t payload = _cc_usable_window(tcb);
+        payload = (payload < smss) ? payload : smss;
+        payload = (payload < (len - sent)) ? payload : (len - sent);
+
+        /* Avoid small segments while data is in flight (Sender SWS avoidance) */
+        if (payload == 0 || (payload < smss && payload < (len - sent) &&
+                             tcb->snd_nxt != tcb->snd_una)) {
+            break;
+        }
 
-        /* Calculate payload size for this segment */
+        /* Build, queue and send segment */
         gnrc_pktsnip_t *out_pkt = NULL;
         uint16_t seq_con = 0;
-        _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt, buf, payload);
+        if (ext != NULL) {
+            _pkt_build_ext(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt,
+                           (const uint8_t *) ext->data + sent, payload, ext->cb, ext->arg);
+        }
+        else {
+            _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt,
+                       (uint8_t *) buf + sent, payload);
+        }
+        if (out_pkt == NULL) {
+            break;
+        }
         _pkt_setup_retransmit(tcb, out_pkt, false);
         _pkt_send(tcb, out_pkt, seq_con, false);
-        return payload;
+        sent += payload;
     }
-    return 0;
+    return sent;
 }
 
 /**
@@ -303,9 +370,14 @@ static int _fsm_call_recv(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
     /* Read data into 'buf' up to 'len' bytes from receive buffer */
     size_t rcvd = ringbuffer_get(&(tcb->rcv_buf), buf, len);
 
-    /* If receive buffer can store more than GNRC_TCP_MSS: open window to available buffer size */
-    if (ringbuffer_get_free(&tcb->rcv_buf) >= GNRC_TCP_MSS) {
-        tcb->rcv_wnd = ringbuffer_get_free(&(tcb->rcv_buf));
+    /* Open window only if it grows by min(GNRC_TCP_MSS, buffer size / 2) (Receiver SWS
+     * avoidance, see RFC 1122, section 4.2.3.3) */
+    size_t wnd = ringbuffer_get_free(&(tcb->rcv_buf));
+    size_t thresh = (GNRC_TCP_MSS < (GNRC_TCP_RCV_BUF_SIZE / 2)) ? GNRC_TCP_MSS :
+                    (GNRC_TCP_RCV_BUF_SIZE / 2);
+    wnd = (wnd < UINT16_MAX) ? wnd : UINT16_MAX;
+    if (wnd >= tcb->rcv_wnd + thresh) {
+        tcb->rcv_wnd = wnd;
 
         /* Send ACK to anounce window update */
         gnrc_pktsnip_t *out_pkt = NULL;
@@ -386,7 +458,6 @@ static int _fsm_call_abort(gnrc_tcp_tcb_t *tcb)
  * @param[in]     in_pkt   Incomming packet.
  *
  * @returns   Zero on success.
- *            -ENOMEM if receive buffer could not be allocated.
  */
 static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
 {
@@ -469,6 +540,12 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 return 0;
             }
 
+            /* Allocate receive buffer, drop SYN if there is none. The peer retries */
+            if (_rcvbuf_get_buffer(tcb) == -ENOMEM) {
+                DEBUG("gnrc_tcp_fsm.c : _fsm_rcvd_pkt() : Out of receive buffers\n");
+                return 0;
+            }
+
             /* SYN request is valid, fill TCB with connection information */
 #ifdef MODULE_GNRC_IPV6
             if (snp->type == GNRC_NETTYPE_IPV6 && tcb->address_family == AF_INET6) {
@@ -558,6 +635,12 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
     }
     /* Handle other states */
     else {
+        /* Retransmitted SYN of the connection in setup: repeat SYN+ACK */
+        if (tcb->state == FSM_STATE_SYN_RCVD && (ctl & MSK_SYN_ACK) == MSK_SYN &&
+            seg_seq == tcb->irs) {
+            _retransmit_first(tcb);
+            return 0;
+        }
         seg_len = _pkt_get_seg_len(in_pkt);
         pay_len = _pkt_get_pay_len(in_pkt);
         /* 1) Verify sequence number ... */
@@ -573,10 +656,8 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
         if (ctl & MSK_RST) {
             /* .. and state is SYN_RCVD and the connection is passive: SYN_RCVD -> LISTEN */
             if (tcb->state == FSM_STATE_SYN_RCVD && (tcb->status & STATUS_PASSIVE)) {
-                if (_transition_to(tcb, FSM_STATE_LISTEN) == -ENOMEM) {
-                    _transition_to(tcb, FSM_STATE_CLOSED);
-                    return -ENOMEM;
-                }
+                _clear_retransmit(tcb);
+                _transition_to(tcb, FSM_STATE_LISTEN);
             }
             else {
                 _transition_to(tcb, FSM_STATE_CLOSED);
@@ -614,8 +695,25 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 tcb->state == FSM_STATE_CLOSING || tcb->state == FSM_STATE_LAST_ACK) {
                 /* Acknowledge previously sent data */
                 if (LSS_32_BIT(tcb->snd_una, seg_ack) && LEQ_32_BIT(seg_ack, tcb->snd_nxt)) {
+                    uint32_t acked = seg_ack - tcb->snd_una;
+
                     tcb->snd_una = seg_ack;
                     _pkt_acknowledge(tcb, seg_ack);
+
+                    /* Partial acknowledgment during loss recovery: next segment is lost */
+                    if (_cc_ack(tcb, acked)) {
+                        _retransmit_first(tcb);
+                    }
+                    /* Signal user, the window may allow more data to be sent */
+                    tcb->status |= STATUS_NOTIFY_USER;
+                }
+                /* Duplicate ACK (see RFC 5681, section 2) */
+                else if (seg_ack == tcb->snd_una && tcb->snd_queue_len > 0 && pay_len == 0 &&
+                         seg_wnd == tcb->snd_wnd && !(ctl & MSK_FIN)) {
+                    if (_cc_dup_ack(tcb)) {
+                        _retransmit_first(tcb);
+                    }
+                    tcb->status |= STATUS_NOTIFY_USER;
                 }
                 /* ACK received for something not yet sent: Reply with pure ACK */
                 else if (LSS_32_BIT(tcb->snd_nxt, seg_ack)) {
@@ -639,25 +737,25 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 /* Additional processing */
                 /* Check additionaly if previously sent FIN was acknowledged */
                 if (tcb->state == FSM_STATE_FIN_WAIT_1) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->snd_queue_len == 0) {
                         _transition_to(tcb, FSM_STATE_FIN_WAIT_2);
                     }
                 }
                 /* If retransmission queue is empty, acknowledge close operation */
                 if (tcb->state == FSM_STATE_FIN_WAIT_2) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->snd_queue_len == 0) {
                         /* Optional: Unblock user close operation */
                     }
                 }
                 /* If our FIN has been acknowledged: Transition to TIME_WAIT */
                 if (tcb->state == FSM_STATE_CLOSING) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->snd_queue_len == 0) {
                         _transition_to(tcb, FSM_STATE_TIME_WAIT);
                     }
                 }
                 /* If our FIN was acknowledged and status is LAST_ACK: close connection */
                 if (tcb->state == FSM_STATE_LAST_ACK) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->snd_queue_len == 0) {
                         _transition_to(tcb, FSM_STATE_CLOSED);
                         return 0;
                     }
@@ -702,6 +800,13 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 tcb->state == FSM_STATE_SYN_SENT) {
                 return 0;
             }
+            /* Data in front of the FIN is missing: acknowledge received data, ignore FIN */
+            if (LSS_32_BIT(tcb->rcv_nxt, seg_seq + pay_len)) {
+                _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt,
+                           NULL, 0);
+                _pkt_send(tcb, out_pkt, seq_con, false);
+                return 0;
+            }
             /* Advance rcv_nxt over FIN bit */
             tcb->rcv_nxt = seg_seq + seg_len;
             _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt, NULL, 0);
@@ -711,7 +816,7 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 _transition_to(tcb, FSM_STATE_CLOSE_WAIT);
             }
             else if (tcb->state == FSM_STATE_FIN_WAIT_1) {
-                if (tcb->pkt_retransmit == NULL) {
+                if (tcb->snd_queue_len == 0) {
                     _transition_to(tcb, FSM_STATE_TIME_WAIT);
                 }
                 else {
@@ -753,9 +858,12 @@ static int _fsm_timeout_timewait(gnrc_tcp_tcb_t *tcb)
 static int _fsm_timeout_retransmit(gnrc_tcp_tcb_t *tcb)
 {
     DEBUG("gnrc_tcp_fsm.c : _fsm_timeout_retransmit()\n");
-    if (tcb->pkt_retransmit != NULL) {
-        _pkt_setup_retransmit(tcb, tcb->pkt_retransmit, true);
-        _pkt_send(tcb, tcb->pkt_retransmit, 0, true);
+    if (tcb->snd_queue_len > 0) {
+        _cc_timeout(tcb);
+        _pkt_setup_retransmit(tcb, tcb->snd_queue[0], true);
+        _pkt_send(tcb, tcb->snd_queue[0], 0, true);
+        /* Only timeouts count, fast retransmits are no sign of a dead path */
+        tcb->retries += 1;
     }
     else {
         DEBUG("gnrc_tcp_fsm.c : _fsm_timeout_retransmit() : Retransmit queue is empty\n");
@@ -836,7 +944,10 @@ static int _fsm_unprotected(gnrc_tcp_tcb_t *tcb, fsm_event_t event, gnrc_pktsnip
             ret = _fsm_call_open(tcb);
             break;
         case FSM_EVENT_CALL_SEND :
-            ret = _fsm_call_send(tcb, buf, len);
+            ret = _fsm_call_send(tcb, buf, len, NULL);
+            break;
+        case FSM_EVENT_CALL_SEND_EXT :
+            ret = _fsm_call_send(tcb, NULL, len, (const fsm_send_ext_t *) buf);
             break;
         case FSM_EVENT_CALL_RECV :
             ret = _fsm_call_recv(tcb, buf, len);
@@ -115,25 +115,28 @@ int _pkt_build_reset_from_pkt(gnrc_pktsnip_t **out_pkt, gnrc_pktsnip_t *in_pkt)
     return 0;
 }
 
-int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
-               const uint16_t ctl, const uint32_t seq_num, const uint32_t ack_num,
-               void *payload, const size_t payload_len)
+/**
+ * @brief Builds TCP and network layer header in front of an already allocated payload.
+ *
+ * @param[in,out] tcb           TCB holding the connection information.
+ * @param[out]    out_pkt       Pointer to paket to build.
+ * @param[out]    seq_con       Sequence number consumption of built packet.
+ * @param[in]     ctl           Control bits to set in @p out_pkt.
+ * @param[in]     seq_num       Sequence number of the new packet.
+ * @param[in]     ack_num       Acknowledgment number of the new packet.
+ * @param[in]     pay_snp       Payload snip, may be NULL. Released on error.
+ *
+ * @returns   Zero on success.
+ *            -ENOMEM if pktbuf is full.
+ */
+static int _pkt_build_hdr(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
+                          const uint16_t ctl, const uint32_t seq_num, const uint32_t ack_num,
+                          gnrc_pktsnip_t *pay_snp)
 {
-    gnrc_pktsnip_t *pay_snp = NULL;
     gnrc_pktsnip_t *tcp_snp = NULL;
     tcp_hdr_t tcp_hdr;
     uint8_t offset = TCP_HDR_OFFSET_MIN;
 
-    /* Add payload, if supplied */
-    if (payload != NULL && payload_len > 0) {
-        pay_snp = gnrc_pktbuf_add(pay_snp, payload, payload_len, GNRC_NETTYPE_UNDEF);
-        if (pay_snp == NULL) {
-            DEBUG("gnrc_tcp_pkt.c : _pkt_build() : Can't allocate buffer for payload\n.");
-            *(out_pkt) = NULL;
-            return -ENOMEM;
-        }
-    }
-
     /* Fill TCP header */
     tcp_hdr.src_port = byteorder_htons(tcb->local_port);
     tcp_hdr.dst_port = byteorder_htons(tcb->peer_port);
@@ -154,7 +157,7 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
     /* Allocate TCP header: size = offset * 4 bytes */
     tcp_snp = gnrc_pktbuf_add(pay_snp, &tcp_hdr, offset * 4, GNRC_NETTYPE_TCP);
     if (tcp_snp == NULL) {
-        DEBUG("gnrc_tcp_pkt.c : _pkt_build() : Can't allocate buffer for TCP Header\n.");
+        DEBUG("gnrc_tcp_pkt.c : _pkt_build_hdr() : Can't allocate buffer for TCP Header\n.");
         gnrc_pktbuf_release(pay_snp);
         *(out_pkt) = NULL;
         return -ENOMEM;
@@ -183,7 +186,7 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
 #ifdef MODULE_GNRC_IPV6
     gnrc_pktsnip_t *ip6_snp = gnrc_ipv6_hdr_build(tcp_snp, NULL, (ipv6_addr_t *) tcb->peer_addr);
     if (ip6_snp == NULL) {
-        DEBUG("gnrc_tcp_pkt.c : _pkt_build() : Can't allocate buffer for IPv6 Header.\n");
+        DEBUG("gnrc_tcp_pkt.c : _pkt_build_hdr() : Can't allocate buffer for IPv6 Header.\n");
         gnrc_pktbuf_release(tcp_snp);
         *(out_pkt) = NULL;
         return -ENOMEM;
@@ -204,6 +207,56 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
         if (ctl & MSK_FIN) {
             *seq_con += 1;
         }
+        *seq_con += gnrc_pkt_len(pay_snp);
+    }
+    return 0;
+}
+
+int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
+               const uint16_t ctl, const uint32_t seq_num, const uint32_t ack_num,
+               void *payload, const size_t payload_len)
+{
+    gnrc_pktsnip_t *pay_snp = NULL;
+
+    /* Add payload, if supplied */
+    if (payload != NULL && payload_len > 0) {
+        pay_snp = gnrc_pktbuf_add(pay_snp, payload, payload_len, GNRC_NETTYPE_UNDEF);
+        if (pay_snp == NULL) {
+            DEBUG("gnrc_tcp_pkt.c : _pkt_build() : Can't allocate buffer for payload\n.");
+            *(out_pkt) = NULL;
+            return -ENOMEM;
+        }
+    }
+    return _pkt_build_hdr(tcb, out_pkt, seq_con, ctl, seq_num, ack_num, pay_snp);
+}
+
+int _pkt_build_ext(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
+                   const uint16_t ctl, const uint32_t seq_num, const uint32_t ack_num,
+                   const void *payload, const size_t payload_len,
+                   gnrc_pktbuf_ext_cb_t cb, void *arg)
+{
+    /* Build headers first: if they can't be allocated, the payload was never
+     * referenced and @p cb must not be called */
+    int ret = _pkt_build_hdr(tcb, out_pkt, seq_con, ctl, seq_num, ack_num, NULL);
+    if (ret < 0) {
+        return ret;
+    }
+
+    /* Reference payload instead of copying it */
+    gnrc_pktsnip_t *pay_snp = gnrc_pktbuf_add_ext(NULL, payload, payload_len,
+                                                  GNRC_NETTYPE_UNDEF, cb, arg);
+    if (pay_snp == NULL) {
+        DEBUG("gnrc_tcp_pkt.c : _pkt_build_ext() : Can't allocate buffer for payload\n.");
+        gnrc_pktbuf_release(*out_pkt);
+        *(out_pkt) = NULL;
+        return -ENOMEM;
+    }
+
+    /* Append payload behind the TCP header */
+    gnrc_pktsnip_t *tcp_snp;
+    LL_SEARCH_SCALAR(*out_pkt, tcp_snp, type, GNRC_NETTYPE_TCP);
+    tcp_snp->next = pay_snp;
+    if (seq_con != NULL) {
         *seq_con += payload_len;
     }
     return 0;
@@ -219,12 +272,18 @@ int _pkt_send(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *out_pkt, const uint16_t seq_c
 
     /* If this is no retransmission, advance sequence number and measure time */
     if (!retransmit) {
-        tcb->retries = 0;
         tcb->snd_nxt += seq_con;
-        tcb->rtt_start = xtimer_now().ticks32;
+
+        /* Time one segment per round trip */
+        if (seq_con > 0 && !(tcb->status & STATUS_RTT_MEASURE)) {
+            tcb->status |= STATUS_RTT_MEASURE;
+            tcb->rtt_start = xtimer_now().ticks32;
+            tcb->rtt_seq = tcb->snd_nxt;
+        }
     }
     else {
-        tcb->retries += 1;
+        /* Acknowledgments are ambiguous after a retransmission (Karns Algorithm) */
+        tcb->status &= ~STATUS_RTT_MEASURE;
     }
 
     /* Pass packet down the network stack */
@@ -296,41 +355,17 @@ uint32_t _pkt_get_pay_len(gnrc_pktsnip_t *pkt)
     return seg_len;
 }
 
-int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool retransmit)
+/**
+ * @brief Starts the retransmission timer for the oldest segment in the send queue.
+ *
+ * @param[in,out] tcb       TCB holding the connection information.
+ * @param[in]     backoff   Flag used to indicate that the timer expired before.
+ */
+static void _setup_retransmit_timer(gnrc_tcp_tcb_t *tcb, const bool backoff)
 {
-    gnrc_pktsnip_t *snp = NULL;
-    uint32_t ctl = 0;
-    uint32_t len = 0;
-
-    /* No packet received */
-    if (pkt == NULL) {
-        DEBUG("gnrc_tcp_pkt.c : _pkt_setup_retransmit() : pkt=NULL\n");
-        return -EINVAL;
-    }
-
-    /* Check if retransmit queue is full and pkt is not already in retransmit queue */
-    if (tcb->pkt_retransmit != NULL && tcb->pkt_retransmit != pkt) {
-        DEBUG("gnrc_tcp_pkt.c : _pkt_setup_retransmit() : Nothing to do\n");
-        return -ENOMEM;
-    }
-
-    /* Extract control bits and segment length */
-    LL_SEARCH_SCALAR(pkt, snp, type, GNRC_NETTYPE_TCP);
-    ctl = byteorder_ntohs(((tcp_hdr_t *) snp->data)->off_ctl);
-    len = _pkt_get_pay_len(pkt);
-
-    /* Check if pkt contains reset or is a pure ACK, return */
-    if ((ctl & MSK_RST) || (((ctl & MSK_SYN_FIN_ACK) == MSK_ACK) && len == 0)) {
-        return 0;
-    }
-
-    /* Assign pkt and increase users: every send attempt consumes a user */
-    tcb->pkt_retransmit = pkt;
-    gnrc_pktbuf_hold(pkt, 1);
-
     /* RTO adjustment */
-    if (!retransmit) {
-        /* If this is the first transmission: rto is 1 sec (Lower Bound) */
+    if (!backoff) {
+        /* If there is no measurement yet: rto is 1 sec (Lower Bound) */
         if (tcb->srtt == RTO_UNINITIALIZED || tcb->rtt_var == RTO_UNINITIALIZED) {
             tcb->rto = GNRC_TCP_RTO_LOWER_BOUND;
         }
@@ -362,38 +397,98 @@ int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool r
     tcb->msg_tout.type = MSG_TYPE_RETRANSMISSION;
     tcb->msg_tout.content.ptr = (void *) tcb;
     xtimer_set_msg(&tcb->tim_tout, tcb->rto, &tcb->msg_tout, gnrc_tcp_pid);
+}
+
+int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool retransmit)
+{
+    gnrc_pktsnip_t *snp = NULL;
+    uint32_t ctl = 0;
+    uint32_t len = 0;
+
+    /* No packet received */
+    if (pkt == NULL) {
+        DEBUG("gnrc_tcp_pkt.c : _pkt_setup_retransmit() : pkt=NULL\n");
+        return -EINVAL;
+    }
+
+    /* A retransmission always concerns the oldest segment */
+    if (retransmit) {
+        if (tcb->snd_queue_len == 0 || tcb->snd_queue[0] != pkt) {
+            DEBUG("gnrc_tcp_pkt.c : _pkt_setup_retransmit() : pkt is not queued\n");
+            return -EINVAL;
+        }
+        /* Increase users: every send attempt consumes a user */
+        gnrc_pktbuf_hold(pkt, 1);
+        _setup_retransmit_timer(tcb, true);
+        return 0;
+    }
+
+    /* Check if send queue is full */
+    if (tcb->snd_queue_len >= (sizeof(tcb->snd_queue) / sizeof(tcb->snd_queue[0]))) {
+        DEBUG("gnrc_tcp_pkt.c : _pkt_setup_retransmit() : Send queue is full\n");
+        return -ENOMEM;
+    }
+
+    /* Extract control bits and segment length */
+    LL_SEARCH_SCALAR(pkt, snp, type, GNRC_NETTYPE_TCP);
+    ctl = byteorder_ntohs(((tcp_hdr_t *) snp->data)->off_ctl);
+    len = _pkt_get_pay_len(pkt);
+
+    /* Check if pkt contains reset or is a pure ACK, return */
+    if ((ctl & MSK_RST) || (((ctl & MSK_SYN_FIN_ACK) == MSK_ACK) && len == 0)) {
+        return 0;
+    }
+
+    /* Append pkt and increase users: every send attempt consumes a user */
+    tcb->snd_queue[tcb->snd_queue_len++] = pkt;
+    gnrc_pktbuf_hold(pkt, 1);
+
+    /* The timer is already running if older segments are in flight */
+    if (tcb->snd_queue_len == 1) {
+        _setup_retransmit_timer(tcb, false);
+    }
     return 0;
 }
 
 int _pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack)
 {
     uint32_t seg = 0;
+    uint8_t acked = 0;
     gnrc_pktsnip_t *snp = NULL;
     tcp_hdr_t *hdr;
 
-    /* Retransmission queue is empty. Nothing to ACK there */
-    if (tcb->pkt_retransmit == NULL) {
+    /* Send queue is empty. Nothing to ACK there */
+    if (tcb->snd_queue_len == 0) {
         DEBUG("gnrc_tcp_pkt.c : _pkt_acknowledge() : There is no packet to ack\n");
         return -ENODATA;
     }
 
-    LL_SEARCH_SCALAR(tcb->pkt_retransmit, snp, type, GNRC_NETTYPE_TCP);
-    hdr = (tcp_hdr_t *) snp->data;
-
-    /* There must be a packet, waiting to be acknowledged. */
-    seg = byteorder_ntohl(hdr->seq_num) + _pkt_get_seg_len(tcb->pkt_retransmit) - 1;
-
-    /* If segment can be acknowledged -> stop timer, release packet from pktbuf and update rto. */
-    if (LSS_32_BIT(seg, ack)) {
-        xtimer_remove(&(tcb->tim_tout));
-        gnrc_pktbuf_release(tcb->pkt_retransmit);
-        tcb->pkt_retransmit = NULL;
+    /* Release all segments that were acknowledged completely */
+    while (acked < tcb->snd_queue_len) {
+        LL_SEARCH_SCALAR(tcb->snd_queue[acked], snp, type, GNRC_NETTYPE_TCP);
+        hdr = (tcp_hdr_t *) snp->data;
+        seg = byteorder_ntohl(hdr->seq_num) + _pkt_get_seg_len(tcb->snd_queue[acked]) - 1;
+        if (!LSS_32_BIT(seg, ack)) {
+            break;
+        }
+        gnrc_pktbuf_release(tcb->snd_queue[acked]);
+        acked++;
+    }
+    if (acked == 0) {
+        return 0;
+    }
+    tcb->snd_queue_len -= acked;
+    memmove(tcb->snd_queue, tcb->snd_queue + acked,
+            tcb->snd_queue_len * sizeof(tcb->snd_queue[0]));
+    tcb->retries = 0;
 
-        /* Measure round trip time */
+    /* Measure round trip time, if the timed segment was acknowledged */
+    if ((tcb->status & STATUS_RTT_MEASURE) && LEQ_32_BIT(tcb->rtt_seq, ack)) {
         int32_t rtt = xtimer_now().ticks32 - tcb->rtt_start;
 
-        /* Use time only if ther was no timer overflow and no retransmission (Karns Alogrithm) */
-        if (tcb->retries == 0 && rtt > 0) {
+        tcb->status &= ~STATUS_RTT_MEASURE;
+        /* Use time only if ther was no timer overflow */
+        if (rtt > 0) {
             /* If this is the first sample taken */
             if (tcb->srtt == RTO_UNINITIALIZED && tcb->rtt_var == RTO_UNINITIALIZED) {
                 tcb->srtt = rtt;
@@ -408,6 +503,12 @@ int _pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack)
             }
         }
     }
+
+    /* Restart timer for the remaining segments (see RFC 6298, section 5.3) */
+    xtimer_remove(&(tcb->tim_tout));
+    if (tcb->snd_queue_len > 0) {
+        _setup_retransmit_timer(tcb, false);
+    }
     return 0;
 }
 
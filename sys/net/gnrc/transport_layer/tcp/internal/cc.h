@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_tcp TCP
+ * @ingroup     net_gnrc
+ * @brief       RIOT's TCP implementation for the GNRC network stack.
+ *
+ * @{
+ *
+ * @file
+ * @brief       NewReno congestion control declarations (see RFC 5681 and RFC 6582).
+ */
+
+#ifndef CC_H
+#define CC_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "net/gnrc/tcp/config.h"
+#include "net/gnrc/tcp/tcb.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief MSS assumed if the peer did not send a MSS option (see RFC 1122).
+ */
+#define CC_DEFAULT_SMSS (536U)
+
+/**
+ * @brief Calculates the maximum size of an outgoing segment (SMSS).
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   The smaller one of the peers MSS and GNRC_TCP_MSS.
+ */
+inline static uint32_t _cc_smss(const gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t mss = (tcb->mss > 0) ? tcb->mss : CC_DEFAULT_SMSS;
+
+    return (mss < GNRC_TCP_MSS) ? mss : GNRC_TCP_MSS;
+}
+
+/**
+ * @brief Initializes the congestion control state of an established connection.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _cc_init(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Calculates the number of bytes that may be sent right now.
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   The part of min(cwnd, snd_wnd) that is not in flight.
+ */
+uint32_t _cc_usable_window(const gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Updates the congestion window after new data was acknowledged.
+ *
+ * @pre snd_una was already advanced over the acknowledged data.
+ *
+ * @param[in,out] tcb     TCB holding the connection information.
+ * @param[in]     acked   Number of newly acknowledged bytes.
+ *
+ * @returns   true, if the first unacknowledged segment must be retransmitted.
+ *            false otherwise.
+ */
+bool _cc_ack(gnrc_tcp_tcb_t *tcb, uint32_t acked);
+
+/**
+ * @brief Updates the congestion window after a duplicate ACK was received.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ *
+ * @returns   true, if the first unacknowledged segment must be retransmitted (fast retransmit).
+ *            false otherwise.
+ */
+bool _cc_dup_ack(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Updates the congestion window after the retransmission timer expired.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _cc_timeout(gnrc_tcp_tcb_t *tcb);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CC_H */
+/** @} */
@@ -27,6 +27,7 @@
 #include "kernel_types.h"
 #include "thread.h"
 #include "mutex.h"
+#include "mbox.h"
 #include "net/gnrc/netapi.h"
 #include "net/gnrc/tcp/tcb.h"
 
@@ -49,6 +50,9 @@ extern "C" {
 #define STATUS_ALLOW_ANY_ADDR (1 << 1)
 #define STATUS_NOTIFY_USER    (1 << 2)
 #define STATUS_WAIT_FOR_MSG   (1 << 3)
+#define STATUS_FAST_RECOVERY  (1 << 4)
+#define STATUS_RTT_MEASURE    (1 << 5)
+#define STATUS_ACCEPTED       (1 << 6)
 /** @} */
 
 /**
@@ -91,6 +95,37 @@ extern "C" {
 #define MSG_TYPE_NOTIFY_USER        (GNRC_NETAPI_MSG_TYPE_ACK + 106)
 /** @} */
 
+/**
+ * @brief Thread blocked in gnrc_tcp_accept(), linked into the listening queue.
+ *
+ * Every waiting thread gets its own mbox, so that a wake-up or a timeout can't
+ * be consumed by another thread accepting on the same queue.
+ */
+typedef struct _tcb_queue_waiter {
+    struct _tcb_queue_waiter *next;   /**< Next thread waiting on the queue */
+    msg_t mbox_raw[1];                /**< Msg queue for mbox, one wake-up is enough */
+    mbox_t mbox;                      /**< Mbox the thread waits on */
+    volatile uint8_t timed_out;       /**< Set when the user timeout expired */
+} queue_waiter_t;
+
+/**
+ * @brief Wakes up all threads waiting for connections of a listening queue.
+ *
+ * @param[in] queue   Listening queue whose TCBs changed.
+ */
+static inline void _queue_wakeup(gnrc_tcp_tcb_queue_t *queue)
+{
+    msg_t msg;
+    msg.type = MSG_TYPE_NOTIFY_USER;
+
+    mutex_lock(&(queue->waiters_lock));
+    for (queue_waiter_t *waiter = queue->waiters; waiter; waiter = waiter->next) {
+        /* If the mbox is full, a wake-up is pending anyway */
+        mbox_try_put(&(waiter->mbox), &msg);
+    }
+    mutex_unlock(&(queue->waiters_lock));
+}
+
 /**
  * @brief Define for marking that time measurement is uninitialized.
  */
@@ -104,7 +139,7 @@ extern "C" {
 #define LSS_32_BIT(x, y) (((int32_t) (x)) - ((int32_t) (y)) <  0)
 #define LEQ_32_BIT(x, y) (((int32_t) (x)) - ((int32_t) (y)) <= 0)
 #define GRT_32_BIT(x, y) (!LEQ_32_BIT(x, y))
-#define GEQ_32_BIT(x, y) (!LSS_32_BOT(x, y))
+#define GEQ_32_BIT(x, y) (!LSS_32_BIT(x, y))
 /** @} */
 
 /**
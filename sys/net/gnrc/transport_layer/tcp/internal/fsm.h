@@ -24,6 +24,7 @@
 
 #include <stdint.h>
 #include "net/gnrc/pkt.h"
+#include "net/gnrc/pktbuf.h"
 #include "net/gnrc/tcp/tcb.h"
 
 #ifdef __cplusplus
@@ -53,6 +54,7 @@ typedef enum {
 typedef enum {
     FSM_EVENT_CALL_OPEN,          /* User function call: open */
     FSM_EVENT_CALL_SEND,          /* User function call: send */
+    FSM_EVENT_CALL_SEND_EXT,      /* User function call: send without copying */
     FSM_EVENT_CALL_RECV,          /* User function call: recv */
     FSM_EVENT_CALL_CLOSE,         /* User function call: close */
     FSM_EVENT_CALL_ABORT,         /* User function call: abort */
@@ -64,6 +66,15 @@ typedef enum {
     FSM_EVENT_CLEAR_RETRANSMIT    /* Clear retransmission mechanism */
 } fsm_event_t;
 
+/**
+ * @brief Buffer argument of FSM_EVENT_CALL_SEND_EXT.
+ */
+typedef struct {
+    const void *data;         /* Data to send, referenced by the sent segments */
+    gnrc_pktbuf_ext_cb_t cb;  /* Called for each segment when it was released */
+    void *arg;                /* Argument for cb */
+} fsm_send_ext_t;
+
 /**
  * @brief TCP finite state maschine
  *
@@ -24,6 +24,7 @@
 
 #include <stdint.h>
 #include "net/gnrc/pkt.h"
+#include "net/gnrc/pktbuf.h"
 #include "net/gnrc/tcp/tcb.h"
 
 #ifdef __cplusplus
@@ -63,6 +64,31 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
                const uint16_t ctl, const uint32_t seq_num, const uint32_t ack_num,
                void *payload, const size_t payload_len);
 
+/**
+ * @brief Build and allocate a TCB paket whose payload references @p payload.
+ *
+ * @p payload is not copied into the packet buffer and must stay unchanged
+ * until @p cb was called.
+ *
+ * @param[in,out] tcb           TCB holding the connection information.
+ * @param[out]    out_pkt       Pointer to paket to build.
+ * @param[out]    seq_con       Sequence number consumption of built packet.
+ * @param[in]     ctl           Control bits to set in @p out_pkt.
+ * @param[in]     seq_num       Sequence number of the new packet.
+ * @param[in]     ack_num       Acknowledgment number of the new packet.
+ * @param[in]     payload       Pointer to payload buffer. Must not be NULL.
+ * @param[in]     payload_len   Payload size. Must not be zero.
+ * @param[in]     cb            Called when the payload is no longer referenced.
+ * @param[in]     arg           Argument for @p cb.
+ *
+ * @returns   Zero on success.
+ *            -ENOMEM if pktbuf is full.
+ */
+int _pkt_build_ext(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
+                   const uint16_t ctl, const uint32_t seq_num, const uint32_t ack_num,
+                   const void *payload, const size_t payload_len,
+                   gnrc_pktbuf_ext_cb_t cb, void *arg);
+
 /**
  * @brief Sends packet to peer.
  *
@@ -110,18 +136,25 @@ uint32_t _pkt_get_pay_len(gnrc_pktsnip_t *pkt);
 /**
  * @brief Adds a packet to the retransmission mechanism.
  *
+ * @note The packet is appended to the send queue of @p tcb. The retransmission timer
+ *       always covers the oldest segment in the send queue.
+ *
  * @param[in,out] tcb          TCB holding the connection information.
  * @param[in]     pkt          Packet to add to the retransmission mechanism.
- * @param[in]     retransmit   Flag used to indicate that @p pkt is a retransmit.
+ * @param[in]     retransmit   Flag used to indicate that @p pkt is a retransmit
+ *                             after a timeout. @p pkt must be the oldest segment then.
  *
  * @returns   Zero on success.
- *            -ENOMEM if the retransmission queue is full.
- *            -EINVAL if pkt is null.
+ *            -ENOMEM if the send queue is full.
+ *            -EINVAL if pkt is null or is a retransmit that is not the oldest segment.
  */
 int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool retransmit);
 
 /**
- * @brief Acknowledges and removes packet from the retransmission mechanism.
+ * @brief Acknowledges and removes packets from the retransmission mechanism.
+ *
+ * @note Releases all segments covered by @p ack and restarts the retransmission timer
+ *       if segments are left in the send queue.
  *
  * @param[in,out] tcb   TCB holding the connection information.
  * @param[in]     ack   Acknowldegment number used to acknowledge packets.
@@ -17,6 +17,7 @@
  * @}
  */
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <errno.h>
 
@@ -33,6 +34,25 @@
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+#ifdef MODULE_GNRC_NETAPI_INLINE
+static void _netapi_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx);
+
+/**
+ * @brief   Callback for UDP, run by the stack thread
+ */
+static gnrc_netreg_entry_cbd_t _netapi_cbd = { _netapi_cb, NULL };
+
+/**
+ * @brief   Registry entry of UDP
+ */
+static gnrc_netreg_entry_t _netapi_reg = GNRC_NETREG_ENTRY_INIT_CB(GNRC_NETREG_DEMUX_CTX_ALL,
+                                                                   &_netapi_cbd);
+
+/**
+ * @brief   Save if UDP was registered already
+ */
+static bool _registered = false;
+#else
 /**
  * @brief   Save the UDP's thread PID for later reference
  */
@@ -46,6 +66,7 @@ static char _stack[GNRC_UDP_STACK_SIZE + THREAD_EXTRA_STACKSIZE_PRINTF];
 #else
 static char _stack[GNRC_UDP_STACK_SIZE];
 #endif
+#endif
 
 /**
  * @brief   Calculate the UDP checksum dependent on the network protocol
@@ -217,6 +238,18 @@ static void _send(gnrc_pktsnip_t *pkt)
     }
 }
 
+#ifdef MODULE_GNRC_NETAPI_INLINE
+static void _netapi_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    (void)ctx;
+    if (cmd == GNRC_NETAPI_MSG_TYPE_RCV) {
+        _receive(pkt);
+    }
+    else {
+        _send(pkt);
+    }
+}
+#else
 static void *_event_loop(void *arg)
 {
     (void)arg;
@@ -257,6 +290,7 @@ static void *_event_loop(void *arg)
     /* never reached */
     return NULL;
 }
+#endif
 
 int gnrc_udp_calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr)
 {
@@ -298,6 +332,15 @@ gnrc_pktsnip_t *gnrc_udp_hdr_build(gnrc_pktsnip_t *payload, uint16_t src,
 
 int gnrc_udp_init(void)
 {
+#ifdef MODULE_GNRC_NETAPI_INLINE
+    /* check if UDP is already registered */
+    if (!_registered) {
+        /* register UPD at netreg */
+        gnrc_netreg_register(GNRC_NETTYPE_UDP, &_netapi_reg);
+        _registered = true;
+    }
+    return KERNEL_PID_UNDEF;
+#else
     /* check if thread is already running */
     if (_pid == KERNEL_PID_UNDEF) {
         /* start UDP thread */
@@ -305,4 +348,5 @@ int gnrc_udp_init(void)
                              THREAD_CREATE_STACKTEST, _event_loop, NULL, "udp");
     }
     return _pid;
+#endif
 }
@@ -30,6 +30,8 @@
 #include "xtimer.h"
 #include "timex.h"
 #include "utlist.h"
+#include "bitarithm.h"
+#include "assert.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -37,6 +39,10 @@
 #include "net/fib.h"
 #include "net/fib/table.h"
 
+#ifdef MODULE_GNRC_IPV6_FLOWC
+#include "net/gnrc/ipv6/flowc.h"
+#endif
+
 #ifdef MODULE_IPV6_ADDR
 #include "net/ipv6/addr.h"
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
@@ -65,6 +71,443 @@ static void fib_lifetime_to_absolute(uint32_t ms, uint64_t *target)
     *target = xtimer_now_usec64() + (ms * US_PER_MS);
 }
 
+/**
+ * @brief invalidates caches holding results of previous lookups
+ */
+static inline void fib_invalidate_caches(void)
+{
+#ifdef MODULE_GNRC_IPV6_FLOWC
+    gnrc_ipv6_flowc_invalidate();
+#endif
+}
+
+static int fib_remove(fib_table_t *table, fib_entry_t *entry);
+
+/**
+ * @name Longest-prefix-match trie
+ *
+ * Single hop tables index their entries in a path-compressed binary trie
+ * (a PATRICIA trie), so a lookup takes at most one step per address bit
+ * instead of one per table entry. The key of an entry is its address size
+ * as first byte followed by its address, cut to the prefix length of the
+ * entry. Nodes are stored within the entries, see @ref fib_trie_node_t.
+ * @{
+ */
+
+/**
+ * @brief bits of the key that encode the address size
+ */
+#define FIB_KEY_SIZE_BITS           (8U)
+
+/**
+ * @brief returns the bit at position @p bit of the key of an address
+ */
+static inline unsigned fib_key_bit(size_t size, const uint8_t *addr, unsigned bit)
+{
+    if (bit < FIB_KEY_SIZE_BITS) {
+        return (size >> (7 - bit)) & 0x01;
+    }
+    bit -= FIB_KEY_SIZE_BITS;
+    return (addr[bit >> 3] >> (7 - (bit & 0x07))) & 0x01;
+}
+
+/**
+ * @brief returns the first bit in which the keys of two addresses differ
+ *
+ * @param[in] limit the number of bits to compare, must not exceed the key
+ *                  length of any of the addresses
+ *
+ * @return the position of the first distinct bit, @p limit if the keys
+ *         are equal up to @p limit
+ */
+static unsigned fib_key_diff(size_t size_a, const uint8_t *a,
+                             size_t size_b, const uint8_t *b, unsigned limit)
+{
+    unsigned bit;
+
+    if (size_a != size_b) {
+        bit = 7 - bitarithm_msb((size_a ^ size_b) & 0xff);
+        return (bit < limit) ? bit : limit;
+    }
+    for (size_t i = 0; (bit = FIB_KEY_SIZE_BITS + (i << 3)) < limit; i++) {
+        uint8_t diff = a[i] ^ b[i];
+
+        if (diff != 0) {
+            bit += 7 - bitarithm_msb(diff);
+            return (bit < limit) ? bit : limit;
+        }
+    }
+    return limit;
+}
+
+/**
+ * @brief returns the length of the key of an entry in bits
+ */
+static unsigned fib_entry_key_len(fib_entry_t *entry)
+{
+    universal_address_container_t *global = entry->global;
+    unsigned addr_bits = (unsigned)global->address_size << 3;
+    unsigned len = FIB_KEY_SIZE_BITS;
+
+    for (size_t i = 0; i < global->address_size; i++) {
+        if (global->address[i] != 0) {
+            if (entry->global_flags & FIB_FLAG_NET_PREFIX_MASK) {
+                unsigned prefix = (entry->global_flags & FIB_FLAG_NET_PREFIX_MASK)
+                                  >> FIB_FLAG_NET_PREFIX_SHIFT;
+
+                len += (prefix < addr_bits) ? prefix : addr_bits;
+            }
+            else {
+                len += addr_bits;
+            }
+            break;
+        }
+    }
+    /* all zero addresses are default routes and match any address of the
+     * same size */
+    return len;
+}
+
+static inline fib_trie_node_t *fib_node(fib_table_t *table, uint16_t id)
+{
+    return (id > table->size) ? &table->data.entries[id - table->size - 1].glue :
+                                &table->data.entries[id - 1].node;
+}
+
+static inline fib_entry_t *fib_node_entry(fib_table_t *table, uint16_t id)
+{
+    return (id > table->size) ? NULL : &table->data.entries[id - 1];
+}
+
+static inline uint16_t fib_entry_id(fib_table_t *table, fib_entry_t *entry)
+{
+    return (uint16_t)(entry - table->data.entries) + 1;
+}
+
+/**
+ * @brief returns an entry of the sub-trie at @p id, representing the bits
+ *        of the key shared by all entries in that sub-trie
+ */
+static fib_entry_t *fib_trie_rep(fib_table_t *table, uint16_t id)
+{
+    /* glue nodes always have two children */
+    while (id > table->size) {
+        id = fib_node(table, id)->child[0];
+    }
+    return fib_node_entry(table, id);
+}
+
+/**
+ * @brief replaces node @p old with @p new (may be 0) in the link of its parent
+ */
+static void fib_trie_replace(fib_table_t *table, uint16_t old, uint16_t new)
+{
+    uint16_t parent = fib_node(table, old)->parent;
+
+    if (parent == 0) {
+        table->trie_root = new;
+    }
+    else {
+        fib_trie_node_t *p = fib_node(table, parent);
+
+        p->child[(p->child[0] == old) ? 0 : 1] = new;
+    }
+    if (new != 0) {
+        fib_node(table, new)->parent = parent;
+    }
+}
+
+/**
+ * @brief sets the parent of the children of node @p id to @p id
+ */
+static void fib_trie_adopt(fib_table_t *table, uint16_t id)
+{
+    fib_trie_node_t *node = fib_node(table, id);
+
+    for (unsigned i = 0; i < 2; i++) {
+        if (node->child[i] != 0) {
+            fib_node(table, node->child[i])->parent = id;
+        }
+    }
+}
+
+static uint16_t fib_glue_alloc(fib_table_t *table)
+{
+    uint16_t id = table->glue_free;
+
+    if (id != 0) {
+        table->glue_free = fib_node(table, id)->child[0];
+    }
+    else {
+        /* there are never more glue nodes than entries */
+        id = table->size + (++table->glue_used);
+    }
+    return id;
+}
+
+static void fib_glue_free(fib_table_t *table, uint16_t id)
+{
+    fib_node(table, id)->child[0] = table->glue_free;
+    table->glue_free = id;
+}
+
+/**
+ * @brief adds an entry to the trie
+ *
+ * @pre @p entry has a valid fib_entry_t::global
+ */
+static void fib_trie_insert(fib_table_t *table, fib_entry_t *entry)
+{
+    const uint8_t *key = entry->global->address;
+    size_t key_size = entry->global->address_size;
+    unsigned len = fib_entry_key_len(entry);
+    uint16_t id = fib_entry_id(table, entry);
+    uint16_t parent = 0, cur = table->trie_root;
+    fib_trie_node_t *node;
+    fib_entry_t *rep;
+    unsigned diff, rep_len;
+
+    memset(&entry->node, 0, sizeof(entry->node));
+    entry->node.bit = len;
+    entry->dup = 0;
+    if (cur == 0) {
+        table->trie_root = id;
+        return;
+    }
+    /* find the entries closest to the new key ... */
+    while ((node = fib_node(table, cur))->bit < len) {
+        uint16_t next = node->child[fib_key_bit(key_size, key, node->bit)];
+
+        if (next == 0) {
+            break;
+        }
+        cur = next;
+    }
+    rep = fib_trie_rep(table, cur);
+    rep_len = rep->node.bit;
+    /* ... to learn where the new key branches off */
+    diff = fib_key_diff(key_size, key, rep->global->address_size,
+                        rep->global->address, (len < rep_len) ? len : rep_len);
+    cur = table->trie_root;
+    while ((cur != 0) && ((node = fib_node(table, cur))->bit < diff)) {
+        parent = cur;
+        cur = node->child[fib_key_bit(key_size, key, node->bit)];
+    }
+    if (cur == 0) {
+        /* new leaf */
+        node = fib_node(table, parent);
+        node->child[fib_key_bit(key_size, key, node->bit)] = id;
+        entry->node.parent = parent;
+    }
+    else if (node->bit == diff) {
+        if (diff < len) {
+            /* new leaf below an entry with a shorter prefix */
+            node->child[fib_key_bit(key_size, key, diff)] = id;
+            entry->node.parent = cur;
+        }
+        else if (cur > table->size) {
+            /* the new entry takes the place of a glue node */
+            entry->node = *node;
+            fib_trie_replace(table, cur, id);
+            fib_trie_adopt(table, id);
+            fib_glue_free(table, cur);
+        }
+        else {
+            /* same prefix as an entry in the trie, queue behind it */
+            fib_entry_t *head = fib_node_entry(table, cur);
+
+            entry->node.bit = 0;
+            entry->node.parent = cur;
+            entry->dup = head->dup;
+            head->dup = id;
+        }
+    }
+    else {
+        rep = fib_trie_rep(table, cur);
+        unsigned rep_bit = fib_key_bit(rep->global->address_size,
+                                       rep->global->address, diff);
+
+        fib_trie_replace(table, cur, id);
+        if (diff == len) {
+            /* new inner node above a longer prefix */
+            entry->node.child[rep_bit] = cur;
+            node->parent = id;
+        }
+        else {
+            /* new glue node where the keys branch */
+            uint16_t glue = fib_glue_alloc(table);
+            fib_trie_node_t *g = fib_node(table, glue);
+
+            g->bit = diff;
+            g->child[rep_bit] = cur;
+            g->child[!rep_bit] = id;
+            fib_trie_replace(table, id, glue);
+            fib_trie_adopt(table, glue);
+        }
+    }
+}
+
+/**
+ * @brief removes an entry from the trie
+ */
+static void fib_trie_remove(fib_table_t *table, fib_entry_t *entry)
+{
+    uint16_t id = fib_entry_id(table, entry);
+    fib_trie_node_t *node = &entry->node;
+
+    if (node->bit == 0) {
+        /* queued behind an entry with the same prefix */
+        fib_entry_t *prev = fib_node_entry(table, node->parent);
+
+        while (prev->dup != id) {
+            prev = &table->data.entries[prev->dup - 1];
+        }
+        prev->dup = entry->dup;
+    }
+    else if (entry->dup != 0) {
+        /* the next entry with the same prefix takes over */
+        uint16_t next = entry->dup;
+        fib_entry_t *succ = &table->data.entries[next - 1];
+
+        succ->node = *node;
+        fib_trie_replace(table, id, next);
+        fib_trie_adopt(table, next);
+        for (uint16_t dup = succ->dup; dup != 0;
+             dup = table->data.entries[dup - 1].dup) {
+            table->data.entries[dup - 1].node.parent = next;
+        }
+    }
+    else if ((node->child[0] != 0) && (node->child[1] != 0)) {
+        /* still needed for branching */
+        uint16_t glue = fib_glue_alloc(table);
+
+        *fib_node(table, glue) = *node;
+        fib_trie_replace(table, id, glue);
+        fib_trie_adopt(table, glue);
+    }
+    else if ((node->child[0] != 0) || (node->child[1] != 0)) {
+        fib_trie_replace(table, id, node->child[(node->child[0] != 0) ? 0 : 1]);
+    }
+    else {
+        uint16_t parent = node->parent;
+
+        fib_trie_replace(table, id, 0);
+        if (parent > table->size) {
+            /* glue nodes with a single child are superfluous */
+            fib_trie_node_t *g = fib_node(table, parent);
+
+            fib_trie_replace(table, parent, g->child[(g->child[0] != 0) ? 0 : 1]);
+            fib_glue_free(table, parent);
+        }
+    }
+    entry->dup = 0;
+    memset(node, 0, sizeof(*node));
+}
+
+/** @} */
+
+/**
+ * @name Expiry heap
+ *
+ * Entries with a finite lifetime are kept in a binary min-heap ordered by
+ * the time they expire, so expired entries are found without looking at
+ * every entry of the table. The heap array is distributed over the
+ * fib_entry_t::heap fields of the table.
+ * @{
+ */
+
+static inline uint64_t fib_heap_lifetime(fib_table_t *table, unsigned pos)
+{
+    return table->data.entries[table->data.entries[pos].heap - 1].lifetime;
+}
+
+static inline void fib_heap_set(fib_table_t *table, unsigned pos, uint16_t id)
+{
+    table->data.entries[pos].heap = id;
+    table->data.entries[id - 1].heap_pos = pos + 1;
+}
+
+static void fib_heap_sift(fib_table_t *table, unsigned pos)
+{
+    uint16_t id = table->data.entries[pos].heap;
+    uint64_t lifetime = table->data.entries[id - 1].lifetime;
+
+    /* up ... */
+    while ((pos > 0) && (fib_heap_lifetime(table, (pos - 1) >> 1) > lifetime)) {
+        fib_heap_set(table, pos, table->data.entries[(pos - 1) >> 1].heap);
+        pos = (pos - 1) >> 1;
+    }
+    /* ... or down */
+    while (((pos << 1) + 1) < table->heap_len) {
+        unsigned child = (pos << 1) + 1;
+
+        if (((child + 1) < table->heap_len) &&
+            (fib_heap_lifetime(table, child + 1) < fib_heap_lifetime(table, child))) {
+            child++;
+        }
+        if (fib_heap_lifetime(table, child) >= lifetime) {
+            break;
+        }
+        fib_heap_set(table, pos, table->data.entries[child].heap);
+        pos = child;
+    }
+    fib_heap_set(table, pos, id);
+}
+
+static void fib_heap_add(fib_table_t *table, fib_entry_t *entry)
+{
+    fib_heap_set(table, table->heap_len++, fib_entry_id(table, entry));
+    fib_heap_sift(table, table->heap_len - 1);
+}
+
+static void fib_heap_rem(fib_table_t *table, fib_entry_t *entry)
+{
+    unsigned pos = entry->heap_pos - 1;
+
+    entry->heap_pos = 0;
+    if (pos != --table->heap_len) {
+        fib_heap_set(table, pos, table->data.entries[table->heap_len].heap);
+        fib_heap_sift(table, pos);
+    }
+}
+
+/**
+ * @brief adds or removes an entry to or from the expiry heap after its
+ *        lifetime was set
+ */
+static void fib_heap_upd(fib_table_t *table, fib_entry_t *entry)
+{
+    if (entry->lifetime == FIB_LIFETIME_NO_EXPIRE) {
+        if (entry->heap_pos != 0) {
+            fib_heap_rem(table, entry);
+        }
+    }
+    else if (entry->heap_pos != 0) {
+        fib_heap_sift(table, entry->heap_pos - 1);
+    }
+    else {
+        fib_heap_add(table, entry);
+    }
+}
+
+/**
+ * @brief removes all entries whose lifetime expired
+ */
+static void fib_expire(fib_table_t *table)
+{
+    uint64_t now;
+
+    if (table->heap_len == 0) {
+        return;
+    }
+    now = xtimer_now_usec64();
+    while ((table->heap_len > 0) && (fib_heap_lifetime(table, 0) < now)) {
+        fib_remove(table, &table->data.entries[table->data.entries[0].heap - 1]);
+    }
+}
+
+/** @} */
+
 /**
  * @brief returns pointer to the entry for the given destination address
  *
@@ -81,13 +524,10 @@ static void fib_lifetime_to_absolute(uint32_t ms, uint64_t *target)
  */
 static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
                           fib_entry_t **entry_arr, size_t *entry_arr_size) {
-    uint64_t now = xtimer_now_usec64();
-
+    unsigned dst_len = FIB_KEY_SIZE_BITS + (dst_size << 3);
+    uint16_t cur;
     size_t count = 0;
-    size_t prefix_size = 0;
-    size_t match_size = dst_size << 3;
     int ret = -EHOSTUNREACH;
-    bool is_all_zeros_addr = true;
 
 #if ENABLE_DEBUG
     DEBUG("[fib_find_entry] dst =");
@@ -97,82 +537,43 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
     DEBUG("\n");
 #endif
 
-    for (size_t i = 0; i < dst_size; ++i) {
-        if (dst[i] != 0) {
-            is_all_zeros_addr = false;
-            break;
-        }
-    }
+    fib_expire(table);
+    cur = (dst_size <= UNIVERSAL_ADDRESS_SIZE) ? table->trie_root : 0;
 
-    for (size_t i = 0; i < table->size; ++i) {
+    /* every entry on the path down the trie whose key matches is a prefix
+     * of dst, the last one is the longest */
+    while (cur != 0) {
+        fib_trie_node_t *node = fib_node(table, cur);
+        fib_entry_t *entry = fib_node_entry(table, cur);
 
-        /* autoinvalidate if the entry lifetime is not set to not expire */
-        if (table->data.entries[i].lifetime != FIB_LIFETIME_NO_EXPIRE) {
-
-            /* check if the lifetime expired */
-            if (table->data.entries[i].lifetime < now) {
-                /* remove this entry if its lifetime expired */
-                table->data.entries[i].lifetime = 0;
-                table->data.entries[i].global_flags = 0;
-                table->data.entries[i].next_hop_flags = 0;
-                table->data.entries[i].iface_id = KERNEL_PID_UNDEF;
-
-                if (table->data.entries[i].global != NULL) {
-                    universal_address_rem(table->data.entries[i].global);
-                    table->data.entries[i].global = NULL;
-                }
-
-                if (table->data.entries[i].next_hop != NULL) {
-                    universal_address_rem(table->data.entries[i].next_hop);
-                    table->data.entries[i].next_hop = NULL;
-                }
-            }
+        if (node->bit > dst_len) {
+            break;
         }
-
-        if ((prefix_size < (dst_size<<3)) && (table->data.entries[i].global != NULL)) {
-
-            int ret_comp = universal_address_compare(table->data.entries[i].global, dst, &match_size);
-            /* If we found an exact match */
-            if ((ret_comp == UNIVERSAL_ADDRESS_EQUAL)
-                || (is_all_zeros_addr && (ret_comp == UNIVERSAL_ADDRESS_IS_ALL_ZERO_ADDRESS))) {
-                entry_arr[0] = &(table->data.entries[i]);
-                *entry_arr_size = 1;
-                /* we will not find a better one so we return */
-                return 1;
+        if (entry != NULL) {
+            if (fib_key_diff(entry->global->address_size, entry->global->address,
+                             dst_size, dst, node->bit) != node->bit) {
+                /* all entries below extend this key */
+                break;
             }
-            else {
-                /* we try to find the most fitting prefix */
-                if (ret_comp == UNIVERSAL_ADDRESS_MATCHING_PREFIX) {
-                    if (table->data.entries[i].global_flags & FIB_FLAG_NET_PREFIX_MASK) {
-                        /* we shift the most upper flag byte back to get the number of prefix bits */
-                        size_t global_prefix_len = (table->data.entries[i].global_flags
-                                                    & FIB_FLAG_NET_PREFIX_MASK) >> FIB_FLAG_NET_PREFIX_SHIFT;
-
-                        if ((match_size >= global_prefix_len) &&
-                            ((prefix_size == 0) || (match_size > prefix_size))) {
-                            entry_arr[0] = &(table->data.entries[i]);
-                            /* we could find a better one so we move on */
-                            ret = 0;
-
-                            prefix_size = match_size;
-                            count = 1;
-                        }
-                    }
-                 }
-                 else if (ret_comp == UNIVERSAL_ADDRESS_IS_ALL_ZERO_ADDRESS) {
-                    /* we found the default gateway entry, e.g. ::/0 for IPv6
-                     * and we keep it only if there is no better one
-                     */
-                    if (prefix_size == 0) {
-                        entry_arr[0] = &(table->data.entries[i]);
-                        /* we could find a better one so we move on */
-                        ret = 0;
-                        count = 1;
-                    }
+            entry_arr[0] = entry;
+            ret = 0;
+            count = 1;
+            /* entries with the same prefix may still hold dst itself */
+            for (; entry != NULL; entry = (entry->dup != 0) ?
+                 &table->data.entries[entry->dup - 1] : NULL) {
+                if ((entry->global->address_size == dst_size) &&
+                    (memcmp(entry->global->address, dst, dst_size) == 0)) {
+                    entry_arr[0] = entry;
+                    *entry_arr_size = 1;
+                    /* we will not find a better one so we return */
+                    return 1;
                 }
-                match_size = dst_size<<3;
             }
         }
+        if (node->bit == dst_len) {
+            break;
+        }
+        cur = node->child[fib_key_bit(dst_size, dst, node->bit)];
     }
 
 #if ENABLE_DEBUG
@@ -192,6 +593,7 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
 /**
  * @brief updates the next hop the lifetime and the interface id for a given entry
  *
+ * @param[in] table          the FIB table the entry belongs to
  * @param[in] entry          the entry to be updated
  * @param[in] next_hop       the next hop address to be updated
  * @param[in] next_hop_size  the next hop address size
@@ -201,9 +603,9 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
  * @return 0 if the entry has been updated
  *         -ENOMEM if the entry cannot be updated due to insufficient RAM
  */
-static int fib_upd_entry(fib_entry_t *entry, uint8_t *next_hop,
-                         size_t next_hop_size, uint32_t next_hop_flags,
-                         uint32_t lifetime)
+static int fib_upd_entry(fib_table_t *table, fib_entry_t *entry,
+                         uint8_t *next_hop, size_t next_hop_size,
+                         uint32_t next_hop_flags, uint32_t lifetime)
 {
     universal_address_container_t *container = universal_address_add(next_hop, next_hop_size);
 
@@ -211,6 +613,10 @@ static int fib_upd_entry(fib_entry_t *entry, uint8_t *next_hop,
         return -ENOMEM;
     }
 
+    /* a mere lifetime refresh keeps the container */
+    if ((container != entry->next_hop) || (next_hop_flags != entry->next_hop_flags)) {
+        fib_invalidate_caches();
+    }
     universal_address_rem(entry->next_hop);
     entry->next_hop = container;
     entry->next_hop_flags = next_hop_flags;
@@ -221,6 +627,7 @@ static int fib_upd_entry(fib_entry_t *entry, uint8_t *next_hop,
     else {
         entry->lifetime = FIB_LIFETIME_NO_EXPIRE;
     }
+    fib_heap_upd(table, entry);
 
     return 0;
 }
@@ -267,6 +674,9 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
                 else {
                     table->data.entries[i].lifetime = FIB_LIFETIME_NO_EXPIRE;
                 }
+                fib_trie_insert(table, &table->data.entries[i]);
+                fib_heap_upd(table, &table->data.entries[i]);
+                fib_invalidate_caches();
 
                 return 0;
             }
@@ -279,12 +689,20 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
 /**
  * @brief removes the given entry
  *
+ * @param[in] table the FIB table the entry belongs to
  * @param[in] entry the entry to be removed
  *
  * @return 0 on success
  */
-static int fib_remove(fib_entry_t *entry)
+static int fib_remove(fib_table_t *table, fib_entry_t *entry)
 {
+    if (entry->lifetime != 0) {
+        fib_trie_remove(table, entry);
+        if (entry->heap_pos != 0) {
+            fib_heap_rem(table, entry);
+        }
+    }
+
     if (entry->global != NULL) {
         universal_address_rem(entry->global);
     }
@@ -300,6 +718,7 @@ static int fib_remove(fib_entry_t *entry)
 
     entry->iface_id = KERNEL_PID_UNDEF;
     entry->lifetime = 0;
+    fib_invalidate_caches();
 
     return 0;
 }
@@ -403,7 +822,7 @@ int fib_add_entry(fib_table_t *table,
 
     if (ret == 1) {
         /* we must take the according entry and update the values */
-        ret = fib_upd_entry(entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
+        ret = fib_upd_entry(table, entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
     }
     else {
         ret = fib_create_entry(table, iface_id, dst, dst_size, dst_flags,
@@ -433,7 +852,7 @@ int fib_update_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
     if (fib_find_entry(table, dst, dst_size, &(entry[0]), &count) == 1) {
         DEBUG("[fib_update_entry] found entry: %p\n", (void *)(entry[0]));
         /* we must take the according entry and update the values */
-        ret = fib_upd_entry(entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
+        ret = fib_upd_entry(table, entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
     }
     else {
         /* we have ambiguous entries, i.e. count > 1
@@ -457,7 +876,7 @@ void fib_remove_entry(fib_table_t *table, uint8_t *dst, size_t dst_size)
 
     if (ret == 1) {
         /* we must take the according entry and update the values */
-        fib_remove(entry[0]);
+        fib_remove(table, entry[0]);
     }
     else {
         /* we have ambiguous entries, i.e. count > 1
@@ -477,7 +896,7 @@ void fib_flush(fib_table_t *table, kernel_pid_t interface)
     for (size_t i = 0; i < table->size; ++i) {
         if ((interface == KERNEL_PID_UNDEF) ||
             (interface == table->data.entries[i].iface_id)) {
-            fib_remove(&table->data.entries[i]);
+            fib_remove(table, &table->data.entries[i]);
         }
     }
 
@@ -595,8 +1014,13 @@ void fib_init(fib_table_t *table)
                sizeof(fib_sr_entry_t) * table->data.source_routes->entry_pool_size);
     }
     else {
+        assert(table->size <= 0x7fff);
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
     }
+    table->trie_root = 0;
+    table->glue_free = 0;
+    table->glue_used = 0;
+    table->heap_len = 0;
     universal_address_init();
     mutex_unlock(&(table->mtx_access));
 }
@@ -622,6 +1046,10 @@ void fib_deinit(fib_table_t *table)
     else {
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
     }
+    table->trie_root = 0;
+    table->glue_free = 0;
+    table->glue_used = 0;
+    table->heap_len = 0;
     universal_address_reset();
     mutex_unlock(&(table->mtx_access));
 }
@@ -15,6 +15,7 @@
  * @}
  */
 
+#include <stdbool.h>
 #include <stdio.h>
 
 #include "thread.h"
@@ -45,6 +46,33 @@ static const char *state_names[] = {
     [STATUS_MBOX_BLOCKED] = "bl mbox",
 };
 
+#ifdef MODULE_SCHEDSTATISTICS
+/**
+ * @brief Prints one of the histograms of sched_pidlist for all threads.
+ */
+static void _print_hist(const char *name, bool slices)
+{
+    printf("\n\t%s [us]\n\tpid ", name);
+    for (unsigned b = 0; b < SCHEDSTAT_HIST_NUMOF; b++) {
+        printf("| >=%-7lu", (unsigned long)sched_hist_bucket_min(b));
+    }
+    puts("");
+
+    for (kernel_pid_t i = KERNEL_PID_FIRST; i <= KERNEL_PID_LAST; i++) {
+        if (sched_threads[i] == NULL) {
+            continue;
+        }
+        const uint32_t *hist = slices ? sched_pidlist[i].slice_hist
+                                      : sched_pidlist[i].latency_hist;
+        printf("\t%3" PRIkernel_pid " ", i);
+        for (unsigned b = 0; b < SCHEDSTAT_HIST_NUMOF; b++) {
+            printf("| %9lu", (unsigned long)hist[b]);
+        }
+        puts("");
+    }
+}
+#endif
+
 /**
  * @brief Prints a list of running threads including stack usage to stdout.
  */
@@ -64,7 +92,7 @@ void ps(void)
            "| stack ( used) | base       | current     "
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
-           "| runtime | switches"
+           "| runtime | switches | cpu    | max lat"
 #endif
            "\n",
 #ifdef DEVELHELP
@@ -101,6 +129,8 @@ void ps(void)
             double runtime_ticks = sched_pidlist[i].runtime_ticks /
                                    (double) _xtimer_now64() * 100;
             int switches = sched_pidlist[i].schedules;
+            unsigned cpu = sched_cpu_permille(i);
+            unsigned long latency_max = sched_pidlist[i].latency_max;
 #endif
             printf("\t%3" PRIkernel_pid
 #ifdef DEVELHELP
@@ -111,7 +141,7 @@ void ps(void)
                    " | %5i (%5i) | %10p | %10p "
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
-                   " | %6.3f%% |  %8d"
+                   " | %6.3f%% |  %8d | %3u.%u%% | %7lu"
 #endif
                    "\n",
                    p->pid,
@@ -123,7 +153,7 @@ void ps(void)
                    , p->stack_size, stacksz, (void *)p->stack_start, (void *)p->sp
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
-                   , runtime_ticks, switches
+                   , runtime_ticks, switches, cpu / 10, cpu % 10, latency_max
 #endif
                   );
         }
@@ -137,4 +167,9 @@ void ps(void)
     tlsf_walk_pool(NULL);
 #   endif
 #endif
+
+#ifdef MODULE_SCHEDSTATISTICS
+    _print_hist("wake-up latency", false);
+    _print_hist("time slices", true);
+#endif
 }
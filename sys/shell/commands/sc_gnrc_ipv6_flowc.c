@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell command for the IPv6 flow cache
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "net/gnrc/ipv6/flowc.h"
+
+static void _usage(char *cmd)
+{
+    printf("usage: * %s\n", cmd);
+    puts("         Prints the statistics and entries of the flow cache.");
+    printf("       * %s flush\n", cmd);
+    puts("         Invalidates all entries of the flow cache.");
+    printf("       * %s help\n", cmd);
+    puts("         Print this.");
+}
+
+int _gnrc_ipv6_flowc(int argc, char **argv)
+{
+    if (argc < 2) {
+        gnrc_ipv6_flowc_print();
+        return 0;
+    }
+    if (strcmp("flush", argv[1]) == 0) {
+        gnrc_ipv6_flowc_invalidate();
+    }
+    else if (strcmp("help", argv[1]) == 0) {
+        _usage(argv[0]);
+    }
+    else {
+        _usage(argv[0]);
+        return 1;
+    }
+    return 0;
+}
+
+/** @} */
@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell command for the kernel event trace
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "trace.h"
+
+static void _usage(const char *cmd)
+{
+    printf("usage: %s [dump|clear|start|stop]\n", cmd);
+}
+
+int _trace_handler(int argc, char **argv)
+{
+    if ((argc < 2) || (strcmp(argv[1], "dump") == 0)) {
+        trace_dump();
+    }
+    else if (strcmp(argv[1], "clear") == 0) {
+        trace_clear();
+    }
+    else if (strcmp(argv[1], "start") == 0) {
+        trace_enable(1);
+    }
+    else if (strcmp(argv[1], "stop") == 0) {
+        trace_enable(0);
+    }
+    else {
+        _usage(argv[0]);
+        return 1;
+    }
+    return 0;
+}
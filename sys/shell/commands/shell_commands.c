@@ -106,6 +106,10 @@ extern int _whitelist(int argc, char **argv);
 extern int _blacklist(int argc, char **argv);
 #endif
 
+#ifdef MODULE_GNRC_IPV6_FLOWC
+extern int _gnrc_ipv6_flowc(int argc, char **argv);
+#endif
+
 #ifdef MODULE_GNRC_RPL
 extern int _gnrc_rpl(int argc, char **argv);
 #endif
@@ -136,6 +140,10 @@ extern int _ls_handler(int argc, char **argv);
 extern int _can_handler(int argc, char **argv);
 #endif
 
+#ifdef MODULE_TRACE
+extern int _trace_handler(int argc, char **argv);
+#endif
+
 const shell_command_t _shell_command_list[] = {
     {"reboot", "Reboot the node", _reboot_handler},
 #ifdef MODULE_CONFIG
@@ -201,6 +209,9 @@ const shell_command_t _shell_command_list[] = {
 #ifdef MODULE_GNRC_IPV6_BLACKLIST
     {"blacklist", "blacklists an address for receival ('blacklist [add|del|help]')", _blacklist },
 #endif
+#ifdef MODULE_GNRC_IPV6_FLOWC
+    {"flowc", "IPv6 flow cache statistics ('flowc [flush|help]')", _gnrc_ipv6_flowc },
+#endif
 #ifdef MODULE_GNRC_RPL
     {"rpl", "rpl configuration tool ('rpl help' for more information)", _gnrc_rpl },
 #endif
@@ -227,6 +238,9 @@ const shell_command_t _shell_command_list[] = {
 #endif
 #ifdef MODULE_CONN_CAN
     {"can", "CAN commands", _can_handler},
+#endif
+#ifdef MODULE_TRACE
+    {"trace", "dump or control the kernel event trace", _trace_handler},
 #endif
     {NULL, NULL, NULL}
 };
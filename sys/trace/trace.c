@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_trace
+ * @{
+ *
+ * @file
+ * @brief       Kernel event trace implementation
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "irq.h"
+#include "sched.h"
+#include "thread.h"
+#include "trace.h"
+#include "xtimer.h"
+
+#if (TRACE_BUF_SIZE & (TRACE_BUF_SIZE - 1)) != 0
+#error "TRACE_BUF_SIZE must be a power of two"
+#endif
+
+static trace_event_t _ring[TRACE_BUF_SIZE];
+static unsigned _writes;    /* total number of recorded events */
+static unsigned _first;     /* value of _writes at the last trace_clear() */
+static int _enabled = 1;
+
+void trace_record(unsigned type, unsigned arg)
+{
+    unsigned state = irq_disable();
+
+    if (_enabled) {
+        trace_event_t *event = &_ring[_writes++ & (TRACE_BUF_SIZE - 1)];
+
+        event->time = xtimer_now_usec();
+        event->type = type;
+        event->pid = sched_active_pid;
+        event->arg = arg;
+    }
+    irq_restore(state);
+}
+
+void trace_enable(int enable)
+{
+    _enabled = enable;
+}
+
+void trace_clear(void)
+{
+    unsigned state = irq_disable();
+    _first = _writes;
+    irq_restore(state);
+}
+
+unsigned trace_read(trace_event_t *events, unsigned max)
+{
+    unsigned state = irq_disable();
+    unsigned avail = _writes - _first;
+
+    if (avail > TRACE_BUF_SIZE) {
+        avail = TRACE_BUF_SIZE;
+    }
+    if (max > avail) {
+        max = avail;
+    }
+    /* return the newest max events, oldest first */
+    for (unsigned i = 0, pos = _writes - max; i < max; i++, pos++) {
+        events[i] = _ring[pos & (TRACE_BUF_SIZE - 1)];
+    }
+    irq_restore(state);
+    return max;
+}
+
+void trace_dump(void)
+{
+    int enabled = _enabled;
+
+    /* don't trace the output itself */
+    trace_enable(0);
+
+    unsigned total = _writes - _first;
+    unsigned num = (total > TRACE_BUF_SIZE) ? TRACE_BUF_SIZE : total;
+
+    printf("TRACE BEGIN %u %u\n", num, total - num);
+#ifdef DEVELHELP
+    for (kernel_pid_t pid = KERNEL_PID_FIRST; pid <= KERNEL_PID_LAST; pid++) {
+        const char *name = thread_getname(pid);
+        if (name) {
+            printf("TRACE THREAD %i %s\n", (int)pid, name);
+        }
+    }
+#endif
+    for (unsigned pos = _writes - num; pos != _writes; pos++) {
+        trace_event_t *event = &_ring[pos & (TRACE_BUF_SIZE - 1)];
+        printf("TRACE %lu %u %i %u\n", (unsigned long)event->time,
+               (unsigned)event->type, (int)event->pid, (unsigned)event->arg);
+    }
+    puts("TRACE END");
+
+    trace_enable(enabled);
+}
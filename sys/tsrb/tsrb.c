@@ -17,6 +17,8 @@
  * @}
  */
 
+#include <string.h>
+
 #include "tsrb.h"
 
 static void _push(tsrb_t *rb, char c)
@@ -42,9 +44,18 @@ int tsrb_get_one(tsrb_t *rb)
 int tsrb_get(tsrb_t *rb, char *dst, size_t n)
 {
     size_t tmp = n;
-    while (tmp && !tsrb_empty(rb)) {
-        *dst++ = _pop(rb);
-        tmp--;
+    size_t len;
+    char *region;
+
+    /* at most two rounds: up to the end of the buffer, then from its start */
+    while (tmp && (len = tsrb_peek_region(rb, &region))) {
+        if (len > tmp) {
+            len = tmp;
+        }
+        memcpy(dst, region, len);
+        tsrb_release(rb, len);
+        dst += len;
+        tmp -= len;
     }
     return (n - tmp);
 }
@@ -63,9 +74,18 @@ int tsrb_add_one(tsrb_t *rb, char c)
 int tsrb_add(tsrb_t *rb, const char *src, size_t n)
 {
     size_t tmp = n;
-    while (tmp && !tsrb_full(rb)) {
-        _push(rb, *src++);
-        tmp--;
+    size_t len;
+    char *region;
+
+    /* at most two rounds: up to the end of the buffer, then from its start */
+    while (tmp && (len = tsrb_reserve(rb, &region))) {
+        if (len > tmp) {
+            len = tmp;
+        }
+        memcpy(region, src, len);
+        tsrb_commit(rb, len);
+        src += len;
+        tmp -= len;
     }
     return (n - tmp);
 }
@@ -15,6 +15,8 @@
  * @}
  */
 
+#include <assert.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -25,6 +27,7 @@
 #include "net/gnrc/ipv6.h"
 #endif
 #endif
+#include "memarray.h"
 #include "mutex.h"
 
 #define ENABLE_DEBUG (0)
@@ -46,6 +49,25 @@
 #   define UNIVERSAL_ADDRESS_MAX_ENTRIES    (UA_ADD0)
 #endif
 
+/**
+ * @brief Number of buckets of the hash table, must be a power of two
+ */
+#ifndef UNIVERSAL_ADDRESS_HASH_SIZE
+#   if UNIVERSAL_ADDRESS_MAX_ENTRIES > 256
+#       define UNIVERSAL_ADDRESS_HASH_SIZE  (256U)
+#   elif UNIVERSAL_ADDRESS_MAX_ENTRIES > 64
+#       define UNIVERSAL_ADDRESS_HASH_SIZE  (64U)
+#   elif UNIVERSAL_ADDRESS_MAX_ENTRIES > 16
+#       define UNIVERSAL_ADDRESS_HASH_SIZE  (16U)
+#   else
+#       define UNIVERSAL_ADDRESS_HASH_SIZE  (4U)
+#   endif
+#endif
+
+#if (UNIVERSAL_ADDRESS_HASH_SIZE & (UNIVERSAL_ADDRESS_HASH_SIZE - 1))
+#error "UNIVERSAL_ADDRESS_HASH_SIZE must be a power of two"
+#endif
+
 /**
  * @brief counter indicating the number of entries allocated
  */
@@ -56,11 +78,50 @@ static size_t universal_address_table_filled = 0;
  */
 static universal_address_container_t universal_address_table[UNIVERSAL_ADDRESS_MAX_ENTRIES];
 
+/**
+ * @brief The allocator for unused entries of universal_address_table
+ */
+static memarray_t universal_address_pool = MEMARRAY_INIT(universal_address_table,
+                                                         sizeof(universal_address_container_t),
+                                                         UNIVERSAL_ADDRESS_MAX_ENTRIES);
+
+/**
+ * @brief The allocators for chunks added with universal_address_extend()
+ */
+static memarray_t universal_address_chunks[UNIVERSAL_ADDRESS_CHUNKS_MAX];
+
+/**
+ * @brief number of chunks added with universal_address_extend()
+ */
+static unsigned universal_address_chunks_num = 0;
+
+/**
+ * @brief The hash table over all used universal_address containers
+ */
+static universal_address_container_t *universal_address_buckets[UNIVERSAL_ADDRESS_HASH_SIZE];
+
 /**
  * @brief access mutex to control exclusive operations on calls
  */
 static mutex_t mtx_access = MUTEX_INIT;
 
+/**
+ * @brief returns the hash table bucket for the given address
+ */
+static universal_address_container_t **universal_address_bucket(const uint8_t *addr,
+                                                                size_t addr_size)
+{
+    /* FNV-1a */
+    uint32_t hash = 2166136261U ^ addr_size;
+
+    for (size_t i = 0; i < addr_size; i++) {
+        hash = (hash ^ addr[i]) * 16777619U;
+    }
+    hash ^= hash >> 16;
+
+    return &universal_address_buckets[hash & (UNIVERSAL_ADDRESS_HASH_SIZE - 1)];
+}
+
 /**
  * @brief finds the universal address container for the given address
  *
@@ -72,14 +133,12 @@ static mutex_t mtx_access = MUTEX_INIT;
  */
 static universal_address_container_t *universal_address_find_entry(uint8_t *addr, size_t addr_size)
 {
-    /* cppcheck-suppress unsignedLessThanZero
-     * (reason: UNIVERSAL_ADDRESS_MAX_ENTRIES may be zero in which case this
-     * code is optimized out) */
-    for (size_t i = 0; i < UNIVERSAL_ADDRESS_MAX_ENTRIES; ++i) {
-        if (universal_address_table[i].address_size == addr_size) {
-            if (memcmp((universal_address_table[i].address), addr, addr_size) == 0) {
-                return &(universal_address_table[i]);
-            }
+    universal_address_container_t *entry = *universal_address_bucket(addr, addr_size);
+
+    for (; entry != NULL; entry = entry->next) {
+        if ((entry->address_size == addr_size) &&
+            (memcmp(entry->address, addr, addr_size) == 0)) {
+            return entry;
         }
     }
 
@@ -93,20 +152,70 @@ static universal_address_container_t *universal_address_find_entry(uint8_t *addr
  *         or NULL if no memory is left in universal_address_table
  */
 static universal_address_container_t *universal_address_get_next_unused_entry(void)
+{
+    /* the free-list link of the pool must not overlap use_count */
+    assert(offsetof(universal_address_container_t, use_count) >= sizeof(void *));
+
+    universal_address_container_t *pEntry = memarray_alloc(&universal_address_pool);
+
+    for (unsigned i = 0; (pEntry == NULL) && (i < universal_address_chunks_num); i++) {
+        pEntry = memarray_alloc(&universal_address_chunks[i]);
+    }
+
+    if (pEntry != NULL) {
+        pEntry->use_count = 0;
+    }
+
+    return pEntry;
+}
+
+/**
+ * @brief returns an unused container to the allocator it was taken from
+ */
+static void universal_address_free_entry(universal_address_container_t *entry)
+{
+    memarray_t *pool = &universal_address_pool;
+
+    for (unsigned i = 0; i < universal_address_chunks_num; i++) {
+        memarray_t *chunk = &universal_address_chunks[i];
+
+        if (((uint8_t *)entry >= chunk->data) &&
+            ((uint8_t *)entry < (chunk->data + (chunk->num * chunk->size)))) {
+            pool = chunk;
+            break;
+        }
+    }
+    memarray_free(pool, entry);
+}
+
+/**
+ * @brief resets all containers and allocators
+ */
+static void universal_address_clear(void)
 {
     /* cppcheck-suppress unsignedLessThanZero
      * (reason: UNIVERSAL_ADDRESS_MAX_ENTRIES may be zero in which case this
      * code is optimized out) */
-    if (universal_address_table_filled < UNIVERSAL_ADDRESS_MAX_ENTRIES) {
-        /* cppcheck-suppress unsignedLessThanZero */
-        for (size_t i = 0; i < UNIVERSAL_ADDRESS_MAX_ENTRIES; ++i) {
-            if (universal_address_table[i].use_count == 0) {
-                return &(universal_address_table[i]);
-            }
+    for (size_t i = 0; i < UNIVERSAL_ADDRESS_MAX_ENTRIES; ++i) {
+        universal_address_table[i].use_count = 0;
+    }
+    memarray_init(&universal_address_pool, universal_address_table,
+                  sizeof(universal_address_container_t),
+                  UNIVERSAL_ADDRESS_MAX_ENTRIES);
+
+    for (unsigned i = 0; i < universal_address_chunks_num; i++) {
+        memarray_t *chunk = &universal_address_chunks[i];
+        universal_address_container_t *entries = (universal_address_container_t *)chunk->data;
+
+        for (size_t j = 0; j < chunk->num; j++) {
+            entries[j].use_count = 0;
         }
+        memarray_init(chunk, entries, sizeof(universal_address_container_t),
+                      chunk->num);
     }
 
-    return NULL;
+    memset(universal_address_buckets, 0, sizeof(universal_address_buckets));
+    universal_address_table_filled = 0;
 }
 
 universal_address_container_t *universal_address_add(uint8_t *addr, size_t addr_size)
@@ -124,18 +233,18 @@ universal_address_container_t *universal_address_add(uint8_t *addr, size_t addr_
             return NULL;
         }
 
-        /* look if the former memory has distinct size */
-        if (pEntry->address_size != addr_size) {
-            /* clean the address */
-            memset(pEntry->address, 0, UNIVERSAL_ADDRESS_SIZE);
+        /* clean the address */
+        memset(pEntry->address, 0, UNIVERSAL_ADDRESS_SIZE);
 
-            /* set the used bytes */
-            pEntry->address_size = addr_size;
-            pEntry->use_count = 0;
-        }
+        /* set the used bytes */
+        pEntry->address_size = addr_size;
 
         /* copy the address */
         memcpy((pEntry->address), addr, addr_size);
+
+        universal_address_container_t **bucket = universal_address_bucket(addr, addr_size);
+        pEntry->next = *bucket;
+        *bucket = pEntry;
     }
 
     pEntry->use_count++;
@@ -161,7 +270,16 @@ void universal_address_rem(universal_address_container_t *entry)
             entry->use_count--;
 
             if (entry->use_count == 0) {
+                universal_address_container_t **prev =
+                    universal_address_bucket(entry->address, entry->address_size);
+
+                while (*prev != entry) {
+                    prev = &(*prev)->next;
+                }
+                *prev = entry->next;
+
                 universal_address_table_filled--;
+                universal_address_free_entry(entry);
             }
         }
         else {
@@ -305,27 +423,37 @@ void universal_address_init(void)
      * (reason: UNIVERSAL_ADDRESS_MAX_ENTRIES may be zero in which case this
      * code is optimized out) */
     for (size_t i = 0; i < UNIVERSAL_ADDRESS_MAX_ENTRIES; ++i) {
-        universal_address_table[i].use_count = 0;
         universal_address_table[i].address_size = 0;
         memset(universal_address_table[i].address, 0, UNIVERSAL_ADDRESS_SIZE);
     }
 
+    universal_address_clear();
     mutex_unlock(&mtx_access);
 }
 
 void universal_address_reset(void)
 {
     mutex_lock(&mtx_access);
+    universal_address_clear();
+    mutex_unlock(&mtx_access);
+}
 
-    /* cppcheck-suppress unsignedLessThanZero
-     * (reason: UNIVERSAL_ADDRESS_MAX_ENTRIES may be zero in which case this
-     * code is optimized out) */
-    for (size_t i = 0; i < UNIVERSAL_ADDRESS_MAX_ENTRIES; ++i) {
-        universal_address_table[i].use_count = 0;
+int universal_address_extend(universal_address_container_t *chunk, size_t num)
+{
+    mutex_lock(&mtx_access);
+
+    if (universal_address_chunks_num >= UNIVERSAL_ADDRESS_CHUNKS_MAX) {
+        mutex_unlock(&mtx_access);
+        return -ENOMEM;
     }
 
-    universal_address_table_filled = 0;
+    for (size_t i = 0; i < num; i++) {
+        chunk[i].use_count = 0;
+    }
+    memarray_init(&universal_address_chunks[universal_address_chunks_num++],
+                  chunk, sizeof(universal_address_container_t), num);
     mutex_unlock(&mtx_access);
+    return 0;
 }
 
 void universal_address_print_entry(universal_address_container_t *entry)
@@ -361,10 +489,10 @@ void universal_address_print_table(void)
     printf("[universal_address_print_table] universal_address_table_filled: %d\n", \
            (int)universal_address_table_filled);
 
-    /* cppcheck-suppress unsignedLessThanZero
-     * (reason: UNIVERSAL_ADDRESS_MAX_ENTRIES may be zero in which case this
-     * code is optimized out) */
-    for (size_t i = 0; i < UNIVERSAL_ADDRESS_MAX_ENTRIES; ++i) {
-        universal_address_print_entry(&universal_address_table[i]);
+    for (size_t i = 0; i < UNIVERSAL_ADDRESS_HASH_SIZE; ++i) {
+        for (universal_address_container_t *entry = universal_address_buckets[i];
+             entry != NULL; entry = entry->next) {
+            universal_address_print_entry(entry);
+        }
     }
 }
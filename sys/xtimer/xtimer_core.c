@@ -41,9 +41,13 @@ static xtimer_t *timer_list_head = NULL;
 static xtimer_t *overflow_list_head = NULL;
 static xtimer_t *long_list_head = NULL;
 
+static uint32_t _coalesced = 0;
+static uint32_t _wakeups = 0;
+
 static void _add_timer_to_list(xtimer_t **list_head, xtimer_t *timer);
 static void _add_timer_to_long_list(xtimer_t **list_head, xtimer_t *timer);
 static void _shoot(xtimer_t *timer);
+static int _set_absolute(xtimer_t *timer, uint32_t target, uint32_t slack);
 static void _remove(xtimer_t *timer);
 static inline void _lltimer_set(uint32_t target);
 static uint32_t _time_left(uint32_t target, uint32_t reference);
@@ -99,14 +103,35 @@ uint64_t _xtimer_now64(void)
     return ((uint64_t)long_term<<32) + short_term;
 }
 
-void _xtimer_set64(xtimer_t *timer, uint32_t offset, uint32_t long_offset)
+void _xtimer_set_slack64(xtimer_t *timer, uint32_t offset, uint32_t long_offset, uint32_t slack)
 {
-    DEBUG(" _xtimer_set64() offset=%" PRIu32 " long_offset=%" PRIu32 "\n", offset, long_offset);
-    if (!long_offset) {
+    DEBUG(" _xtimer_set_slack64() offset=%" PRIu32 " long_offset=%" PRIu32 " slack=%" PRIu32 "\n",
+          offset, long_offset, slack);
+    if (!timer->callback) {
+        DEBUG("timer_set(): timer has no callback.\n");
+        return;
+    }
+
+    /* timers are sorted in by the end of their tolerance window */
+    uint64_t latest = (((uint64_t)long_offset << 32) | offset) + slack;
+
+    if (!(latest >> 32)) {
         /* timer fits into the short timer */
-        _xtimer_set(timer, (uint32_t) offset);
+        xtimer_remove(timer);
+
+        if (offset < XTIMER_BACKOFF) {
+            _xtimer_spin(offset);
+            _shoot(timer);
+        }
+        else {
+            uint32_t target = _xtimer_now() + (uint32_t)latest;
+            _set_absolute(timer, target, slack);
+        }
     }
     else {
+        offset = (uint32_t)latest;
+        long_offset = (uint32_t)(latest >> 32);
+
         int state = irq_disable();
         if (_is_set(timer)) {
             _remove(timer);
@@ -118,6 +143,7 @@ void _xtimer_set64(xtimer_t *timer, uint32_t offset, uint32_t long_offset)
         if (timer->target < offset) {
             timer->long_target++;
         }
+        _xtimer_slack_set(timer, slack);
 
         _add_timer_to_long_list(&long_list_head, timer);
         irq_restore(state);
@@ -126,31 +152,50 @@ void _xtimer_set64(xtimer_t *timer, uint32_t offset, uint32_t long_offset)
     }
 }
 
+void _xtimer_set64(xtimer_t *timer, uint32_t offset, uint32_t long_offset)
+{
+    _xtimer_set_slack64(timer, offset, long_offset, 0);
+}
+
 void _xtimer_set(xtimer_t *timer, uint32_t offset)
 {
-    DEBUG("timer_set(): offset=%" PRIu32 " now=%" PRIu32 " (%" PRIu32 ")\n",
-          offset, xtimer_now().ticks32, _xtimer_lltimer_now());
-    if (!timer->callback) {
-        DEBUG("timer_set(): timer has no callback.\n");
-        return;
-    }
+    _xtimer_set_slack64(timer, offset, 0, 0);
+}
+
+uint32_t xtimer_coalesced(void)
+{
+    return _coalesced;
+}
 
-    xtimer_remove(timer);
+uint32_t xtimer_wakeups(void)
+{
+    return _wakeups;
+}
 
-    if (offset < XTIMER_BACKOFF) {
-        _xtimer_spin(offset);
-        _shoot(timer);
+int xtimer_next_target(uint32_t *target)
+{
+    int res = -1;
+    unsigned state = irq_disable();
+
+    /* overflow_list_head and long_list_head are only handled by the tick on
+     * low-level timer overflow */
+    if (timer_list_head) {
+        *target = _xtimer_lltimer_mask(timer_list_head->target);
+        res = 0;
     }
-    else {
-        uint32_t target = _xtimer_now() + offset;
-        _xtimer_set_absolute(timer, target);
+    else if (overflow_list_head || long_list_head) {
+        res = 1;
     }
+
+    irq_restore(state);
+    return res;
 }
 
 static void _periph_timer_callback(void *arg, int chan)
 {
     (void)arg;
     (void)chan;
+    _wakeups++;
     _timer_callback();
 }
 
@@ -169,6 +214,11 @@ static inline void _lltimer_set(uint32_t target)
 }
 
 int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
+{
+    return _set_absolute(timer, target, 0);
+}
+
+static int _set_absolute(xtimer_t *timer, uint32_t target, uint32_t slack)
 {
     uint32_t now = _xtimer_now();
     int res = 0;
@@ -190,6 +240,7 @@ int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
 
     timer->target = target;
     timer->long_target = _long_cnt;
+    _xtimer_slack_set(timer, slack);
     if (target < now) {
         timer->long_target++;
     }
@@ -302,6 +353,19 @@ static uint32_t _time_left(uint32_t target, uint32_t reference)
     }
 }
 
+/**
+ * @brief get the (masked) start of a timer's tolerance window
+ *
+ * Windows reaching back into the previous timer period are cut at the
+ * period's start.
+ */
+static inline uint32_t _earliest(xtimer_t *timer)
+{
+    uint32_t target = _xtimer_lltimer_mask(timer->target);
+
+    return (_xtimer_slack(timer) < target) ? (target - _xtimer_slack(timer)) : 0;
+}
+
 static inline int _this_high_period(uint32_t target) {
 #if XTIMER_MASK
     return (target & XTIMER_MASK) == _xtimer_high_cnt;
@@ -463,14 +527,21 @@ static void _timer_callback(void)
     }
 
 overflow:
-    /* check if next timers are close to expiring */
-    while (timer_list_head && (_time_left(_xtimer_lltimer_mask(timer_list_head->target), reference) < XTIMER_ISR_BACKOFF)) {
+    /* check if next timers are close to expiring (or within their tolerance
+     * window) */
+    while (timer_list_head && (_time_left(_earliest(timer_list_head), reference) < XTIMER_ISR_BACKOFF)) {
         /* make sure we don't fire too early */
-        while (_time_left(_xtimer_lltimer_mask(timer_list_head->target), reference)) {}
+        while (_time_left(_earliest(timer_list_head), reference)) {}
 
         /* pick first timer in list */
         xtimer_t *timer = timer_list_head;
 
+        if (_time_left(_xtimer_lltimer_mask(timer->target), reference) >= XTIMER_ISR_BACKOFF) {
+            /* this timer's own deadline is still ahead, it gets executed along
+             * with the one that triggered this interrupt */
+            _coalesced++;
+        }
+
         /* advance list */
         timer_list_head = timer->next;
 
@@ -0,0 +1,697 @@
+/**
+ * Copyright (C) 2015 Kaspar Schleiser <kaspar@schleiser.de>
+ * Copyright (C) 2016 Eistec AB
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ *
+ * @ingroup xtimer
+ * @{
+ * @file
+ * @brief xtimer core functionality, hierarchical timing wheel backend
+ *
+ * Timers are kept in a hierarchy of XTIMER_WHEEL_LEVELS wheels with
+ * 2^XTIMER_WHEEL_BITS slots each. A timer is put into the wheel level that
+ * corresponds to the most significant digit in which its absolute target
+ * differs from the current wheel time. When the wheel time reaches the start
+ * of a slot, the timers of that slot are redistributed into the lower levels
+ * ("cascaded"). Only timers expiring within the current level 0 slot
+ * (2^XTIMER_WHEEL_SHIFT ticks) are kept in a sorted list, so they can be fired
+ * exactly on target. Cascading is done lazily, whenever the wheel is looked
+ * at anyway: the low-level timer is only programmed for the earliest target
+ * of all timers, not for the slot boundaries in between. Timers with slack (module `xtimer_slack`) are hashed by
+ * the start of their tolerance window instead, so they join the sorted list
+ * early enough to be executed together with other timers.
+ *
+ * Setting and removing a timer is thus O(1) (plus the length of the short
+ * sorted list), independent of the total number of active timers.
+ *
+ * @author Kaspar Schleiser <kaspar@schleiser.de>
+ * @author Joakim Nohlgård <joakim.nohlgard@eistec.se>
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "board.h"
+#include "periph/timer.h"
+#include "periph_conf.h"
+
+#include "xtimer.h"
+#include "irq.h"
+#include "bitarithm.h"
+
+/* WARNING! enabling this will have side effects and can lead to timer underflows. */
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+#define WHEEL_SLOTS         (1U << XTIMER_WHEEL_BITS)
+#define WHEEL_SLOT_MASK     (WHEEL_SLOTS - 1)
+
+/**
+ * @brief   bit position of the digit of level @p l within a 64bit time stamp
+ */
+#define WHEEL_LEVEL_SHIFT(l) (XTIMER_WHEEL_SHIFT + ((l) * XTIMER_WHEEL_BITS))
+
+/**
+ * @brief   maximum value of the low-level timer, i.e., end of a period
+ */
+#define LLTIMER_MAX         (_xtimer_lltimer_mask(0xFFFFFFFF))
+
+static volatile int _in_handler = 0;
+
+static volatile uint32_t _long_cnt = 0;
+#if XTIMER_MASK
+volatile uint32_t _xtimer_high_cnt = 0;
+#endif
+
+/**
+ * @brief   last low-level timer value seen, used to detect period overflows
+ */
+static uint32_t _last_lltimer = 0;
+
+/**
+ * @brief   start of the level 0 slot the wheel is currently at
+ */
+static uint64_t _wheel_time = 0;
+
+static xtimer_t *_wheel[XTIMER_WHEEL_LEVELS][WHEEL_SLOTS];
+static uint32_t _wheel_bitmap[XTIMER_WHEEL_LEVELS];
+
+/**
+ * @brief   timers expiring (or whose tolerance window starts) within the
+ *          current level 0 slot, sorted by target
+ */
+static xtimer_t *_near_list_head = NULL;
+
+/**
+ * @brief   timers too far in the future for the highest wheel level
+ */
+static xtimer_t *_far_list_head = NULL;
+
+/**
+ * @brief   earliest target of the timers in the wheel and the far list,
+ *          only valid if _wheel_min_valid is set
+ */
+static uint64_t _wheel_min = UINT64_MAX;
+static bool _wheel_min_valid = true;
+
+static uint32_t _coalesced = 0;
+static uint32_t _wakeups = 0;
+
+static void _timer_callback(void);
+static void _periph_timer_callback(void *arg, int chan);
+
+static inline void xtimer_spin_until(uint32_t target) {
+#if XTIMER_MASK
+    target = _xtimer_lltimer_mask(target);
+#endif
+    while (_xtimer_lltimer_now() > target);
+    while (_xtimer_lltimer_now() < target);
+}
+
+static inline int _is_set(xtimer_t *timer)
+{
+    return (timer->target || timer->long_target);
+}
+
+static inline uint64_t _target64(xtimer_t *timer)
+{
+    return ((uint64_t)timer->long_target << 32) | timer->target;
+}
+
+static inline void _link(xtimer_t **pos, xtimer_t *timer)
+{
+    timer->next = *pos;
+    if (timer->next) {
+        timer->next->pprev = &timer->next;
+    }
+    timer->pprev = pos;
+    *pos = timer;
+}
+
+static unsigned _lsb32(uint32_t v)
+{
+    unsigned pos = 0;
+
+    /* bitarithm_lsb() operates on unsigned, which might only be 16 bit wide */
+    if (!(v & 0xFFFF)) {
+        v >>= 16;
+        pos = 16;
+    }
+    return pos + bitarithm_lsb((unsigned)(v & 0xFFFF));
+}
+
+void xtimer_init(void)
+{
+    /* initialize low-level timer */
+    timer_init(XTIMER_DEV, XTIMER_HZ, _periph_timer_callback, NULL);
+
+    /* register initial overflow tick */
+    timer_set_absolute(XTIMER_DEV, XTIMER_CHAN, LLTIMER_MAX);
+}
+
+static void _xtimer_now_internal(uint32_t *short_term, uint32_t *long_term)
+{
+    uint32_t before, after, long_value;
+
+    /* loop to cope with possible overflow of _xtimer_now() */
+    do {
+        before = _xtimer_now();
+        long_value = _long_cnt;
+        after = _xtimer_now();
+
+    } while(before > after);
+
+    *short_term = after;
+    *long_term = long_value;
+}
+
+uint64_t _xtimer_now64(void)
+{
+    uint32_t short_term, long_term;
+    _xtimer_now_internal(&short_term, &long_term);
+
+    return ((uint64_t)long_term<<32) + short_term;
+}
+
+/**
+ * @brief handle low-level timer overflow, advance to next short timer period
+ */
+static void _next_period(void)
+{
+#if XTIMER_MASK
+    /* advance <32bit mask register */
+    _xtimer_high_cnt += ~XTIMER_MASK + 1;
+    if (_xtimer_high_cnt == 0) {
+        /* high_cnt overflowed, so advance >32bit counter */
+        _long_cnt++;
+    }
+#else
+    /* advance >32bit counter */
+    _long_cnt++;
+#endif
+}
+
+/**
+ * @brief   get the current 64bit time, advancing the period on overflow
+ *
+ * Must be called with interrupts disabled.
+ */
+static uint64_t _now64_locked(void)
+{
+    uint32_t lltimer = _xtimer_lltimer_now();
+
+    if (lltimer < _last_lltimer) {
+        _next_period();
+    }
+    _last_lltimer = lltimer;
+
+#if XTIMER_MASK
+    return ((uint64_t)_long_cnt << 32) | _xtimer_high_cnt | lltimer;
+#else
+    return ((uint64_t)_long_cnt << 32) | lltimer;
+#endif
+}
+
+static void _add_timer_to_near_list(xtimer_t *timer)
+{
+    xtimer_t **pos = &_near_list_head;
+    uint64_t target = _target64(timer);
+
+    while (*pos && (_target64(*pos) <= target)) {
+        pos = &((*pos)->next);
+    }
+
+    _link(pos, timer);
+}
+
+/**
+ * @brief   put a timer into the wheel level matching its distance to the
+ *          current wheel time
+ *
+ * Timers are hashed by the start of their tolerance window: once that is
+ * reached, they wait in the near list, where they can be executed along with
+ * any other timer, until their target.
+ */
+static void _add_timer_to_wheel(xtimer_t *timer)
+{
+    uint64_t target = _target64(timer) - _xtimer_slack(timer);
+
+    if ((target >> XTIMER_WHEEL_SHIFT) <= (_wheel_time >> XTIMER_WHEEL_SHIFT)) {
+        /* window starts within the current level 0 slot (or is overdue) */
+        _add_timer_to_near_list(timer);
+        return;
+    }
+
+    /* find the most significant digit target and wheel time differ in */
+    uint64_t diff = (target ^ _wheel_time) >> WHEEL_LEVEL_SHIFT(1);
+    unsigned level = 0;
+    while (diff && (level < XTIMER_WHEEL_LEVELS)) {
+        diff >>= XTIMER_WHEEL_BITS;
+        level++;
+    }
+
+    if (_target64(timer) < _wheel_min) {
+        _wheel_min = _target64(timer);
+    }
+
+    if (level == XTIMER_WHEEL_LEVELS) {
+        _link(&_far_list_head, timer);
+    }
+    else {
+        unsigned slot = (target >> WHEEL_LEVEL_SHIFT(level)) & WHEEL_SLOT_MASK;
+        _link(&_wheel[level][slot], timer);
+        _wheel_bitmap[level] |= ((uint32_t)1 << slot);
+    }
+}
+
+static void _unlink(xtimer_t *timer)
+{
+    xtimer_t **pprev = timer->pprev;
+
+    *pprev = timer->next;
+    if (timer->next) {
+        timer->next->pprev = pprev;
+    }
+
+    /* if the timer was the only one in a wheel slot, mark the slot empty */
+    if ((pprev >= &_wheel[0][0]) &&
+        (pprev < &_wheel[0][0] + (XTIMER_WHEEL_LEVELS * WHEEL_SLOTS)) &&
+        (*pprev == NULL)) {
+        unsigned idx = pprev - &_wheel[0][0];
+        _wheel_bitmap[idx / WHEEL_SLOTS] &= ~((uint32_t)1 << (idx & WHEEL_SLOT_MASK));
+    }
+    /* timers in the near list can share the target, recalculating is cheap */
+    if (_target64(timer) == _wheel_min) {
+        _wheel_min_valid = false;
+    }
+
+    timer->target = 0;
+    timer->long_target = 0;
+}
+
+/**
+ * @brief   start time of the next wheel slot (or far list rescan) that holds
+ *          timers, UINT64_MAX if the wheel is empty
+ */
+static uint64_t _next_slot_start(void)
+{
+    for (unsigned level = 0; level < XTIMER_WHEEL_LEVELS; level++) {
+        if (_wheel_bitmap[level]) {
+            uint64_t base = (_wheel_time >> WHEEL_LEVEL_SHIFT(level + 1))
+                            << WHEEL_LEVEL_SHIFT(level + 1);
+            return base + ((uint64_t)_lsb32(_wheel_bitmap[level])
+                           << WHEEL_LEVEL_SHIFT(level));
+        }
+    }
+
+    if (_far_list_head) {
+        uint64_t base = (_wheel_time >> WHEEL_LEVEL_SHIFT(XTIMER_WHEEL_LEVELS));
+        return (base + 1) << WHEEL_LEVEL_SHIFT(XTIMER_WHEEL_LEVELS);
+    }
+
+    return UINT64_MAX;
+}
+
+static uint64_t _list_min(xtimer_t *list)
+{
+    uint64_t min = UINT64_MAX;
+
+    for (; list; list = list->next) {
+        if (_target64(list) < min) {
+            min = _target64(list);
+        }
+    }
+    return min;
+}
+
+/**
+ * @brief   earliest target of the timers in the wheel and the far list
+ *
+ * Timers are hashed by the start of their tolerance window, so the first
+ * occupied slot holds the earliest window start. A later slot might still
+ * hold a timer with less slack and an earlier target, so all slots starting
+ * before the earliest target found so far are scanned.
+ */
+static uint64_t _wheel_scan(void)
+{
+    uint64_t next = UINT64_MAX;
+
+    for (unsigned level = 0; level < XTIMER_WHEEL_LEVELS; level++) {
+        uint64_t base = (_wheel_time >> WHEEL_LEVEL_SHIFT(level + 1))
+                        << WHEEL_LEVEL_SHIFT(level + 1);
+        uint32_t bitmap = _wheel_bitmap[level];
+
+        while (bitmap) {
+            unsigned slot = _lsb32(bitmap);
+
+            if ((base + ((uint64_t)slot << WHEEL_LEVEL_SHIFT(level))) >= next) {
+                /* slots of this and all higher levels start even later */
+                return next;
+            }
+            uint64_t min = _list_min(_wheel[level][slot]);
+            if (min < next) {
+                next = min;
+            }
+            bitmap &= ~((uint32_t)1 << slot);
+        }
+    }
+
+    uint64_t min = _list_min(_far_list_head);
+    return (min < next) ? min : next;
+}
+
+static uint64_t _wheel_next(void)
+{
+    if (!_wheel_min_valid) {
+        _wheel_min = _wheel_scan();
+        _wheel_min_valid = true;
+    }
+    return _wheel_min;
+}
+
+/**
+ * @brief   time of the next timer target, the wheel is cascaded lazily
+ */
+static uint64_t _next_event(void)
+{
+    uint64_t next = _wheel_next();
+
+    if (_near_list_head && (_target64(_near_list_head) < next)) {
+        next = _target64(_near_list_head);
+    }
+    return next;
+}
+
+static void _cascade_list(xtimer_t *list)
+{
+    /* timers leave the wheel for the near list */
+    _wheel_min_valid = false;
+
+    while (list) {
+        xtimer_t *timer = list;
+        list = list->next;
+        _add_timer_to_wheel(timer);
+    }
+}
+
+/**
+ * @brief   advance the wheel up to @p until, cascading all slots starting
+ *          before that time
+ */
+static void _wheel_advance(uint64_t until)
+{
+    uint64_t next;
+
+    while ((next = _next_slot_start()) <= until) {
+        _wheel_time = next;
+
+        if (!(_wheel_time & ((1ULL << WHEEL_LEVEL_SHIFT(XTIMER_WHEEL_LEVELS)) - 1))) {
+            xtimer_t *list = _far_list_head;
+            _far_list_head = NULL;
+            _cascade_list(list);
+        }
+
+        for (unsigned level = 0; level < XTIMER_WHEEL_LEVELS; level++) {
+            if (_wheel_time & ((1ULL << WHEEL_LEVEL_SHIFT(level)) - 1)) {
+                /* wheel time is not at the start of a slot of this level */
+                break;
+            }
+            unsigned slot = (_wheel_time >> WHEEL_LEVEL_SHIFT(level)) & WHEEL_SLOT_MASK;
+            xtimer_t *list = _wheel[level][slot];
+            if (list) {
+                _wheel[level][slot] = NULL;
+                _wheel_bitmap[level] &= ~((uint32_t)1 << slot);
+                _cascade_list(list);
+            }
+        }
+    }
+
+    /* all slots up to until are empty, so it is safe to skip ahead */
+    until = (until >> XTIMER_WHEEL_SHIFT) << XTIMER_WHEEL_SHIFT;
+    if (until > _wheel_time) {
+        _wheel_time = until;
+    }
+}
+
+/**
+ * @brief   program the low-level timer for the next event
+ *
+ * Must be called with interrupts disabled.
+ */
+static void _lltimer_update(uint64_t now)
+{
+    if (_in_handler) {
+        return;
+    }
+
+    uint64_t next = _next_event();
+    uint64_t period_end = now | LLTIMER_MAX;
+
+    if (next > period_end) {
+        /* schedule callback on next overflow */
+        next = period_end;
+    }
+    else {
+        next -= XTIMER_OVERHEAD;
+        /* make sure we're not setting a time in the past */
+        if (next < (now + XTIMER_ISR_BACKOFF)) {
+            next = now + XTIMER_ISR_BACKOFF;
+        }
+    }
+
+    DEBUG("_lltimer_update(): setting %" PRIu32 "\n",
+          _xtimer_lltimer_mask((uint32_t)next));
+    timer_set_absolute(XTIMER_DEV, XTIMER_CHAN, _xtimer_lltimer_mask((uint32_t)next));
+}
+
+/**
+ * @brief   first timer of the near list whose tolerance window started
+ *          before @p now
+ */
+static xtimer_t *_next_due(uint64_t now)
+{
+    for (xtimer_t *timer = _near_list_head; timer; timer = timer->next) {
+        if ((_target64(timer) - _xtimer_slack(timer)) <= now) {
+            return timer;
+        }
+#ifndef MODULE_XTIMER_SLACK
+        /* the list is sorted by target, no later timer can be due */
+        break;
+#endif
+    }
+    return NULL;
+}
+
+static void _shoot(xtimer_t *timer)
+{
+    timer->callback(timer->arg);
+}
+
+static void _set_target64(xtimer_t *timer, uint64_t target, uint64_t now)
+{
+    uint64_t next = _next_event();
+
+    timer->target = (uint32_t)target;
+    timer->long_target = (uint32_t)(target >> 32);
+
+    /* move the wheel to now so the new timer is sorted in relative to the
+     * current time */
+    _wheel_advance(now);
+    _add_timer_to_wheel(timer);
+
+    if (_next_event() != next) {
+        DEBUG("_set_target64(): timer is new next event. updating lltimer.\n");
+        _lltimer_update(now);
+    }
+}
+
+static void _remove(xtimer_t *timer)
+{
+    uint64_t next = _next_event();
+
+    _unlink(timer);
+
+    if (_next_event() != next) {
+        _lltimer_update(_now64_locked());
+    }
+}
+
+void _xtimer_set_slack64(xtimer_t *timer, uint32_t offset, uint32_t long_offset, uint32_t slack)
+{
+    DEBUG(" _xtimer_set_slack64() offset=%" PRIu32 " long_offset=%" PRIu32 " slack=%" PRIu32 "\n",
+          offset, long_offset, slack);
+    if (!timer->callback) {
+        DEBUG("timer_set(): timer has no callback.\n");
+        return;
+    }
+
+    xtimer_remove(timer);
+
+    if (!long_offset && (offset < XTIMER_BACKOFF)) {
+        _xtimer_spin(offset);
+        _shoot(timer);
+    }
+    else {
+        int state = irq_disable();
+        uint64_t now = _now64_locked();
+
+        /* timers are sorted in by the end of their tolerance window */
+        _xtimer_slack_set(timer, slack);
+        _set_target64(timer, now + (((uint64_t)long_offset << 32) | offset) + slack, now);
+        irq_restore(state);
+    }
+}
+
+void _xtimer_set64(xtimer_t *timer, uint32_t offset, uint32_t long_offset)
+{
+    _xtimer_set_slack64(timer, offset, long_offset, 0);
+}
+
+void _xtimer_set(xtimer_t *timer, uint32_t offset)
+{
+    _xtimer_set_slack64(timer, offset, 0, 0);
+}
+
+uint32_t xtimer_coalesced(void)
+{
+    return _coalesced;
+}
+
+uint32_t xtimer_wakeups(void)
+{
+    return _wakeups;
+}
+
+int xtimer_next_target(uint32_t *target)
+{
+    int res = -1;
+    unsigned state = irq_disable();
+    uint64_t next = _next_event();
+
+    if (next <= (_now64_locked() | LLTIMER_MAX)) {
+        *target = _xtimer_lltimer_mask((uint32_t)next);
+        res = 0;
+    }
+    else if (next != UINT64_MAX) {
+        res = 1;
+    }
+
+    irq_restore(state);
+    return res;
+}
+
+static void _periph_timer_callback(void *arg, int chan)
+{
+    (void)arg;
+    (void)chan;
+    _wakeups++;
+    _timer_callback();
+}
+
+int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
+{
+    uint32_t now = _xtimer_now();
+
+    DEBUG("timer_set_absolute(): now=%" PRIu32 " target=%" PRIu32 "\n", now, target);
+
+    timer->next = NULL;
+    if ((target >= now) && ((target - XTIMER_BACKOFF) < now)) {
+        /* backoff */
+        xtimer_spin_until(target + XTIMER_BACKOFF);
+        _shoot(timer);
+        return 0;
+    }
+
+    unsigned state = irq_disable();
+    if (_is_set(timer)) {
+        _remove(timer);
+    }
+
+    uint64_t now64 = _now64_locked();
+    _xtimer_slack_set(timer, 0);
+    uint64_t target64 = (now64 & 0xFFFFFFFF00000000ULL) | target;
+    if (target < (uint32_t)now64) {
+        target64 += (1ULL << 32);
+    }
+    _set_target64(timer, target64, now64);
+
+    irq_restore(state);
+
+    return 0;
+}
+
+void xtimer_remove(xtimer_t *timer)
+{
+    int state = irq_disable();
+    if (_is_set(timer)) {
+        _remove(timer);
+    }
+    irq_restore(state);
+}
+
+/**
+ * @brief main xtimer callback function
+ */
+static void _timer_callback(void)
+{
+    uint64_t now;
+
+    _in_handler = 1;
+
+    while (1) {
+        now = _now64_locked();
+
+        DEBUG("_timer_callback() now=%" PRIu32 "\n", (uint32_t)now);
+
+        _wheel_advance(now + XTIMER_ISR_BACKOFF);
+
+        /* fire all timers that are close to expiring (or within their
+         * tolerance window) */
+        xtimer_t *timer;
+        while ((timer = _next_due(now + XTIMER_ISR_BACKOFF))) {
+            uint64_t target = _target64(timer);
+
+            if (target > (now + XTIMER_ISR_BACKOFF)) {
+                /* this timer's own deadline is still ahead, it gets executed
+                 * along with the one that triggered this interrupt */
+                _coalesced++;
+            }
+
+            /* make sure we don't fire too early */
+            while (now < (target - _xtimer_slack(timer))) {
+                now = _now64_locked();
+            }
+
+            /* make sure timer is recognized as being already fired */
+            _unlink(timer);
+
+            _shoot(timer);
+        }
+
+        now = _now64_locked();
+        uint64_t next = _next_event();
+
+        if (next > (now | LLTIMER_MAX)) {
+            /* nothing to do in this timer period. If its end is very soon,
+             * spin until the overflow happened */
+            if ((LLTIMER_MAX - (uint32_t)_xtimer_lltimer_mask(now)) >= XTIMER_ISR_BACKOFF) {
+                break;
+            }
+            /* compare with now, the overflow might have happened already */
+            uint32_t lltimer = _xtimer_lltimer_mask((uint32_t)now);
+            while (_xtimer_lltimer_now() >= lltimer) {}
+        }
+        else if (next >= (now + XTIMER_ISR_BACKOFF + XTIMER_OVERHEAD)) {
+            break;
+        }
+    }
+
+    _in_handler = 0;
+
+    /* set low level timer */
+    _lltimer_update(now);
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compares post-to-execute latency and RAM usage of a shared
+ *              event handler thread with one message handling thread per
+ *              module
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "event/callback.h"
+#include "msg.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define TIMEOUT_S       (2ul)
+#define TIMEOUT         (TIMEOUT_S * US_PER_SEC)
+#define MODULES_NUMOF   (4U)
+#define MSG_QUEUE_SIZE  (8U)
+#define MSG_TYPE_CB     (0x4242)
+
+static char _event_stack[THREAD_STACKSIZE_DEFAULT];
+static char _msg_stacks[MODULES_NUMOF][THREAD_STACKSIZE_DEFAULT];
+static msg_t _msg_queues[MODULES_NUMOF][MSG_QUEUE_SIZE];
+static kernel_pid_t _msg_pids[MODULES_NUMOF];
+
+/**
+ * @brief   State of a "module" that defers work to a handler thread
+ */
+typedef struct {
+    uint32_t posted_at;         /**< time of the last post in us */
+    unsigned long executed;     /**< number of times the work was executed */
+    uint64_t latency;           /**< sum of post-to-execute latencies in us */
+    uint32_t max_latency;       /**< maximum post-to-execute latency in us */
+} _module_t;
+
+static event_queue_t _queue;
+static event_callback_t _events[MODULES_NUMOF];
+
+static _module_t _modules[MODULES_NUMOF];
+
+static void callback(void *done_)
+{
+    volatile int *done = done_;
+    *done = 1;
+}
+
+/* the deferred work of each "module" */
+static void _module_cb(void *arg)
+{
+    _module_t *module = arg;
+    uint32_t latency = xtimer_now_usec() - module->posted_at;
+
+    module->executed++;
+    module->latency += latency;
+    if (latency > module->max_latency) {
+        module->max_latency = latency;
+    }
+}
+
+static void *_event_thread(void *arg)
+{
+    (void)arg;
+    event_queue_init(&_queue);
+    event_loop(&_queue);
+    return NULL;
+}
+
+static void *_msg_thread(void *arg)
+{
+    msg_init_queue(arg, MSG_QUEUE_SIZE);
+    while (1) {
+        msg_t msg;
+
+        msg_receive(&msg);
+        if (msg.type == MSG_TYPE_CB) {
+            _module_cb(msg.content.ptr);
+        }
+    }
+    return NULL;
+}
+
+static unsigned _post_event(void)
+{
+    for (unsigned i = 0; i < MODULES_NUMOF; i++) {
+        _modules[i].posted_at = xtimer_now_usec();
+        event_post(&_queue, &_events[i].super);
+    }
+    return MODULES_NUMOF;
+}
+
+static unsigned _send_msg(void)
+{
+    for (unsigned i = 0; i < MODULES_NUMOF; i++) {
+        msg_t msg = { .type = MSG_TYPE_CB,
+                      .content = { .ptr = &_modules[i] } };
+
+        _modules[i].posted_at = xtimer_now_usec();
+        msg_send(&msg, _msg_pids[i]);
+    }
+    return MODULES_NUMOF;
+}
+
+static void run_test(const char *name, unsigned (*test)(void), size_t ram)
+{
+    volatile int done = 0;
+    unsigned long posted = 0;
+    unsigned long executed = 0;
+    uint64_t latency = 0;
+    uint32_t max_latency = 0;
+
+    memset(_modules, 0, sizeof(_modules));
+
+    xtimer_t xtimer;
+    xtimer.callback = callback;
+    xtimer.arg = (void *) &done;
+
+    xtimer_set(&xtimer, TIMEOUT);
+
+    do {
+        posted += test();
+    } while (done == 0);
+
+    for (unsigned i = 0; i < MODULES_NUMOF; i++) {
+        executed += _modules[i].executed;
+        latency += _modules[i].latency;
+        if (_modules[i].max_latency > max_latency) {
+            max_latency = _modules[i].max_latency;
+        }
+    }
+
+    printf("+ %s: %lu of %lu executed, post-to-execute latency %lu ns "
+           "average, %lu us maximum, %u bytes RAM\n",
+           name, executed, posted,
+           (unsigned long)((latency * 1000) / executed),
+           (unsigned long)max_latency, (unsigned)ram);
+}
+
+#define run_test(test, ram) run_test(#test, test, ram)
+
+int main(void)
+{
+    puts("Start.");
+
+    /* handler threads preempt main, so every post is executed right away */
+    thread_create(_event_stack, sizeof(_event_stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _event_thread, NULL, "event");
+    for (unsigned i = 0; i < MODULES_NUMOF; i++) {
+        event_callback_init(&_events[i], _module_cb, &_modules[i]);
+        _msg_pids[i] = thread_create(_msg_stacks[i], sizeof(_msg_stacks[i]),
+                                     THREAD_PRIORITY_MAIN - 1,
+                                     THREAD_CREATE_STACKTEST, _msg_thread,
+                                     _msg_queues[i], "msg");
+    }
+
+    run_test(_post_event, sizeof(_event_stack) + sizeof(thread_t) +
+                          sizeof(_queue) + sizeof(_events));
+    run_test(_send_msg, sizeof(_msg_stacks) +
+                        (MODULES_NUMOF * sizeof(thread_t)) +
+                        sizeof(_msg_queues));
+
+    puts("Done.");
+    return 0;
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief    evtimer_set_slack() test application
+ *
+ * Two groups of events lie within one tolerance window each, so every group
+ * must be handled with a single wake-up. The second group's window also
+ * contains an exact xtimer, which the evtimer's xtimer is coalesced with
+ * (`xtimer_slack` module).
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "evtimer_msg.h"
+#include "msg.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define SLACK           (60U)   /**< tolerance of the evtimer in ms */
+#define EXACT_OFFSET    (440U)  /**< offset of the exact xtimer in ms */
+#define WAKEUPS         (2U)    /**< expected number of wake-ups */
+#define MARGIN          (2U)    /**< interrupt latency and rounding in ms */
+#define GROUP_GAP       (20U)   /**< events closer than this share a wake-up */
+
+static evtimer_t evtimer;
+static evtimer_msg_event_t events[] = {
+    { .event = { .offset = 100 } },
+    { .event = { .offset = 120 } },
+    { .event = { .offset = 150 } },
+    { .event = { .offset = 400 } },
+    { .event = { .offset = 430 } },
+};
+
+#define NEVENTS ((unsigned)(sizeof(events) / sizeof(evtimer_msg_event_t)))
+
+static uint32_t offsets[NEVENTS];
+static uint32_t received[NEVENTS];
+static xtimer_t exact;
+static volatile uint32_t exact_fired_at;
+
+static void _exact_cb(void *arg)
+{
+    (void)arg;
+    exact_fired_at = xtimer_now_usec();
+}
+
+int main(void)
+{
+    msg_t msgs[NEVENTS];
+    uint32_t start, coalesced;
+    unsigned wakeups = 0;
+    bool success = true;
+
+    msg_init_queue(msgs, NEVENTS);
+    evtimer_init_msg(&evtimer);
+    evtimer_set_slack(&evtimer, SLACK);
+
+    printf("Testing evtimer with %u ms slack\n", SLACK);
+    coalesced = xtimer_coalesced();
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < NEVENTS; i++) {
+        offsets[i] = events[i].event.offset;
+        events[i].msg.content.value = i;
+        evtimer_add_msg(&evtimer, &events[i], sched_active_pid);
+    }
+    exact.callback = _exact_cb;
+    xtimer_set(&exact, EXACT_OFFSET * US_PER_MS);
+
+    for (unsigned i = 0; i < NEVENTS; i++) {
+        msg_t msg;
+
+        msg_receive(&msg);
+        received[msg.content.value] = (xtimer_now_usec() - start) / US_PER_MS;
+    }
+
+    for (unsigned i = 0; i < NEVENTS; i++) {
+        /* every event has its own target: the slack must not add up */
+        bool in_window = (received[i] >= offsets[i]) &&
+                         (received[i] <= (offsets[i] + SLACK + MARGIN));
+
+        if ((i == 0) || ((received[i] - received[i - 1]) > GROUP_GAP)) {
+            wakeups++;
+        }
+        printf("event %u: offset %lu ms received after %lu ms%s\n", i,
+               (unsigned long)offsets[i], (unsigned long)received[i],
+               in_window ? "" : " (out of window!)");
+        success &= in_window;
+    }
+    printf("%u wake-ups for %u events (expected %u)\n", wakeups, NEVENTS,
+           WAKEUPS);
+    success &= (wakeups == WAKEUPS);
+
+    coalesced = xtimer_coalesced() - coalesced;
+    printf("%lu timer interrupts avoided\n", (unsigned long)coalesced);
+#ifdef MODULE_XTIMER_SLACK
+    /* the second group's xtimer must run with the exact timer */
+    success &= (coalesced > 0);
+#endif
+    success &= (exact_fired_at != 0);
+
+    puts(success ? "SUCCESS" : "FAILURE");
+    return 0;
+}
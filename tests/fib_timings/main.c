@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures FIB next hop lookups for growing numbers of routes
+ *
+ * Every table size is measured with @ref fib_get_next_hop() and with a
+ * linear scan over all entries, as done by the FIB before it indexed its
+ * entries in a trie.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "net/fib.h"
+#include "net/fib/table.h"
+#include "universal_address.h"
+#include "xtimer.h"
+
+#define TIMEOUT_S       (1ul)
+#define TIMEOUT         (TIMEOUT_S * US_PER_SEC)
+#define ADDR_LEN        (16U)
+#define NEXT_HOPS       (4U)
+#define DSTS            (64U)
+#define PREFIX_LEN(i)   (48U + ((i) & 0xf))
+
+static const unsigned _routes_num[] = { 16, 64, 256, ROUTES_MAX };
+
+static fib_entry_t _entries[ROUTES_MAX + 1];
+static fib_table_t _table = { .data.entries = _entries,
+                              .table_type = FIB_TABLE_TYPE_SH,
+                              .size = ROUTES_MAX + 1 };
+static uint8_t _dsts[DSTS][ADDR_LEN];
+static unsigned _routes;
+
+static void callback(void *done_)
+{
+    volatile int *done = done_;
+    *done = 1;
+}
+
+/* 2001:db8:xxxx:yy00::/PREFIX_LEN(i), spread over the address space so
+ * that the routes share prefixes of various lengths */
+static void _prefix(unsigned i, uint8_t *addr)
+{
+    uint32_t hash = i * 2654435761U;
+
+    memset(addr, 0, ADDR_LEN);
+    addr[0] = 0x20;
+    addr[1] = 0x01;
+    addr[2] = 0x0d;
+    addr[3] = 0xb8;
+    addr[4] = hash >> 24;
+    addr[5] = hash >> 16;
+    addr[6] = hash >> 8;
+    addr[7] = (PREFIX_LEN(i) > 56) ? (hash & 0xf0) : 0;
+}
+
+static void _fill(unsigned routes)
+{
+    uint8_t addr[ADDR_LEN];
+    uint8_t next_hop[ADDR_LEN];
+
+    fib_deinit(&_table);
+    fib_init(&_table);
+    memset(next_hop, 0, sizeof(next_hop));
+    next_hop[0] = 0xfe;
+    next_hop[1] = 0x80;
+    /* default route */
+    memset(addr, 0, sizeof(addr));
+    fib_add_entry(&_table, 6, addr, ADDR_LEN, 0, next_hop, ADDR_LEN, 0,
+                  (uint32_t)FIB_LIFETIME_NO_EXPIRE);
+    for (unsigned i = 0; i < routes; i++) {
+        _prefix(i, addr);
+        next_hop[15] = (i % NEXT_HOPS) + 1;
+        fib_add_entry(&_table, 6, addr, ADDR_LEN,
+                      PREFIX_LEN(i) << FIB_FLAG_NET_PREFIX_SHIFT,
+                      next_hop, ADDR_LEN, 0, (uint32_t)FIB_LIFETIME_NO_EXPIRE);
+    }
+    /* destinations within the routes and (every fourth) off-route */
+    for (unsigned i = 0; i < DSTS; i++) {
+        _prefix((i & 0x3) ? (i * 7) % routes : routes + i, _dsts[i]);
+        _dsts[i][15] = i;
+    }
+    _routes = routes;
+}
+
+static unsigned _fib_get_next_hop(void)
+{
+    for (unsigned i = 0; i < DSTS; i++) {
+        kernel_pid_t iface;
+        uint8_t next_hop[ADDR_LEN];
+        size_t next_hop_size = sizeof(next_hop);
+        uint32_t next_hop_flags;
+
+        fib_get_next_hop(&_table, &iface, next_hop, &next_hop_size,
+                         &next_hop_flags, _dsts[i], ADDR_LEN, 0);
+    }
+    return DSTS;
+}
+
+/* longest prefix match comparing the destination to every entry */
+static unsigned _linear_scan(void)
+{
+    for (unsigned i = 0; i < DSTS; i++) {
+        fib_entry_t *best = NULL;
+        size_t best_len = 0;
+
+        for (unsigned j = 0; j < _table.size; j++) {
+            fib_entry_t *entry = &_table.data.entries[j];
+            size_t match_len = ADDR_LEN << 3;
+            int res;
+
+            if (entry->global == NULL) {
+                continue;
+            }
+            res = universal_address_compare(entry->global, _dsts[i], &match_len);
+            if (res == UNIVERSAL_ADDRESS_EQUAL) {
+                best = entry;
+                break;
+            }
+            else if ((res == UNIVERSAL_ADDRESS_MATCHING_PREFIX) &&
+                     (match_len >= (entry->global_flags >> FIB_FLAG_NET_PREFIX_SHIFT)) &&
+                     (match_len > best_len)) {
+                best = entry;
+                best_len = match_len;
+            }
+            else if ((res == UNIVERSAL_ADDRESS_IS_ALL_ZERO_ADDRESS) &&
+                     (best == NULL)) {
+                best = entry;
+            }
+        }
+        (void)best;
+    }
+    return DSTS;
+}
+
+static void run_test(const char *name, unsigned (*test)(void))
+{
+    volatile int done = 0;
+    unsigned long lookups = 0;
+
+    xtimer_t xtimer;
+    xtimer.callback = callback;
+    xtimer.arg = (void *) &done;
+
+    xtimer_set(&xtimer, TIMEOUT);
+
+    do {
+        lookups += test();
+    } while (done == 0);
+
+    printf("+ %s (%u routes): %lu lookups per second\n", name, _routes,
+           lookups / TIMEOUT_S);
+}
+
+#define run_test(test) run_test(#test, test)
+
+int main(void)
+{
+    puts("Start.");
+    fib_init(&_table);
+
+    for (unsigned i = 0; i < sizeof(_routes_num) / sizeof(_routes_num[0]); i++) {
+        _fill(_routes_num[i]);
+        printf("%d entries in use\n", fib_get_num_used_entries(&_table));
+        run_test(_fib_get_next_hop);
+        run_test(_linear_scan);
+    }
+
+    puts("Done.");
+    return 0;
+}
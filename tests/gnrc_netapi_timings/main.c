@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the latency of a UDP packet from a netdev_test device
+ *              through 6LoWPAN and IPv6 up to the receiving application
+ *
+ * Build once as is (one thread per layer) and once with `INLINE=1`
+ * (@ref net_gnrc_netapi_inline) to compare both modes.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "byteorder.h"
+#include "msg.h"
+#include "net/gnrc.h"
+#include "net/gnrc/netdev.h"
+#include "net/gnrc/netdev/ieee802154.h"
+#include "net/ieee802154.h"
+#include "net/inet_csum.h"
+#include "net/ipv6/hdr.h"
+#include "net/netdev_test.h"
+#include "net/protnum.h"
+#include "net/sixlowpan.h"
+#include "net/udp.h"
+#include "ps.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define TIMEOUT_S           (2ul)
+#define TIMEOUT             (TIMEOUT_S * US_PER_SEC)
+#define TEST_PORT           (61616U)
+#define TEST_PAYLOAD_LEN    (32U)
+
+#define _MAC_STACKSIZE      (THREAD_STACKSIZE_DEFAULT)
+#define _MAC_PRIO           (THREAD_PRIORITY_MAIN - 4)
+
+#define _MAIN_MSG_QUEUE_SIZE (4U)
+
+#ifdef MODULE_GNRC_NETAPI_INLINE
+#define MODE                "inline"
+#else
+#define MODE                "threaded"
+#endif
+
+static const uint8_t _src_l2[] = { 0x4f, 0x5e };
+static const uint8_t _dst_l2[] = { 0xff, 0xff };
+
+static char _mac_stack[_MAC_STACKSIZE];
+static gnrc_netdev_t _gnrc_dev;
+static netdev_test_t _dev;
+static msg_t _main_msg_queue[_MAIN_MSG_QUEUE_SIZE];
+static uint8_t _frame[IEEE802154_FRAME_LEN_MAX];
+static size_t _frame_len;
+
+static void callback(void *done_)
+{
+    volatile int *done = done_;
+    *done = 1;
+}
+
+/* builds an uncompressed 6LoWPAN frame carrying a UDP packet to ::1 */
+static void _build_frame(void)
+{
+    le_uint16_t pan = byteorder_btols(byteorder_htons(0x23));
+    size_t mhr_len = ieee802154_set_frame_hdr(_frame, _src_l2, sizeof(_src_l2),
+                                              _dst_l2, sizeof(_dst_l2),
+                                              pan, pan,
+                                              IEEE802154_FCF_TYPE_DATA, 0);
+    uint8_t *dispatch = &_frame[mhr_len];
+    ipv6_hdr_t *ipv6 = (ipv6_hdr_t *)(dispatch + 1);
+    udp_hdr_t *udp = (udp_hdr_t *)(ipv6 + 1);
+    uint16_t udp_len = sizeof(udp_hdr_t) + TEST_PAYLOAD_LEN;
+    uint16_t csum;
+
+    *dispatch = SIXLOWPAN_UNCOMP;
+    ipv6_hdr_set_version(ipv6);
+    ipv6->len = byteorder_htons(udp_len);
+    ipv6->nh = PROTNUM_UDP;
+    ipv6->hl = 64;
+    memcpy(&ipv6->src, &ipv6_addr_loopback, sizeof(ipv6->src));
+    memcpy(&ipv6->dst, &ipv6_addr_loopback, sizeof(ipv6->dst));
+    udp->src_port = byteorder_htons(TEST_PORT);
+    udp->dst_port = byteorder_htons(TEST_PORT);
+    udp->length = byteorder_htons(udp_len);
+    udp->checksum = byteorder_htons(0);
+    memset(udp + 1, 'x', TEST_PAYLOAD_LEN);
+
+    csum = ipv6_hdr_inet_csum(0, ipv6, PROTNUM_UDP, udp_len);
+    csum = ~inet_csum(csum, (uint8_t *)udp, udp_len);
+    udp->checksum = byteorder_htons((csum == 0) ? 0xffff : csum);
+
+    _frame_len = mhr_len + 1 + sizeof(ipv6_hdr_t) + udp_len;
+}
+
+/* netdev_test callbacks */
+static void _dev_isr(netdev_t *dev)
+{
+    dev->event_callback(dev, NETDEV_EVENT_RX_COMPLETE);
+}
+
+static int _dev_recv(netdev_t *dev, char *buf, int len, void *info)
+{
+    (void)dev;
+    (void)info;
+    if (buf == NULL) {
+        return _frame_len;
+    }
+    else if (len < (int)_frame_len) {
+        return -ENOBUFS;
+    }
+    memcpy(buf, _frame, _frame_len);
+    return _frame_len;
+}
+
+/* hands one frame to the stack and waits for its payload to arrive at the
+ * application; all stack threads preempt main, so only one packet is in
+ * flight at a time */
+static unsigned _recv_one(void)
+{
+    netdev_t *dev = (netdev_t *)&_dev;
+    msg_t msg;
+
+    dev->event_callback(dev, NETDEV_EVENT_ISR);
+    if ((xtimer_msg_receive_timeout(&msg, US_PER_SEC) < 0) ||
+        (msg.type != GNRC_NETAPI_MSG_TYPE_RCV)) {
+        return 0;
+    }
+    gnrc_pktbuf_release(msg.content.ptr);
+    return 1;
+}
+
+static void run_test(const char *name, unsigned (*test)(void))
+{
+    volatile int done = 0;
+    unsigned long sent = 0;
+    unsigned long received = 0;
+    uint32_t start;
+
+    xtimer_t xtimer;
+    xtimer.callback = callback;
+    xtimer.arg = (void *) &done;
+
+    start = xtimer_now_usec();
+    xtimer_set(&xtimer, TIMEOUT);
+
+    do {
+        received += test();
+        sent++;
+    } while (done == 0);
+
+    uint32_t duration = xtimer_now_usec() - start;
+
+    if (received == 0) {
+        printf("- %s (%s): FAILED, none of %lu packets received\n",
+               name, MODE, sent);
+        return;
+    }
+    printf("+ %s (%s): %lu of %lu received, %lu ns per packet\n",
+           name, MODE, received, sent,
+           (unsigned long)(((uint64_t)duration * 1000) / received));
+}
+
+#define run_test(test) run_test(#test, test)
+
+int main(void)
+{
+    gnrc_netreg_entry_t me = GNRC_NETREG_ENTRY_INIT_PID(TEST_PORT,
+                                                        sched_active_pid);
+    kernel_pid_t mac_pid;
+
+    puts("Start.");
+    msg_init_queue(_main_msg_queue, _MAIN_MSG_QUEUE_SIZE);
+    _build_frame();
+
+    netdev_test_setup(&_dev, NULL);
+    netdev_test_set_isr_cb(&_dev, _dev_isr);
+    netdev_test_set_recv_cb(&_dev, _dev_recv);
+    _dev.netdev.proto = GNRC_NETTYPE_SIXLOWPAN;
+    gnrc_netdev_ieee802154_init(&_gnrc_dev, (netdev_ieee802154_t *)&_dev);
+    mac_pid = gnrc_netdev_init(_mac_stack, _MAC_STACKSIZE, _MAC_PRIO,
+                               "netdev_test", &_gnrc_dev);
+    if (mac_pid <= KERNEL_PID_UNDEF) {
+        puts("Could not start MAC thread");
+        return 1;
+    }
+    gnrc_netreg_register(GNRC_NETTYPE_UDP, &me);
+
+    run_test(_recv_one);
+    ps();
+
+    puts("Done.");
+    return 0;
+}
@@ -19,7 +19,9 @@
  * @}
  */
 
+#include <inttypes.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "shell.h"
 #include "msg.h"
@@ -32,6 +34,15 @@
 #include "net/gnrc/netif.h"
 #include "net/gnrc/netif/hdr.h"
 #include "net/gnrc/pktdump.h"
+#include "net/gnrc/ipv6/hdr.h"
+#include "net/gnrc/sixlowpan.h"
+#include "net/gnrc/sixlowpan/iphc.h"
+#include "net/gnrc/udp.h"
+#include "utlist.h"
+#include "xtimer.h"
+
+/* number of packets compressed by the IPHC benchmark */
+#define BENCH_PKTS      (1000U)
 
 static void _init_interface(void)
 {
@@ -156,12 +167,126 @@ static void _send_packet(void)
     gnrc_netapi_dispatch_receive(GNRC_NETTYPE_SIXLOWPAN, GNRC_NETREG_DEMUX_CTX_ALL, pkt2);
 }
 
+/* builds a UDP packet from fd01::1 to fe80::ff:fe00:1 over link-layer
+ * address 02:00:00:ff:fe:00:00:01 */
+static gnrc_pktsnip_t *_build_pkt(kernel_pid_t iface, uint16_t checksum)
+{
+    ipv6_addr_t src = {{ 0xfd, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                         0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01 }};
+    ipv6_addr_t dst = {{ 0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                         0x00, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x01 }};
+    uint8_t l2dst[] = { 0x02, 0x00, 0x00, 0xFF, 0xFE, 0x00, 0x00, 0x01 };
+    uint8_t data[64] = { 0 };
+    gnrc_pktsnip_t *pkt, *ipv6, *netif;
+
+    pkt = gnrc_pktbuf_add(NULL, data, sizeof(data), GNRC_NETTYPE_UNDEF);
+    pkt = gnrc_udp_hdr_build(pkt, 61616, 61617);
+    ipv6 = gnrc_ipv6_hdr_build(pkt, &src, &dst);
+    netif = gnrc_netif_hdr_build(NULL, 0, l2dst, sizeof(l2dst));
+    if ((pkt == NULL) || (ipv6 == NULL) || (netif == NULL)) {
+        gnrc_pktbuf_release((ipv6 != NULL) ? ipv6 : pkt);
+        gnrc_pktbuf_release(netif);
+        return NULL;
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = iface;
+    ((ipv6_hdr_t *)ipv6->data)->hl = 64;
+    ((udp_hdr_t *)pkt->data)->checksum = byteorder_htons(checksum);
+    LL_PREPEND(ipv6, netif);
+    return netif;
+}
+
+static void _bench_iphc(void)
+{
+    kernel_pid_t ifs[GNRC_NETIF_NUMOF];
+    uint32_t total = 0;
+    unsigned done = 0;
+
+    gnrc_netif_get(ifs);
+
+    for (unsigned i = 0; i < BENCH_PKTS; i++) {
+        /* vary the checksum, as a real flow would */
+        gnrc_pktsnip_t *netif = _build_pkt(ifs[0], (uint16_t)i);
+        uint32_t start;
+
+        if (netif == NULL) {
+            puts("IPHC benchmark: packet buffer full");
+            return;
+        }
+        start = xtimer_now_usec();
+        if (gnrc_sixlowpan_iphc_encode(netif)) {
+            done++;
+        }
+        total += xtimer_now_usec() - start;
+        gnrc_pktbuf_release(netif);
+    }
+    printf("IPHC: %u packets compressed in %" PRIu32 " us\n", done, total);
+}
+
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_CACHE
+/* compresses a packet of the benchmark flow and copies the dispatch to buf */
+static size_t _encode(kernel_pid_t iface, uint8_t *buf, size_t buf_len)
+{
+    gnrc_pktsnip_t *netif = _build_pkt(iface, 0x1234);
+    size_t len = 0;
+
+    if ((netif != NULL) && gnrc_sixlowpan_iphc_encode(netif) &&
+        (netif->next->size <= buf_len)) {
+        len = netif->next->size;
+        memcpy(buf, netif->next->data, len);
+    }
+    gnrc_pktbuf_release(netif);
+    return len;
+}
+
+static void _test_iphc_cache(void)
+{
+    kernel_pid_t ifs[GNRC_NETIF_NUMOF];
+    const gnrc_sixlowpan_iphc_cache_stats_t *stats = gnrc_sixlowpan_iphc_cache_get_stats();
+    uint8_t fresh[sizeof(ipv6_hdr_t) + sizeof(udp_hdr_t)];
+    uint8_t cached[sizeof(ipv6_hdr_t) + sizeof(udp_hdr_t)];
+    uint8_t l2src[GNRC_NETIF_HDR_L2ADDR_MAX_LEN];
+    size_t fresh_len, cached_len;
+    uint32_t hits, invalidations;
+    int l2src_len;
+
+    gnrc_netif_get(ifs);
+    printf("IPHC cache: %" PRIu32 " hits, %" PRIu32 " misses\n",
+           stats->hits, stats->misses);
+
+    /* a cache hit must yield exactly what compression itself would */
+    gnrc_sixlowpan_iphc_cache_invalidate();
+    fresh_len = _encode(ifs[0], fresh, sizeof(fresh));
+    hits = stats->hits;
+    cached_len = _encode(ifs[0], cached, sizeof(cached));
+    printf("IPHC cache: hit %s to fresh encoding\n",
+           ((stats->hits != hits) && (fresh_len > 0) &&
+            (cached_len == fresh_len) &&
+            (memcmp(cached, fresh, fresh_len) == 0)) ? "identical"
+                                                     : "not identical");
+
+    /* setting the link-layer address, even to the same one, must drop the
+     * compressed headers derived from it */
+    invalidations = stats->invalidations;
+    l2src_len = gnrc_netapi_get(ifs[0], NETOPT_ADDRESS, 0, l2src, sizeof(l2src));
+    if ((l2src_len > 0) &&
+        (gnrc_netapi_set(gnrc_sixlowpan_init(), NETOPT_ADDRESS, ifs[0],
+                         l2src, l2src_len) >= 0)) {
+        printf("IPHC cache: %sinvalidated on link-layer address change\n",
+               (stats->invalidations != invalidations) ? "" : "not ");
+    }
+}
+#endif
+
 int main(void)
 {
     puts("RIOT network stack example application");
 
     _init_interface();
     _send_packet();
+    _bench_iphc();
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_CACHE
+    _test_iphc_cache();
+#endif
 
     return 0;
 }
@@ -76,5 +76,11 @@ def testfunc(child):
     child.expect_exact("source address: fe80::ff:fe00:2")
     child.expect_exact("destination address: fd01::1")
 
+    # IPHC benchmark
+    child.expect(r"IPHC: 1000 packets compressed in \d+ us")
+    if os.environ.get('IPHC_CACHE', '1') == '1':
+        child.expect_exact("IPHC cache: hit identical to fresh encoding")
+        child.expect_exact("IPHC cache: invalidated on link-layer address change")
+
 if __name__ == "__main__":
     sys.exit(testrunner.run(testfunc))
@@ -0,0 +1,261 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Stresses the 6LoWPAN reassembly buffer with fragments of
+ *              many senders interleaved
+ *
+ * Every sender transmits one datagram per round. The fragments of all
+ * senders are interleaved, and every other sender sends its fragments in
+ * reverse order. All datagrams must be reassembled intact, and incomplete
+ * datagrams must be dropped once they timed out without any further
+ * fragment arriving, including a single fragment arriving at an idle
+ * reassembly buffer. After each test, the packet buffer must be empty.
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "byteorder.h"
+#include "msg.h"
+#include "net/gnrc.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/ipv6/hdr.h"
+#include "net/protnum.h"
+#include "net/sixlowpan.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define ROUNDS              (20U)
+#define DATAGRAM_SIZE       (320U)
+#define FRAG_PAYLOAD        (64U)
+#define FRAGS               (DATAGRAM_SIZE / FRAG_PAYLOAD)
+#define L2ADDR_LEN          (8U)
+
+#define _MAIN_MSG_QUEUE_SIZE (8U)
+
+typedef struct {
+    gnrc_netif_hdr_t hdr;
+    uint8_t src[L2ADDR_LEN];
+    uint8_t dst[L2ADDR_LEN];
+} _netif_hdr_t;
+
+static msg_t _main_msg_queue[_MAIN_MSG_QUEUE_SIZE];
+static uint8_t _datagram[DATAGRAM_SIZE];
+static uint8_t _frag[sizeof(sixlowpan_frag_n_t) + FRAG_PAYLOAD];
+static unsigned _received;
+static unsigned _corrupted;
+static unsigned _failed;
+
+/* the datagram of each sender differs in every round */
+static void _build_datagram(uint8_t *buf, unsigned src, uint16_t tag)
+{
+    ipv6_hdr_t *ipv6 = (ipv6_hdr_t *)buf;
+
+    memset(ipv6, 0, sizeof(ipv6_hdr_t));
+    ipv6_hdr_set_version(ipv6);
+    ipv6->len = byteorder_htons(DATAGRAM_SIZE - sizeof(ipv6_hdr_t));
+    ipv6->nh = PROTNUM_IPV6_NONXT;
+    ipv6->hl = 64;
+    ipv6->src.u8[0] = 0xfe;
+    ipv6->src.u8[1] = 0x80;
+    ipv6->src.u8[15] = (uint8_t)src;
+    ipv6->dst.u8[0] = 0xfe;
+    ipv6->dst.u8[1] = 0x80;
+    ipv6->dst.u8[15] = 0xff;
+    for (unsigned i = sizeof(ipv6_hdr_t); i < DATAGRAM_SIZE; i++) {
+        buf[i] = (uint8_t)(src + tag + i);
+    }
+}
+
+/* checks and releases all reassembled datagrams */
+static void _collect(void)
+{
+    msg_t msg;
+
+    while (msg_try_receive(&msg) == 1) {
+        gnrc_pktsnip_t *pkt = msg.content.ptr;
+        gnrc_pktsnip_t *netif = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_NETIF);
+
+        if ((msg.type != GNRC_NETAPI_MSG_TYPE_RCV) || (netif == NULL)) {
+            continue;
+        }
+        uint8_t *src = gnrc_netif_hdr_get_src_addr(netif->data);
+        uint16_t tag = 0;
+
+        /* the tag is not part of the datagram, so check against all rounds */
+        while ((tag < ROUNDS) && (pkt->size == DATAGRAM_SIZE)) {
+            _build_datagram(_datagram, src[L2ADDR_LEN - 1], tag);
+            if (memcmp(pkt->data, _datagram, DATAGRAM_SIZE) == 0) {
+                break;
+            }
+            tag++;
+        }
+        if (tag < ROUNDS) {
+            _received++;
+        }
+        else {
+            _corrupted++;
+        }
+        gnrc_pktbuf_release(pkt);
+    }
+}
+
+/* hands fragment number idx of the datagram of src to the 6LoWPAN thread */
+static void _send_frag(unsigned src, uint16_t tag, unsigned idx)
+{
+    _netif_hdr_t netif_hdr = {
+        .src = { 0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, (uint8_t)src },
+        .dst = { 0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0xff },
+    };
+    sixlowpan_frag_n_t *hdr = (sixlowpan_frag_n_t *)_frag;
+    gnrc_pktsnip_t *netif, *pkt;
+    size_t len;
+
+    gnrc_netif_hdr_init(&netif_hdr.hdr, L2ADDR_LEN, L2ADDR_LEN);
+    _build_datagram(_datagram, src, tag);
+    hdr->disp_size = byteorder_htons(DATAGRAM_SIZE);
+    hdr->tag = byteorder_htons(tag);
+    if (idx == 0) {
+        hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
+        _frag[sizeof(sixlowpan_frag_t)] = SIXLOWPAN_UNCOMP;
+        memcpy(&_frag[sizeof(sixlowpan_frag_t) + 1], _datagram, FRAG_PAYLOAD);
+        len = sizeof(sixlowpan_frag_t) + 1 + FRAG_PAYLOAD;
+    }
+    else {
+        hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_N_DISP;
+        hdr->offset = (uint8_t)((idx * FRAG_PAYLOAD) / 8);
+        memcpy(hdr + 1, &_datagram[idx * FRAG_PAYLOAD], FRAG_PAYLOAD);
+        len = sizeof(sixlowpan_frag_n_t) + FRAG_PAYLOAD;
+    }
+
+    netif = gnrc_pktbuf_add(NULL, &netif_hdr, sizeof(netif_hdr),
+                            GNRC_NETTYPE_NETIF);
+    pkt = gnrc_pktbuf_add(netif, _frag, len, GNRC_NETTYPE_SIXLOWPAN);
+    if (pkt == NULL) {
+        puts("packet buffer full");
+        gnrc_pktbuf_release(netif);
+        return;
+    }
+    if (!gnrc_netapi_dispatch_receive(GNRC_NETTYPE_SIXLOWPAN,
+                                      GNRC_NETREG_DEMUX_CTX_ALL, pkt)) {
+        puts("6LoWPAN thread not running");
+        gnrc_pktbuf_release(pkt);
+    }
+    _collect();
+}
+
+/* sends FRAGS - skip fragments of every sender, starting at a different
+ * sender and going in a different direction for each fragment position */
+static void _send_round(uint16_t tag, unsigned skip)
+{
+    for (unsigned pos = 0; pos < (FRAGS - skip); pos++) {
+        for (unsigned i = 0; i < SOURCES; i++) {
+            unsigned src = (i + (pos * 7)) % SOURCES;
+            unsigned idx = (src & 1) ? (FRAGS - 1 - pos) : pos;
+
+            _send_frag(src, tag, idx);
+        }
+    }
+}
+
+static void test_interleaved(void)
+{
+    uint32_t start = xtimer_now_usec();
+
+    _received = 0;
+    _corrupted = 0;
+    for (uint16_t tag = 0; tag < ROUNDS; tag++) {
+        _send_round(tag, 0);
+    }
+
+    uint32_t duration = xtimer_now_usec() - start;
+    bool ok = (_received == (ROUNDS * SOURCES)) && (_corrupted == 0) &&
+              gnrc_pktbuf_is_empty();
+
+    printf("%c interleaved: %u of %u datagrams from %u sources reassembled, "
+           "%u corrupted, packet buffer %s, %lu us per fragment\n",
+           ok ? '+' : '-', _received, ROUNDS * SOURCES, (unsigned)SOURCES,
+           _corrupted, gnrc_pktbuf_is_empty() ? "empty" : "not empty",
+           (unsigned long)(duration / (ROUNDS * SOURCES * FRAGS)));
+    if (!ok) {
+        _failed++;
+    }
+}
+
+static void test_timeout(void)
+{
+    bool pending;
+
+    _received = 0;
+    _corrupted = 0;
+    _send_round(ROUNDS, 1);
+    pending = !gnrc_pktbuf_is_empty();
+    /* no further fragment arrives, expiry has to be driven by a timer */
+    xtimer_usleep(RBUF_TIMEOUT + (RBUF_TIMEOUT / 4));
+    _collect();
+
+    bool ok = (_received == 0) && (_corrupted == 0) && pending &&
+              gnrc_pktbuf_is_empty();
+
+    printf("%c timeout: %u incomplete datagrams reassembled, "
+           "buffered before timeout: %s, after timeout: %s\n", ok ? '+' : '-',
+           _received, pending ? "yes" : "no",
+           gnrc_pktbuf_is_empty() ? "no" : "yes");
+    if (!ok) {
+        _failed++;
+    }
+}
+
+static void test_single_fragment(void)
+{
+    bool pending;
+
+    _received = 0;
+    _corrupted = 0;
+    /* the reassembly buffer is idle, so the fragment creates its only entry */
+    _send_frag(0, ROUNDS + 1, 1);
+    pending = !gnrc_pktbuf_is_empty();
+    xtimer_usleep(RBUF_TIMEOUT + (RBUF_TIMEOUT / 4));
+    _collect();
+
+    bool ok = (_received == 0) && (_corrupted == 0) && pending &&
+              gnrc_pktbuf_is_empty();
+
+    printf("%c single fragment: buffered before timeout: %s, "
+           "after timeout: %s\n", ok ? '+' : '-', pending ? "yes" : "no",
+           gnrc_pktbuf_is_empty() ? "no" : "yes");
+    if (!ok) {
+        _failed++;
+    }
+}
+
+int main(void)
+{
+    gnrc_netreg_entry_t me = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
+                                                        sched_active_pid);
+
+    puts("Start.");
+    msg_init_queue(_main_msg_queue, _MAIN_MSG_QUEUE_SIZE);
+    gnrc_netreg_register(GNRC_NETTYPE_IPV6, &me);
+
+    test_interleaved();
+    test_timeout();
+    test_single_fragment();
+    gnrc_pktbuf_stats();
+
+    puts(_failed ? "FAILURE" : "SUCCESS");
+    return 0;
+}
@@ -0,0 +1,27 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2017 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+import testrunner
+
+
+def testfunc(child):
+    child.expect(r"\+ interleaved: (\d+) of (\d+) datagrams from \d+ sources "
+                 r"reassembled, 0 corrupted, packet buffer empty")
+    assert(child.match.group(1) == child.match.group(2))
+    child.expect(r"\+ timeout: 0 incomplete datagrams reassembled, "
+                 r"buffered before timeout: yes, after timeout: no")
+    child.expect_exact("+ single fragment: buffered before timeout: yes, "
+                       "after timeout: no")
+    child.expect_exact("SUCCESS")
+
+if __name__ == "__main__":
+    sys.exit(testrunner.run(testfunc, timeout=60))
@@ -0,0 +1,346 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the latency of fragmented datagrams over a chain of
+ *              6LoWPAN routers and the packet buffer used on the way
+ *
+ * The stack of this node plays all routers of the chain: every fragment it
+ * sends over its (simulated) interface is handed back to it as received by
+ * the next router, until it passed @ref HOPS routers. The processing time of
+ * every fragment is measured and combined with the air time of 250 kbit/s
+ * IEEE 802.15.4 frames to get the end-to-end latency.
+ *
+ * Build once as is (@ref net_gnrc_sixlowpan_frag_vrb) and once with `VRB=0`
+ * (reassembly on every hop) to compare both modes.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "byteorder.h"
+#include "msg.h"
+#include "net/fib.h"
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/ipv6/flowc.h"
+#include "net/gnrc/ipv6/netif.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/sixlowpan/netif.h"
+#include "net/protnum.h"
+#include "net/sixlowpan.h"
+#include "net/udp.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+#include "net/gnrc/sixlowpan/frag/vrb.h"
+#define MODE                "vrb"
+#else
+#define MODE                "reassembly"
+#endif
+
+#define DATAGRAMS           (16U)
+#define IPHC_LEN            (2U + 1U + (2U * sizeof(ipv6_addr_t)))
+#define FRAG1_PAYLOAD       (56U)
+#define FRAG1_COVERED       (sizeof(ipv6_hdr_t) + sizeof(udp_hdr_t) + FRAG1_PAYLOAD)
+#define FRAGN_PAYLOAD       (96U)
+#define FRAGN_NUMOF         (12U)
+#define DATAGRAM_SIZE       (FRAG1_COVERED + (FRAGN_NUMOF * FRAGN_PAYLOAD))
+#define L2ADDR_LEN          (8U)
+#define MAX_FRAG_SIZE       (104U)  /* 127 - MAC header (21) - FCS (2) */
+#define FRAME_OVERHEAD      (29U)   /* PHY header, MAC header and FCS */
+#define US_PER_BYTE         (32U)   /* 250 kbit/s */
+#define QUEUE_SIZE          (FRAGN_NUMOF * 2 * (HOPS + 1))
+
+#define _MAIN_MSG_QUEUE_SIZE (32U)
+
+typedef struct {
+    gnrc_netif_hdr_t hdr;
+    uint8_t src[L2ADDR_LEN];
+    uint8_t dst[L2ADDR_LEN];
+} _netif_hdr_t;
+
+typedef struct {
+    uint32_t ready;             /* time the frame is received completely */
+    uint8_t link;               /* link the frame was sent over */
+    uint8_t len;                /* length of the 6LoWPAN frame; 0 if unused */
+    uint8_t data[MAX_FRAG_SIZE];
+} _frame_t;
+
+static const ipv6_addr_t _src = { {
+        0x20, 0x01, 0x0d, 0xb8, 0x00, 0x01, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01
+    } };
+static const ipv6_addr_t _dst = { {
+        0x20, 0x01, 0x0d, 0xb8, 0x00, 0x02, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01
+    } };
+static const ipv6_addr_t _next_hop = { {
+        0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x01
+    } };
+static uint8_t _next_hop_l2[] = { 0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x01 };
+
+static msg_t _main_msg_queue[_MAIN_MSG_QUEUE_SIZE];
+static _frame_t _queue[QUEUE_SIZE];
+static uint32_t _link_free[HOPS + 1];
+static uint32_t _cpu_free[HOPS];
+static uint32_t _delivered_at;
+static unsigned _delivered;
+static unsigned long _dropped;
+static uint64_t _processing;
+
+static inline uint32_t _airtime(size_t len)
+{
+    return (len + FRAME_OVERHEAD) * US_PER_BYTE;
+}
+
+static size_t _build_frag(uint8_t *buf, uint16_t tag, unsigned idx)
+{
+    sixlowpan_frag_n_t *hdr = (sixlowpan_frag_n_t *)buf;
+
+    hdr->disp_size = byteorder_htons(DATAGRAM_SIZE);
+    hdr->tag = byteorder_htons(tag);
+    if (idx == 0) {
+        uint8_t *iphc = buf + sizeof(sixlowpan_frag_t);
+        udp_hdr_t *udp = (udp_hdr_t *)(iphc + IPHC_LEN);
+
+        hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
+        /* traffic class and flow label elided, hop limit 255, next header
+         * and addresses inline */
+        iphc[0] = SIXLOWPAN_IPHC1_DISP | SIXLOWPAN_IPHC1_TF | SIXLOWPAN_IPHC1_HL;
+        iphc[1] = 0;
+        iphc[2] = PROTNUM_UDP;
+        memcpy(&iphc[3], &_src, sizeof(_src));
+        memcpy(&iphc[3 + sizeof(_src)], &_dst, sizeof(_dst));
+        udp->src_port = byteorder_htons(61616U);
+        udp->dst_port = byteorder_htons(61616U);
+        udp->length = byteorder_htons(DATAGRAM_SIZE - sizeof(ipv6_hdr_t));
+        udp->checksum = byteorder_htons(0);
+        memset(udp + 1, (uint8_t)tag, FRAG1_PAYLOAD);
+        return sizeof(sixlowpan_frag_t) + IPHC_LEN + sizeof(udp_hdr_t) +
+               FRAG1_PAYLOAD;
+    }
+    hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_N_DISP;
+    hdr->offset = (uint8_t)((FRAG1_COVERED + ((idx - 1) * FRAGN_PAYLOAD)) / 8);
+    memset(hdr + 1, (uint8_t)tag, FRAGN_PAYLOAD);
+    return sizeof(sixlowpan_frag_n_t) + FRAGN_PAYLOAD;
+}
+
+/* sends a fragment over link, not before time sent */
+static void _enqueue(uint8_t link, const uint8_t *data, size_t len,
+                     uint32_t sent)
+{
+    uint32_t ready = (_link_free[link] > sent) ? _link_free[link] : sent;
+
+    ready += _airtime(len);
+    _link_free[link] = ready;
+    if (link == HOPS) {
+        sixlowpan_frag_n_t *hdr = (sixlowpan_frag_n_t *)data;
+
+        /* the destination only counts complete datagrams */
+        if (((hdr->disp_size.u8[0] & SIXLOWPAN_FRAG_DISP_MASK) == SIXLOWPAN_FRAG_N_DISP) &&
+            (((hdr->offset * 8U) + len - sizeof(sixlowpan_frag_n_t)) == DATAGRAM_SIZE)) {
+            _delivered++;
+        }
+        _delivered_at = ready;
+        return;
+    }
+    for (unsigned i = 0; i < QUEUE_SIZE; i++) {
+        if (_queue[i].len == 0) {
+            _queue[i].ready = ready;
+            _queue[i].link = link;
+            _queue[i].len = len;
+            memcpy(_queue[i].data, data, len);
+            return;
+        }
+    }
+    _dropped++;
+}
+
+/* takes all fragments the stack sent over the interface */
+static void _collect(uint8_t link, uint32_t sent)
+{
+    msg_t msg, reply = { .type = GNRC_NETAPI_MSG_TYPE_ACK };
+    uint8_t data[MAX_FRAG_SIZE];
+
+    while (msg_try_receive(&msg) == 1) {
+        gnrc_pktsnip_t *pkt = msg.content.ptr;
+        size_t len = 0;
+
+        if (msg.type != GNRC_NETAPI_MSG_TYPE_SND) {
+            reply.content.value = (uint32_t)(-ENOTSUP);
+            msg_reply(&msg, &reply);
+            continue;
+        }
+        if (gnrc_pkt_len(pkt->next) <= sizeof(data)) {
+            for (gnrc_pktsnip_t *ptr = pkt->next; ptr != NULL; ptr = ptr->next) {
+                memcpy(&data[len], ptr->data, ptr->size);
+                len += ptr->size;
+            }
+            _enqueue(link, data, len, sent);
+        }
+        else {
+            _dropped++;
+        }
+        gnrc_pktbuf_release(pkt);
+    }
+}
+
+/* hands a fragment to the router at the end of its link */
+static void _receive(_frame_t *frame)
+{
+    _netif_hdr_t netif_hdr = {
+        .src = { 0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x01, frame->link },
+        .dst = { 0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x01, frame->link + 1 },
+    };
+    gnrc_pktsnip_t *netif, *pkt;
+
+    gnrc_netif_hdr_init(&netif_hdr.hdr, L2ADDR_LEN, L2ADDR_LEN);
+    netif_hdr.hdr.if_pid = sched_active_pid;
+    netif = gnrc_pktbuf_add(NULL, &netif_hdr, sizeof(netif_hdr),
+                            GNRC_NETTYPE_NETIF);
+    pkt = gnrc_pktbuf_add(netif, frame->data, frame->len, GNRC_NETTYPE_SIXLOWPAN);
+    if (pkt == NULL) {
+        puts("packet buffer full");
+        gnrc_pktbuf_release(netif);
+        return;
+    }
+    /* all stack threads preempt main, so the fragment is handled completely
+     * when this returns */
+    if (!gnrc_netapi_dispatch_receive(GNRC_NETTYPE_SIXLOWPAN,
+                                      GNRC_NETREG_DEMUX_CTX_ALL, pkt)) {
+        puts("6LoWPAN thread not running");
+        gnrc_pktbuf_release(pkt);
+    }
+}
+
+static _frame_t *_next_frame(void)
+{
+    _frame_t *res = NULL;
+
+    for (unsigned i = 0; i < QUEUE_SIZE; i++) {
+        if ((_queue[i].len > 0) &&
+            ((res == NULL) || ((int32_t)(_queue[i].ready - res->ready) < 0))) {
+            res = &_queue[i];
+        }
+    }
+    return res;
+}
+
+/* sends one datagram over all hops and returns its end-to-end latency. With
+ * dup, the second fragment is sent twice */
+static uint32_t _send_datagram(uint16_t tag, bool dup)
+{
+    uint8_t data[MAX_FRAG_SIZE];
+    _frame_t *frame;
+
+    memset(_link_free, 0, sizeof(_link_free));
+    memset(_cpu_free, 0, sizeof(_cpu_free));
+    _delivered_at = 0;
+    for (unsigned i = 0; i <= FRAGN_NUMOF; i++) {
+        _enqueue(0, data, _build_frag(data, tag, i), 0);
+        if (dup && (i == 1)) {
+            _enqueue(0, data, _build_frag(data, tag, i), 0);
+        }
+    }
+    while ((frame = _next_frame()) != NULL) {
+        uint8_t link = frame->link;
+        uint32_t start = xtimer_now_usec(), duration;
+
+        _receive(frame);
+        duration = xtimer_now_usec() - start;
+        frame->len = 0;
+        _processing += duration;
+        /* every router on the chain has a CPU of its own */
+        if (_cpu_free[link] < frame->ready) {
+            _cpu_free[link] = frame->ready;
+        }
+        _cpu_free[link] += duration;
+        /* the router at the end of link sends over link + 1 */
+        _collect(link + 1, _cpu_free[link]);
+    }
+    return _delivered_at;
+}
+
+static void test_forward(void)
+{
+    uint64_t latency = 0;
+
+    _delivered = 0;
+    _dropped = 0;
+    _processing = 0;
+    for (uint16_t tag = 0; tag < DATAGRAMS; tag++) {
+        latency += _send_datagram(tag, false);
+    }
+    printf("+ forward (%s): %u of %u datagrams (%u bytes) delivered over %u "
+           "hops, %lu frames dropped, %lu us end-to-end latency, "
+           "%lu us processing per hop\n", MODE, _delivered, DATAGRAMS,
+           (unsigned)DATAGRAM_SIZE, (unsigned)HOPS, _dropped,
+           (unsigned long)(latency / DATAGRAMS),
+           (unsigned long)(_processing / (DATAGRAMS * HOPS)));
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+    const gnrc_sixlowpan_frag_vrb_stats_t *stats = gnrc_sixlowpan_frag_vrb_get_stats();
+
+    printf("+ vrb: %lu datagrams, %lu fragments forwarded, %lu evictions\n",
+           (unsigned long)stats->datagrams, (unsigned long)stats->fragments,
+           (unsigned long)stats->evictions);
+#endif
+}
+
+static void test_duplicates(void)
+{
+    _delivered = 0;
+    _dropped = 0;
+    for (uint16_t tag = DATAGRAMS; tag < (2 * DATAGRAMS); tag++) {
+        _send_datagram(tag, true);
+    }
+    printf("%c duplicates (%s): %u of %u datagrams with a duplicate fragment "
+           "delivered, %lu frames dropped\n",
+           (_delivered == DATAGRAMS) ? '+' : '-', MODE, _delivered,
+           DATAGRAMS, _dropped);
+}
+
+int main(void)
+{
+    kernel_pid_t iface = sched_active_pid;
+    gnrc_ipv6_netif_t *ipv6_if;
+
+    puts("Start.");
+    msg_init_queue(_main_msg_queue, _MAIN_MSG_QUEUE_SIZE);
+
+    /* this thread acts as the 6LoWPAN interface of the routers */
+    gnrc_netif_add(iface);
+    ipv6_if = gnrc_ipv6_netif_get(iface);
+    ipv6_if->flags |= GNRC_IPV6_NETIF_FLAGS_SIXLOWPAN;
+    gnrc_sixlowpan_netif_add(iface, MAX_FRAG_SIZE);
+    fib_add_entry(&gnrc_ipv6_fib_table, iface, (uint8_t *)&_dst,
+                  sizeof(ipv6_addr_t), (64UL << FIB_FLAG_NET_PREFIX_SHIFT),
+                  (uint8_t *)&_next_hop, sizeof(ipv6_addr_t), 0,
+                  (uint32_t)FIB_LIFETIME_NO_EXPIRE);
+    /* the route is known before the first datagram arrives */
+    gnrc_ipv6_flowc_add(gnrc_ipv6_flowc_gen(), KERNEL_PID_UNDEF, &_dst, iface,
+                        _next_hop_l2, sizeof(_next_hop_l2));
+
+    test_forward();
+    test_duplicates();
+    gnrc_pktbuf_stats();
+
+    puts("Done.");
+    return 0;
+}
@@ -22,6 +22,7 @@
 #include <stdint.h>
 #include <stdio.h>
 
+#include "net/gnrc/sock/udp.h"
 #include "net/sock/udp.h"
 #include "xtimer.h"
 
@@ -32,6 +33,7 @@
 
 static uint8_t _test_buffer[_TEST_BUFFER_SIZE];
 static sock_udp_t _sock, _sock2;
+static char _ext_data[] = "ABCD";
 
 #define CALL(fn)            puts("Calling " # fn); fn; tear_down()
 
@@ -651,6 +653,52 @@ static void test_sock_udp_send__no_sock(void)
     assert(_check_net());
 }
 
+static void _ext_cb(void *arg, const void *data, size_t size)
+{
+    assert((data == _ext_data) && (size == sizeof(_ext_data)));
+    (*((unsigned *)arg))++;
+}
+
+static void test_gnrc_sock_udp_send_ext__EINVAL_port(void)
+{
+    static const sock_udp_ep_t remote = { .addr = { .ipv6 = _TEST_ADDR_REMOTE },
+                                          .family = AF_INET6 };
+    unsigned cb_calls = 0;
+
+    assert(-EINVAL == gnrc_sock_udp_send_ext(NULL, _ext_data, sizeof(_ext_data),
+                                             &remote, _ext_cb, &cb_calls));
+    /* data was never referenced, but cb is called anyway */
+    assert(cb_calls == 1);
+    assert(_check_net());
+}
+
+static void test_gnrc_sock_udp_send_ext__unsocketed(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const sock_udp_ep_t local = { .addr = { .ipv6 = _TEST_ADDR_LOCAL },
+                                         .family = AF_INET6,
+                                         .netif = _TEST_NETIF,
+                                         .port = _TEST_PORT_LOCAL };
+    static const sock_udp_ep_t remote = { .addr = { .ipv6 = _TEST_ADDR_REMOTE },
+                                          .family = AF_INET6,
+                                          .port = _TEST_PORT_REMOTE };
+    unsigned cb_calls = 0;
+
+    assert(0 == sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP));
+    assert(sizeof(_ext_data) == gnrc_sock_udp_send_ext(&_sock, _ext_data,
+                                                       sizeof(_ext_data), &remote,
+                                                       _ext_cb, &cb_calls));
+    /* packet still waits to be checked and references the data */
+    assert(cb_calls == 0);
+    assert(_check_packet(&src_addr, &dst_addr, _TEST_PORT_LOCAL,
+                         _TEST_PORT_REMOTE, _ext_data, sizeof(_ext_data),
+                         _TEST_NETIF, false));
+    xtimer_usleep(1000);    /* let GNRC stack finish */
+    assert(cb_calls == 1);
+    assert(_check_net());
+}
+
 int main(void)
 {
     _net_init();
@@ -697,6 +745,8 @@ int main(void)
     CALL(test_sock_udp_send__unsocketed());
     CALL(test_sock_udp_send__no_sock_no_netif());
     CALL(test_sock_udp_send__no_sock());
+    CALL(test_gnrc_sock_udp_send_ext__EINVAL_port());
+    CALL(test_gnrc_sock_udp_send_ext__unsocketed());
 
     puts("ALL TESTS SUCCESSFUL");
 
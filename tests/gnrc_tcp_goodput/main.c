@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Goodput measurement of a GNRC TCP bulk transfer
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/af.h"
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/tcp.h"
+#include "xtimer.h"
+
+/* Size of a single send call */
+#ifndef CHUNK
+#define CHUNK   (4096)
+#endif
+
+/* Interval to check whether all data was acknowledged */
+#ifndef POLL_INTERVAL
+#define POLL_INTERVAL   (1000U)
+#endif
+
+static uint8_t buf[CHUNK];
+
+#if ZERO_COPY
+/* Bytes of buf released by segments that referenced instead of copied them */
+static volatile uint32_t released;
+
+static void _released(void *arg, const void *data, size_t size)
+{
+    (void) arg;
+    (void) data;
+    released += size;
+}
+#endif
+
+int main(void)
+{
+    gnrc_tcp_tcb_t tcb;
+    ipv6_addr_t target_addr;
+    uint32_t start, duration;
+    unsigned sends = 0;
+    int ret;
+
+    printf("\nGoodput test: TARGET_ADDR=%s, TARGET_PORT=%d, NBYTE=%d, SND_QUEUE_SIZE=%u, "
+           "ZERO_COPY=%d\n", TARGET_ADDR, TARGET_PORT, NBYTE, GNRC_TCP_SND_QUEUE_SIZE,
+           ZERO_COPY);
+
+    if (ipv6_addr_from_str(&target_addr, TARGET_ADDR) == NULL) {
+        puts("Error: unable to parse target address");
+        return 1;
+    }
+    memset(buf, 0xF0, sizeof(buf));
+
+    /* Give the host time to notice the interface */
+    xtimer_sleep(1);
+
+    gnrc_tcp_tcb_init(&tcb);
+    ret = gnrc_tcp_open_active(&tcb, AF_INET6, (uint8_t *)&target_addr, TARGET_PORT, 0);
+    if (ret < 0) {
+        printf("Error: gnrc_tcp_open_active() : %d\n", ret);
+        return 1;
+    }
+
+    start = xtimer_now_usec();
+    for (size_t sent = 0; sent < NBYTE; sent += ret) {
+        size_t len = ((NBYTE - sent) < CHUNK) ? (NBYTE - sent) : CHUNK;
+
+        /* buf is never changed, so segments may still reference it on the next call */
+#if ZERO_COPY
+        ret = gnrc_tcp_send_ext(&tcb, buf, len, 0, _released, NULL);
+#else
+        ret = gnrc_tcp_send(&tcb, buf, len, 0);
+#endif
+        if (ret < 0) {
+            printf("Error: gnrc_tcp_send() : %d\n", ret);
+            gnrc_tcp_abort(&tcb);
+            return 1;
+        }
+        sends++;
+    }
+    /* Stop the clock once all data was acknowledged. gnrc_tcp_close() waits
+     * in TIME_WAIT for another 2 * GNRC_TCP_MSL */
+    while (tcb.snd_una != tcb.snd_nxt) {
+        xtimer_usleep(POLL_INTERVAL);
+    }
+    duration = xtimer_now_usec() - start;
+    gnrc_tcp_close(&tcb);
+
+    printf("Goodput: %d bytes in %" PRIu32 " us (%" PRIu32 " bytes/s)\n", NBYTE, duration,
+           (uint32_t)(((uint64_t)NBYTE * US_PER_SEC) / duration));
+#if ZERO_COPY
+    printf("Not copied: %" PRIu32 " bytes in %u sends (%" PRIu32 " bytes per send)\n",
+           released, sends, released / sends);
+#else
+    printf("Copied: %d bytes in %u sends (%d bytes per send)\n", NBYTE, sends,
+           NBYTE / (int)sends);
+#endif
+    return 0;
+}
@@ -39,6 +39,12 @@
 uint8_t bufs[CONNS][NBYTE];
 uint8_t stacks[CONNS][THREAD_STACKSIZE_DEFAULT + THREAD_EXTRA_STACKSIZE_PRINTF];
 
+#ifdef LISTEN_QUEUE
+/* Listening queue and its transmission control blocks */
+gnrc_tcp_tcb_queue_t queue;
+gnrc_tcp_tcb_t tcbs[CONNS];
+#endif
+
 /* "ifconfig" shell command */
 extern int _netif_config(int argc, char **argv);
 
@@ -64,6 +70,15 @@ int main(void)
     printf("\nStarting server: LOCAL_ADDR=%s, LOCAL_PORT=%d, ", LOCAL_ADDR, LOCAL_PORT);
     printf("CONNS=%d, NBYTE=%d, CYCLES=%d\n\n",  CONNS, NBYTE, CYCLES);
 
+#ifdef LISTEN_QUEUE
+    /* Wait for connections on the local port */
+    int ret = gnrc_tcp_listen(&queue, tcbs, CONNS, AF_INET6, NULL, LOCAL_PORT);
+    if (ret < 0) {
+        printf("gnrc_tcp_listen() : %d\n", ret);
+        return -1;
+    }
+#endif
+
     /* Start Threads to handle connections */
     for (int i = 0; i < CONNS; i += 1) {
         thread_create((char *) stacks[i], sizeof(stacks[i]), THREAD_PRIORITY_MAIN, 0, srv_thread,
@@ -79,17 +94,44 @@ void *srv_thread(void *arg)
     uint32_t cycles_ok = 0;
     uint32_t failed_payload_verifications = 0;
 
+#ifdef LISTEN_QUEUE
+    /* Transmission control block of the current connection */
+    gnrc_tcp_tcb_t *tcb;
+#else
     /* Transmission control block */
-    gnrc_tcp_tcb_t tcb;
+    gnrc_tcp_tcb_t tcb_mem;
+    gnrc_tcp_tcb_t *tcb = &tcb_mem;
+#endif
 
     /* Connection handling code */
     printf("Server running: TID=%d\n", tid);
     while (cycles < CYCLES) {
+#ifdef LISTEN_QUEUE
+        /* Wait for a connection */
+        int ret = gnrc_tcp_accept(&queue, &tcb, GNRC_TCP_CONNECTION_TIMEOUT_DURATION);
+        switch (ret) {
+            case 0:
+                DEBUG("TID=%d : gnrc_tcp_accept() : 0 : ok\n", tid);
+                break;
+
+            case -ETIMEDOUT:
+                printf("TID=%d : gnrc_tcp_accept() : -ETIMEDOUT : retry\n", tid);
+                continue;
+
+            case -EINVAL:
+                printf("TID=%d : gnrc_tcp_accept() : -EINVAL\n", tid);
+                return 0;
+
+            default:
+                printf("TID=%d : gnrc_tcp_accept() : %d\n", tid, ret);
+                return 0;
+        }
+#else
         /* Initialize TCB struct */
-        gnrc_tcp_tcb_init(&tcb);
+        gnrc_tcp_tcb_init(tcb);
 
         /* Connect to peer */
-        int ret = gnrc_tcp_open_passive(&tcb, AF_INET6, NULL, LOCAL_PORT);
+        int ret = gnrc_tcp_open_passive(tcb, AF_INET6, NULL, LOCAL_PORT);
         switch (ret) {
             case 0:
                 DEBUG("TID=%d : gnrc_tcp_open_passive() : 0 : ok\n", tid);
@@ -115,10 +157,11 @@ void *srv_thread(void *arg)
                 printf("TID=%d : gnrc_tcp_open_passive() : %d\n", tid, ret);
                 return 0;
         }
+#endif
 
         /* Receive data, stop if errors were found */
         for (size_t rcvd = 0; rcvd < sizeof(bufs[tid]) && ret >= 0; rcvd += ret) {
-            ret = gnrc_tcp_recv(&tcb, (void *) (bufs[tid] + rcvd), sizeof(bufs[tid]) - rcvd,
+            ret = gnrc_tcp_recv(tcb, (void *) (bufs[tid] + rcvd), sizeof(bufs[tid]) - rcvd,
                                 GNRC_TCP_CONNECTION_TIMEOUT_DURATION);
             switch (ret) {
                 case -ENOTCONN:
@@ -170,7 +213,7 @@ void *srv_thread(void *arg)
 
         /* Send data, stop if errors were found */
         for (size_t sent = 0; sent < sizeof(bufs[tid]) && ret >= 0; sent += ret) {
-            ret = gnrc_tcp_send(&tcb, bufs[tid] + sent, sizeof(bufs[tid]) - sent, 0);
+            ret = gnrc_tcp_send(tcb, bufs[tid] + sent, sizeof(bufs[tid]) - sent, 0);
             switch (ret) {
                 case -ENOTCONN:
                     printf("TID=%d : gnrc_tcp_send() : -ENOTCONN\n", tid);
@@ -200,7 +243,7 @@ void *srv_thread(void *arg)
         }
 
         /* Close connection */
-        gnrc_tcp_close(&tcb);
+        gnrc_tcp_close(tcb);
 
         /* Gather data */
         cycles += 1;
@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Timings of native's virtual time mode with a tap interface
+ *
+ * The sleeps add up to more than two hours and include one longer than a
+ * low-level timer period. In virtual time, every sleep must take as long as
+ * requested, no matter if the tap interface receives packets meanwhile, and
+ * the whole test must finish within seconds.
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "xtimer.h"
+
+#define ACCEPTED_ERROR  (1000U) /**< accepted timing error in us */
+
+/* durations to sleep in ms */
+static const uint32_t sleeps[] = {
+    10U,
+    1U * MS_PER_SEC,
+    60U * MS_PER_SEC,
+    10U * 60U * MS_PER_SEC,
+    /* more than one period of the 32 bit low-level timer */
+    2U * 60U * 60U * MS_PER_SEC,
+};
+
+int main(void)
+{
+    bool success = true;
+
+    puts("native virtual time test");
+
+    for (unsigned i = 0; i < (sizeof(sleeps) / sizeof(sleeps[0])); i++) {
+        uint64_t duration = (uint64_t)sleeps[i] * US_PER_MS;
+        uint64_t start = xtimer_now_usec64();
+
+        if (sleeps[i] < MS_PER_SEC) {
+            xtimer_usleep(duration);
+        }
+        else {
+            xtimer_sleep(sleeps[i] / MS_PER_SEC);
+        }
+
+        uint64_t slept = xtimer_now_usec64() - start;
+        bool ok = (slept >= duration) && (slept <= (duration + ACCEPTED_ERROR));
+
+        printf("%c sleep %" PRIu32 " ms took %" PRIu32 ".%03" PRIu32 " ms\n",
+               ok ? '+' : '-', sleeps[i], (uint32_t)(slept / US_PER_MS),
+               (uint32_t)(slept % US_PER_MS));
+        success &= ok;
+    }
+
+    puts(success ? "SUCCESS" : "FAILURE");
+    return 0;
+}
@@ -0,0 +1,30 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2017 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+import time
+
+sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+import testrunner
+
+# the sleeps add up to more than two hours of virtual time
+MAX_REAL_TIME = 30
+
+
+def testfunc(child):
+    child.expect_exact("native virtual time test")
+    start = time.time()
+    for _ in range(5):
+        child.expect(r"\+ sleep (\d+) ms took (\d+)\.\d+ ms")
+        assert(child.match.group(1) == child.match.group(2))
+    child.expect_exact("SUCCESS")
+    assert((time.time() - start) < MAX_REAL_TIME)
+
+if __name__ == "__main__":
+    sys.exit(testrunner.run(testfunc, timeout=MAX_REAL_TIME))
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compares the throughput of byte-wise, bulk and region access
+ *              to tsrb and ringbuffer
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "ringbuffer.h"
+#include "tsrb.h"
+#include "xtimer.h"
+
+#define TIMEOUT_S       (2ul)
+#define TIMEOUT         (TIMEOUT_S * US_PER_SEC)
+#define BUF_SIZE        (256U)
+#define CHUNK_SIZE      (64U)
+
+static char buf[BUF_SIZE];
+static char chunk[CHUNK_SIZE];
+static tsrb_t tsrb;
+static ringbuffer_t rb;
+
+static void callback(void *done_)
+{
+    volatile int *done = done_;
+    *done = 1;
+}
+
+static unsigned _tsrb_bytewise(void)
+{
+    for (unsigned i = 0; i < CHUNK_SIZE; i++) {
+        tsrb_add_one(&tsrb, chunk[i]);
+    }
+    for (unsigned i = 0; i < CHUNK_SIZE; i++) {
+        chunk[i] = tsrb_get_one(&tsrb);
+    }
+    return CHUNK_SIZE;
+}
+
+static unsigned _tsrb_bulk(void)
+{
+    tsrb_add(&tsrb, chunk, CHUNK_SIZE);
+    tsrb_get(&tsrb, chunk, CHUNK_SIZE);
+    return CHUNK_SIZE;
+}
+
+/* the region variants move CHUNK_SIZE bytes per round as well: the buffer is
+ * a multiple of it, so a region never ends before CHUNK_SIZE bytes */
+static unsigned _tsrb_region(void)
+{
+    char *region;
+    size_t len = tsrb_reserve(&tsrb, &region);
+
+    /* produce and consume in place, as e.g. a DMA transfer would */
+    assert(len >= CHUNK_SIZE);
+    memset(region, 0x55, CHUNK_SIZE);
+    tsrb_commit(&tsrb, CHUNK_SIZE);
+    len = tsrb_peek_region(&tsrb, &region);
+    assert(len >= CHUNK_SIZE);
+    (void)len;
+    tsrb_release(&tsrb, CHUNK_SIZE);
+    return CHUNK_SIZE;
+}
+
+static unsigned _rb_bytewise(void)
+{
+    for (unsigned i = 0; i < CHUNK_SIZE; i++) {
+        ringbuffer_add_one(&rb, chunk[i]);
+    }
+    for (unsigned i = 0; i < CHUNK_SIZE; i++) {
+        chunk[i] = ringbuffer_get_one(&rb);
+    }
+    return CHUNK_SIZE;
+}
+
+static unsigned _rb_bulk(void)
+{
+    ringbuffer_add(&rb, chunk, CHUNK_SIZE);
+    ringbuffer_get(&rb, chunk, CHUNK_SIZE);
+    return CHUNK_SIZE;
+}
+
+static unsigned _rb_region(void)
+{
+    char *region;
+    unsigned len = ringbuffer_reserve(&rb, &region);
+
+    assert(len >= CHUNK_SIZE);
+    memset(region, 0x55, CHUNK_SIZE);
+    ringbuffer_commit(&rb, CHUNK_SIZE);
+    len = ringbuffer_peek_region(&rb, &region);
+    assert(len >= CHUNK_SIZE);
+    (void)len;
+    ringbuffer_remove(&rb, CHUNK_SIZE);
+    return CHUNK_SIZE;
+}
+
+static void run_test(const char *name, unsigned (*test)(void))
+{
+    volatile int done = 0;
+    unsigned long bytes = 0;
+
+    tsrb_init(&tsrb, buf, sizeof(buf));
+    ringbuffer_init(&rb, buf, sizeof(buf));
+
+    xtimer_t xtimer;
+    xtimer.callback = callback;
+    xtimer.arg = (void *) &done;
+
+    xtimer_set(&xtimer, TIMEOUT);
+
+    do {
+        bytes += test();
+    } while (done == 0);
+
+    printf("+ %s: %lu bytes per second\n", name, bytes / TIMEOUT_S);
+}
+
+#define run_test(test) run_test(#test, test)
+
+int main(void)
+{
+    puts("Start.");
+
+    run_test(_tsrb_bytewise);
+    run_test(_tsrb_bulk);
+    run_test(_tsrb_region);
+    run_test(_rb_bytewise);
+    run_test(_rb_bulk);
+    run_test(_rb_region);
+
+    puts("Done.");
+    return 0;
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compares the message throughput of single and batched
+ *              message passing
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "msg.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define TIMEOUT_S       (2ul)
+#define TIMEOUT         (TIMEOUT_S * US_PER_SEC)
+#define BURST_SIZE      (16U)
+#define QUEUE_SIZE      (BURST_SIZE)
+
+static char _stack[THREAD_STACKSIZE_MAIN];
+static msg_t _queue[QUEUE_SIZE];
+static msg_t _burst[BURST_SIZE];
+static kernel_pid_t _receiver_pid;
+static volatile int _batched;
+
+static void callback(void *done_)
+{
+    volatile int *done = done_;
+    *done = 1;
+}
+
+static void *_receiver(void *arg)
+{
+    msg_t msgs[BURST_SIZE];
+
+    (void)arg;
+    msg_init_queue(_queue, QUEUE_SIZE);
+    while (1) {
+        if (_batched) {
+            msg_receive_many(msgs, BURST_SIZE);
+        }
+        else {
+            msg_receive(msgs);
+        }
+    }
+    return NULL;
+}
+
+static int _single(void)
+{
+    for (unsigned i = 0; i < BURST_SIZE; i++) {
+        msg_t m = { .content = { .value = i } };
+        msg_send(&m, _receiver_pid);
+    }
+    return BURST_SIZE;
+}
+
+static int _batch(void)
+{
+    for (unsigned i = 0; i < BURST_SIZE; i++) {
+        _burst[i].content.value = i;
+    }
+    return msg_send_many(_burst, BURST_SIZE, _receiver_pid);
+}
+
+static void run_test(const char *name, int (*test)(void), int batched)
+{
+    volatile int done = 0;
+    unsigned long msgs = 0;
+
+    _batched = batched;
+
+    xtimer_t xtimer;
+    xtimer.callback = callback;
+    xtimer.arg = (void *) &done;
+
+    xtimer_set(&xtimer, TIMEOUT);
+
+    do {
+        int res = test();
+
+        if (res < 0) {
+            xtimer_remove(&xtimer);
+            printf("- %s: FAILED, could not send messages\n", name);
+            return;
+        }
+        msgs += res;
+    } while (done == 0);
+
+    printf("+ %s: %lu messages per second\n", name, msgs / TIMEOUT_S);
+}
+
+#define run_test(test, batched) run_test(#test, test, batched)
+
+int main(void)
+{
+    puts("Start.");
+
+    /* the receiver preempts the sender, so every wakeup costs a context
+     * switch */
+    _receiver_pid = thread_create(_stack, sizeof(_stack),
+                                  THREAD_PRIORITY_MAIN - 1,
+                                  THREAD_CREATE_STACKTEST,
+                                  _receiver, NULL, "receiver");
+
+    run_test(_single, 0);
+    run_test(_batch, 1);
+
+    puts("Done.");
+    return 0;
+}
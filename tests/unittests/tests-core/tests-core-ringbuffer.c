@@ -16,6 +16,8 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <string.h>
+
 #include "thread.h"
 #include "ringbuffer.h"
 #include "mutex.h"
@@ -131,11 +133,64 @@ static void tests_core_ringbuffer_remove(void)
 
 }
 
+static void tests_core_ringbuffer_regions(void)
+{
+    char mem[5];
+    char *region;
+    ringbuffer_t buf;
+    ringbuffer_init(&buf, mem, sizeof(mem));
+
+    TEST_ASSERT_EQUAL_INT(0, ringbuffer_peek_region(&buf, &region));
+    TEST_ASSERT_EQUAL_INT(5, ringbuffer_reserve(&buf, &region));
+    TEST_ASSERT(region == mem);
+    region[0] = 'a';
+    region[1] = 'b';
+    region[2] = 'c';
+    ringbuffer_commit(&buf, 3);
+
+    TEST_ASSERT_EQUAL_INT(3, ringbuffer_peek_region(&buf, &region));
+    TEST_ASSERT_EQUAL_INT('a', *region);
+    TEST_ASSERT_EQUAL_INT(2, ringbuffer_remove(&buf, 2));
+
+    /* free space wraps around: first up to the end of the buffer ... */
+    TEST_ASSERT_EQUAL_INT(2, ringbuffer_reserve(&buf, &region));
+    TEST_ASSERT(region == &mem[3]);
+    ringbuffer_commit(&buf, 2);
+    /* ... then from its start up to the head */
+    TEST_ASSERT_EQUAL_INT(2, ringbuffer_reserve(&buf, &region));
+    TEST_ASSERT(region == mem);
+    ringbuffer_commit(&buf, 2);
+    TEST_ASSERT(ringbuffer_full(&buf));
+    TEST_ASSERT_EQUAL_INT(0, ringbuffer_reserve(&buf, &region));
+
+    TEST_ASSERT_EQUAL_INT(3, ringbuffer_peek_region(&buf, &region));
+    TEST_ASSERT(region == &mem[2]);
+    TEST_ASSERT_EQUAL_INT(3, ringbuffer_remove(&buf, 3));
+    TEST_ASSERT_EQUAL_INT(2, ringbuffer_peek_region(&buf, &region));
+    TEST_ASSERT(region == mem);
+}
+
+static void tests_core_ringbuffer_add_get_wrap(void)
+{
+    char mem[7];
+    char out[7];
+    ringbuffer_t buf;
+    ringbuffer_init(&buf, mem, sizeof(mem));
+
+    TEST_ASSERT_EQUAL_INT(5, ringbuffer_add(&buf, "01234", 5));
+    TEST_ASSERT_EQUAL_INT(4, ringbuffer_get(&buf, out, 4));
+    TEST_ASSERT_EQUAL_INT(6, ringbuffer_add(&buf, "5678901", 7));
+    TEST_ASSERT_EQUAL_INT(7, ringbuffer_get(&buf, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(out, "4567890", sizeof(out)));
+}
+
 Test *tests_core_ringbuffer_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(tests_core_ringbuffer),
         new_TestFixture(tests_core_ringbuffer_remove),
+        new_TestFixture(tests_core_ringbuffer_regions),
+        new_TestFixture(tests_core_ringbuffer_add_get_wrap),
     };
 
     EMB_UNIT_TESTCALLER(ringbuffer_tests, NULL, NULL, fixtures);
@@ -978,6 +978,49 @@ static void test_fib_20_replace_prefix(void)
     fib_deinit(&test_fib_table);
 }
 
+/*
+* @brief add more addresses than the static universal address table holds
+* It is expected that addresses are interned across the added chunk and the
+* chunk is used once the static table is exhausted
+*/
+static void test_fib_21_universal_address_extend(void)
+{
+    static universal_address_container_t chunk[8];
+    universal_address_container_t *containers[48];
+    char addr[16];
+
+    for (int i = 0; i < 40; ++i) {
+        snprintf(addr, sizeof(addr), "Test address %02d", i);
+        containers[i] = universal_address_add((uint8_t *)addr, sizeof(addr) - 1);
+        TEST_ASSERT_NOT_NULL(containers[i]);
+    }
+    snprintf(addr, sizeof(addr), "Test address %02d", 40);
+    TEST_ASSERT_NULL(universal_address_add((uint8_t *)addr, sizeof(addr) - 1));
+
+    TEST_ASSERT_EQUAL_INT(0, universal_address_extend(chunk, 8));
+    for (int i = 40; i < 48; ++i) {
+        snprintf(addr, sizeof(addr), "Test address %02d", i);
+        containers[i] = universal_address_add((uint8_t *)addr, sizeof(addr) - 1);
+        TEST_ASSERT(containers[i] == &chunk[i - 40]);
+    }
+    TEST_ASSERT_EQUAL_INT(48, universal_address_get_num_used_entries());
+
+    /* adding a stored address again returns its container */
+    for (int i = 0; i < 48; i += 7) {
+        snprintf(addr, sizeof(addr), "Test address %02d", i);
+        TEST_ASSERT(containers[i] == universal_address_add((uint8_t *)addr,
+                                                           sizeof(addr) - 1));
+        universal_address_rem(containers[i]);
+    }
+
+    for (int i = 0; i < 48; ++i) {
+        universal_address_rem(containers[i]);
+    }
+    TEST_ASSERT_EQUAL_INT(0, universal_address_get_num_used_entries());
+
+    fib_deinit(&test_fib_table);
+}
+
 Test *tests_fib_tests(void)
 {
     fib_init(&test_fib_table);
@@ -1002,6 +1045,7 @@ Test *tests_fib_tests(void)
                         new_TestFixture(test_fib_18_get_next_hop_invalid_parameters),
                         new_TestFixture(test_fib_19_default_gateway),
                         new_TestFixture(test_fib_20_replace_prefix),
+                        new_TestFixture(test_fib_21_universal_address_extend),
     };
 
     EMB_UNIT_TESTCALLER(fib_tests, NULL, NULL, fixtures);
@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "net/ipv6/addr.h"
+#include "net/gnrc/ipv6/flowc.h"
+#include "net/gnrc/ipv6/nc.h"
+#include "net/gnrc/ipv6/netif.h"
+
+#include "unittests-constants.h"
+#include "tests-gnrc_ipv6_flowc.h"
+
+#define TEST_NETIF          (TEST_UINT16)
+#define TEST_DST            { { \
+            0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00, \
+            0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f \
+        } \
+    }
+#define TEST_SRC            { { \
+            0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00, \
+            0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f \
+        } \
+    }
+#define TEST_L2ADDR         { 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09 }
+
+static const uint8_t _l2addr[] = TEST_L2ADDR;
+
+static void set_up(void)
+{
+    gnrc_ipv6_nc_init();
+    gnrc_ipv6_netif_add(TEST_NETIF);
+    gnrc_ipv6_flowc_invalidate();
+}
+
+static void tear_down(void)
+{
+    gnrc_ipv6_nc_init();
+    gnrc_ipv6_netif_init();
+}
+
+static void test_flowc_get__empty(void)
+{
+    ipv6_addr_t dst = TEST_DST;
+    uint8_t l2addr[GNRC_IPV6_NC_L2_ADDR_MAX];
+    uint8_t l2addr_len;
+    uint32_t misses = gnrc_ipv6_flowc_get_stats()->misses;
+
+    TEST_ASSERT_EQUAL_INT(KERNEL_PID_UNDEF,
+                          gnrc_ipv6_flowc_get(KERNEL_PID_UNDEF, &dst, l2addr,
+                                              &l2addr_len, NULL));
+    TEST_ASSERT_EQUAL_INT(misses + 1, gnrc_ipv6_flowc_get_stats()->misses);
+}
+
+static void test_flowc_get__success(void)
+{
+    ipv6_addr_t dst = TEST_DST, src = TEST_SRC, res_src = IPV6_ADDR_UNSPECIFIED;
+    uint8_t l2addr[GNRC_IPV6_NC_L2_ADDR_MAX];
+    uint8_t l2addr_len = 0;
+    uint32_t hits = gnrc_ipv6_flowc_get_stats()->hits;
+
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_netif_add_addr(TEST_NETIF, &src, 64, 0));
+    gnrc_ipv6_flowc_add(gnrc_ipv6_flowc_gen(), KERNEL_PID_UNDEF, &dst,
+                        TEST_NETIF, _l2addr, sizeof(_l2addr));
+    TEST_ASSERT_EQUAL_INT(TEST_NETIF,
+                          gnrc_ipv6_flowc_get(KERNEL_PID_UNDEF, &dst, l2addr,
+                                              &l2addr_len, &res_src));
+    TEST_ASSERT_EQUAL_INT(hits + 1, gnrc_ipv6_flowc_get_stats()->hits);
+    TEST_ASSERT_EQUAL_INT(sizeof(_l2addr), l2addr_len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_l2addr, l2addr, sizeof(_l2addr)));
+    TEST_ASSERT(ipv6_addr_equal(&src, &res_src));
+}
+
+static void test_flowc_get__other_iface(void)
+{
+    ipv6_addr_t dst = TEST_DST;
+    uint8_t l2addr[GNRC_IPV6_NC_L2_ADDR_MAX];
+    uint8_t l2addr_len;
+
+    gnrc_ipv6_flowc_add(gnrc_ipv6_flowc_gen(), KERNEL_PID_UNDEF, &dst,
+                        TEST_NETIF, _l2addr, sizeof(_l2addr));
+    TEST_ASSERT_EQUAL_INT(KERNEL_PID_UNDEF,
+                          gnrc_ipv6_flowc_get(TEST_NETIF, &dst, l2addr,
+                                              &l2addr_len, NULL));
+}
+
+static void test_flowc_invalidate__nc_change(void)
+{
+    ipv6_addr_t dst = TEST_DST;
+    uint8_t l2addr[GNRC_IPV6_NC_L2_ADDR_MAX];
+    uint8_t l2addr_len;
+    uint32_t invalidations = gnrc_ipv6_flowc_get_stats()->invalidations;
+
+    gnrc_ipv6_flowc_add(gnrc_ipv6_flowc_gen(), KERNEL_PID_UNDEF, &dst,
+                        TEST_NETIF, _l2addr, sizeof(_l2addr));
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_add(TEST_NETIF, &dst, _l2addr,
+                                          sizeof(_l2addr), 0));
+    TEST_ASSERT(invalidations < gnrc_ipv6_flowc_get_stats()->invalidations);
+    TEST_ASSERT_EQUAL_INT(KERNEL_PID_UNDEF,
+                          gnrc_ipv6_flowc_get(KERNEL_PID_UNDEF, &dst, l2addr,
+                                              &l2addr_len, NULL));
+}
+
+static void test_flowc_invalidate__netif_change(void)
+{
+    ipv6_addr_t dst = TEST_DST, src = TEST_SRC;
+    uint8_t l2addr[GNRC_IPV6_NC_L2_ADDR_MAX];
+    uint8_t l2addr_len;
+
+    gnrc_ipv6_flowc_add(gnrc_ipv6_flowc_gen(), KERNEL_PID_UNDEF, &dst,
+                        TEST_NETIF, _l2addr, sizeof(_l2addr));
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_netif_add_addr(TEST_NETIF, &src, 64, 0));
+    TEST_ASSERT_EQUAL_INT(KERNEL_PID_UNDEF,
+                          gnrc_ipv6_flowc_get(KERNEL_PID_UNDEF, &dst, l2addr,
+                                              &l2addr_len, NULL));
+}
+
+static void test_flowc_add__invalidated(void)
+{
+    ipv6_addr_t dst = TEST_DST;
+    uint8_t l2addr[GNRC_IPV6_NC_L2_ADDR_MAX];
+    uint8_t l2addr_len;
+    unsigned gen = gnrc_ipv6_flowc_gen();
+
+    /* the cache is invalidated while the next hop is determined */
+    gnrc_ipv6_flowc_invalidate();
+    gnrc_ipv6_flowc_add(gen, KERNEL_PID_UNDEF, &dst, TEST_NETIF, _l2addr,
+                        sizeof(_l2addr));
+    TEST_ASSERT_EQUAL_INT(KERNEL_PID_UNDEF,
+                          gnrc_ipv6_flowc_get(KERNEL_PID_UNDEF, &dst, l2addr,
+                                              &l2addr_len, NULL));
+}
+
+Test *tests_gnrc_ipv6_flowc_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_flowc_get__empty),
+        new_TestFixture(test_flowc_get__success),
+        new_TestFixture(test_flowc_get__other_iface),
+        new_TestFixture(test_flowc_invalidate__nc_change),
+        new_TestFixture(test_flowc_invalidate__netif_change),
+        new_TestFixture(test_flowc_add__invalidated),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_ipv6_flowc_tests, set_up, tear_down, fixtures);
+
+    return (Test *)&gnrc_ipv6_flowc_tests;
+}
+
+void tests_gnrc_ipv6_flowc(void)
+{
+    TESTS_RUN(tests_gnrc_ipv6_flowc_tests());
+}
+/** @} */
@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "msg.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan/frag.h"
+#include "net/gnrc/sixlowpan/netif.h"
+#include "net/sixlowpan.h"
+#include "thread.h"
+
+#include "unittests-constants.h"
+#include "tests-gnrc_sixlowpan_frag.h"
+
+#define TEST_MAX_FRAG_SIZE  (64U)
+/* payload of every fragment but the last, for TEST_MAX_FRAG_SIZE */
+#define TEST_FRAG_PAYLOAD   (56U)
+/* more fragments than are handed to the interface at once */
+#define TEST_FRAG_NUMOF     (GNRC_SIXLOWPAN_FRAG_BATCH_SIZE + 4U)
+#define TEST_DATAGRAM_SIZE  (((TEST_FRAG_NUMOF - 1) * TEST_FRAG_PAYLOAD) + 20U)
+#define TEST_HDR_SIZE       (40U)
+#define TEST_QUEUE_SIZE     (32U)
+#define TEST_L2ADDR         { 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09 }
+
+static uint8_t _l2addr[] = TEST_L2ADDR;
+static uint8_t _datagram[TEST_DATAGRAM_SIZE];
+static msg_t _queue[TEST_QUEUE_SIZE];
+
+static void set_up(void)
+{
+    gnrc_pktbuf_init();
+    /* the test thread is the interface the fragments are sent to */
+    gnrc_sixlowpan_netif_add(thread_getpid(), TEST_MAX_FRAG_SIZE);
+    for (unsigned i = 0; i < sizeof(_datagram); i++) {
+        _datagram[i] = (uint8_t)i;
+    }
+}
+
+static void tear_down(void)
+{
+    gnrc_sixlowpan_netif_remove(thread_getpid());
+}
+
+/* builds a datagram in two snips, so a fragment spans both */
+static gnrc_pktsnip_t *_build_datagram(void)
+{
+    gnrc_pktsnip_t *netif, *hdr, *payload;
+
+    payload = gnrc_pktbuf_add(NULL, _datagram + TEST_HDR_SIZE,
+                              sizeof(_datagram) - TEST_HDR_SIZE,
+                              GNRC_NETTYPE_UNDEF);
+    hdr = gnrc_pktbuf_add(payload, _datagram, TEST_HDR_SIZE,
+                          GNRC_NETTYPE_SIXLOWPAN);
+    netif = gnrc_netif_hdr_build(_l2addr, sizeof(_l2addr),
+                                 _l2addr, sizeof(_l2addr));
+    if ((payload == NULL) || (hdr == NULL) || (netif == NULL)) {
+        return NULL;
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = thread_getpid();
+    netif->next = hdr;
+    return netif;
+}
+
+/* receives the fragments sent to the test thread and checks them */
+static void _check_fragments(void)
+{
+    msg_t msg;
+    size_t offset = 0;
+    uint16_t tag = 0;
+
+    for (unsigned i = 0; i < TEST_FRAG_NUMOF; i++) {
+        gnrc_pktsnip_t *frag, *payload;
+        sixlowpan_frag_t *hdr;
+        size_t frag_len = TEST_DATAGRAM_SIZE - offset;
+
+        if (frag_len > TEST_FRAG_PAYLOAD) {
+            frag_len = TEST_FRAG_PAYLOAD;
+        }
+        TEST_ASSERT_EQUAL_INT(1, msg_try_receive(&msg));
+        TEST_ASSERT_EQUAL_INT(GNRC_NETAPI_MSG_TYPE_SND, msg.type);
+        frag = msg.content.ptr;
+        TEST_ASSERT_EQUAL_INT(GNRC_NETTYPE_NETIF, frag->type);
+        TEST_ASSERT_NOT_NULL(frag->next);
+        hdr = frag->next->data;
+        TEST_ASSERT_EQUAL_INT(TEST_DATAGRAM_SIZE,
+                              byteorder_ntohs(hdr->disp_size) &
+                              SIXLOWPAN_FRAG_SIZE_MASK);
+        if (i == 0) {
+            TEST_ASSERT_EQUAL_INT(SIXLOWPAN_FRAG_1_DISP,
+                                  hdr->disp_size.u8[0] &
+                                  SIXLOWPAN_FRAG_DISP_MASK);
+            TEST_ASSERT_EQUAL_INT(sizeof(sixlowpan_frag_t), frag->next->size);
+            tag = byteorder_ntohs(hdr->tag);
+        }
+        else {
+            TEST_ASSERT_EQUAL_INT(SIXLOWPAN_FRAG_N_DISP,
+                                  hdr->disp_size.u8[0] &
+                                  SIXLOWPAN_FRAG_DISP_MASK);
+            TEST_ASSERT_EQUAL_INT(sizeof(sixlowpan_frag_n_t), frag->next->size);
+            TEST_ASSERT_EQUAL_INT(offset,
+                                  ((sixlowpan_frag_n_t *)hdr)->offset * 8U);
+        }
+        TEST_ASSERT_EQUAL_INT(tag, byteorder_ntohs(hdr->tag));
+        TEST_ASSERT_EQUAL_INT(frag_len, gnrc_pkt_len(frag->next->next));
+        for (payload = frag->next->next; payload != NULL;
+             payload = payload->next) {
+            TEST_ASSERT_EQUAL_INT(0, memcmp(_datagram + offset, payload->data,
+                                            payload->size));
+            offset += payload->size;
+        }
+        gnrc_pktbuf_release(frag);
+    }
+    TEST_ASSERT_EQUAL_INT(TEST_DATAGRAM_SIZE, offset);
+    TEST_ASSERT_EQUAL_INT(-1, msg_try_receive(&msg));
+}
+
+static void test_frag_send__batches(void)
+{
+    gnrc_sixlowpan_msg_frag_t fragment_msg = {
+        .pid = thread_getpid(),
+        .pkt = _build_datagram(),
+        .datagram_size = TEST_DATAGRAM_SIZE,
+        .offset = 0,
+    };
+
+    TEST_ASSERT_NOT_NULL(fragment_msg.pkt);
+    gnrc_sixlowpan_frag_send(&fragment_msg);
+    TEST_ASSERT_NULL(fragment_msg.pkt);
+    _check_fragments();
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_frag_send__shared(void)
+{
+    gnrc_pktsnip_t *pkt = _build_datagram(), *hdr;
+    gnrc_sixlowpan_msg_frag_t fragment_msg = {
+        .pid = thread_getpid(),
+        .pkt = pkt,
+        .datagram_size = TEST_DATAGRAM_SIZE,
+        .offset = 0,
+    };
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    /* someone else holds the payload, so it must stay untouched */
+    hdr = pkt->next;
+    gnrc_pktbuf_hold(hdr, 1);
+    gnrc_sixlowpan_frag_send(&fragment_msg);
+    TEST_ASSERT_NULL(fragment_msg.pkt);
+    _check_fragments();
+    TEST_ASSERT_EQUAL_INT(TEST_HDR_SIZE, hdr->size);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_datagram, hdr->data, TEST_HDR_SIZE));
+    TEST_ASSERT_EQUAL_INT(TEST_DATAGRAM_SIZE, gnrc_pkt_len(hdr));
+    gnrc_pktbuf_release(hdr);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+Test *tests_gnrc_sixlowpan_frag_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_frag_send__batches),
+        new_TestFixture(test_frag_send__shared),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_sixlowpan_frag_tests, set_up, tear_down, fixtures);
+
+    return (Test *)&gnrc_sixlowpan_frag_tests;
+}
+
+void tests_gnrc_sixlowpan_frag(void)
+{
+    msg_init_queue(_queue, TEST_QUEUE_SIZE);
+    TESTS_RUN(tests_gnrc_sixlowpan_frag_tests());
+}
+/** @} */
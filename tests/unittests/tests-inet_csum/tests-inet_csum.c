@@ -12,15 +12,62 @@
  * @file
  */
 #include <errno.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "embUnit.h"
+#include "xtimer.h"
 
 #include "net/inet_csum.h"
 
 #include "unittests-constants.h"
 #include "tests-inet_csum.h"
 
+#define BENCH_LEN       (1280U)
+#define BENCH_RUNS      (256U)
+
+/* large enough for BENCH_LEN at any of the 8 tested alignments */
+static uint32_t _buf[(BENCH_LEN + 8) / sizeof(uint32_t)];
+
+/* byte-wise reference of inet_csum_slice() */
+static uint16_t _ref_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len,
+                                size_t accum_len)
+{
+    uint32_t csum = sum;
+
+    if (len == 0) {
+        return csum;
+    }
+    if (accum_len & 1) {
+        csum += *buf;
+        buf++;
+        len--;
+        accum_len++;
+    }
+    for (int i = 0; i < (len >> 1); buf += 2, i++) {
+        csum += (uint16_t)(*buf << 8) + *(buf + 1);
+    }
+    if ((accum_len + len) & 1) {
+        csum += (uint16_t)(*buf << 8);
+    }
+    while (csum >> 16) {
+        csum = (csum & 0xffff) + (csum >> 16);
+    }
+    return csum;
+}
+
+static void _fill_buf(void)
+{
+    uint8_t *bytes = (uint8_t *)_buf;
+    uint32_t x = TEST_UINT32;
+
+    for (unsigned i = 0; i < sizeof(_buf); i++) {
+        x = (x * 1103515245) + 12345;   /* deterministic LCG */
+        bytes[i] = x >> 24;
+    }
+}
+
 static void test_inet_csum__rfc_example(void)
 {
     /* source: https://tools.ietf.org/html/rfc1071#section-3 */
@@ -165,6 +212,82 @@ static void test_inet_csum__empty_app_buffer(void)
     TEST_ASSERT_EQUAL_INT(hdr_expected, pyld_sum);
 }
 
+static void test_inet_csum__unaligned_slices(void)
+{
+    const uint8_t *bytes = (uint8_t *)_buf;
+
+    _fill_buf();
+    for (unsigned offset = 0; offset < 8; offset++) {
+        for (uint16_t len = 0; len < 80; len++) {
+            for (size_t accum_len = 0; accum_len < 2; accum_len++) {
+                TEST_ASSERT_EQUAL_INT(_ref_csum_slice(TEST_UINT16, bytes + offset,
+                                                      len, accum_len),
+                                      inet_csum_slice(TEST_UINT16, bytes + offset,
+                                                      len, accum_len));
+            }
+        }
+    }
+    /* full 16-bit length */
+    TEST_ASSERT_EQUAL_INT(_ref_csum_slice(0, bytes + 3, BENCH_LEN, 0),
+                          inet_csum_slice(0, bytes + 3, BENCH_LEN, 0));
+}
+
+static void test_inet_csum__update16(void)
+{
+    /* IPv4 header with TTL 64 */
+    uint8_t data[] = {
+        0x45, 0x00, 0x00, 0x73, 0x00, 0x00, 0x40, 0x00,
+        0x40, 0x11, 0x00, 0x00, 0xc0, 0xa8, 0x00, 0x01,
+        0xc0, 0xa8, 0x00, 0xc7
+    };
+    uint16_t csum = ~inet_csum(0, data, sizeof(data));
+    uint16_t old = (data[8] << 8) | data[9];
+
+    TEST_ASSERT_EQUAL_INT(0xb861, csum);
+    /* decrement TTL */
+    data[8]--;
+    csum = inet_csum_update16(csum, old, (data[8] << 8) | data[9]);
+    TEST_ASSERT_EQUAL_INT((uint16_t)~inet_csum(0, data, sizeof(data)), csum);
+    TEST_ASSERT_EQUAL_INT(0xb961, csum);
+}
+
+static void test_inet_csum__update(void)
+{
+    uint8_t *bytes = (uint8_t *)_buf;
+    uint8_t old[16];
+    uint16_t csum;
+
+    _fill_buf();
+    csum = ~inet_csum(0, bytes, 64);
+    /* rewrite an "address" in the middle */
+    memcpy(old, &bytes[8], sizeof(old));
+    memset(&bytes[8], 0xab, sizeof(old));
+    csum = inet_csum_update(csum, old, &bytes[8], sizeof(old));
+    TEST_ASSERT_EQUAL_INT((uint16_t)~inet_csum(0, bytes, 64), csum);
+}
+
+static void test_inet_csum__throughput(void)
+{
+    const uint8_t *bytes = (uint8_t *)_buf;
+    volatile uint16_t sum = 0;
+    uint32_t start, ref_us, us;
+
+    _fill_buf();
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < BENCH_RUNS; i++) {
+        sum += _ref_csum_slice(0, bytes + (i & 7), BENCH_LEN, 0);
+    }
+    ref_us = xtimer_now_usec() - start;
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < BENCH_RUNS; i++) {
+        sum -= inet_csum_slice(0, bytes + (i & 7), BENCH_LEN, 0);
+    }
+    us = xtimer_now_usec() - start;
+    TEST_ASSERT_EQUAL_INT(0, sum);
+    printf("\ninet_csum: %u byte x %u: byte-wise %lu us, inet_csum_slice %lu us\n",
+           BENCH_LEN, BENCH_RUNS, (unsigned long)ref_us, (unsigned long)us);
+}
+
 Test *tests_inet_csum_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -176,6 +299,10 @@ Test *tests_inet_csum_tests(void)
         new_TestFixture(test_inet_csum__odd_len),
         new_TestFixture(test_inet_csum__two_app_snips),
         new_TestFixture(test_inet_csum__empty_app_buffer),
+        new_TestFixture(test_inet_csum__unaligned_slices),
+        new_TestFixture(test_inet_csum__update16),
+        new_TestFixture(test_inet_csum__update),
+        new_TestFixture(test_inet_csum__throughput),
     };
 
     EMB_UNIT_TESTCALLER(inet_csum_tests, NULL, NULL, fixtures);
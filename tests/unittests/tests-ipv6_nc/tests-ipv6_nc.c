@@ -118,6 +118,46 @@ static void test_ipv6_nc_add__full(void)
                                       sizeof(TEST_STRING4), 0));
 }
 
+static void test_ipv6_nc_add__full_evict_stale(void)
+{
+    ipv6_addr_t addr = DEFAULT_TEST_IPV6_ADDR;
+    ipv6_addr_t first = DEFAULT_TEST_IPV6_ADDR, second = DEFAULT_TEST_IPV6_ADDR;
+    const uint8_t stale = (GNRC_IPV6_NC_STATE_STALE << GNRC_IPV6_NC_STATE_POS);
+
+    for (int i = 0; i < GNRC_IPV6_NC_SIZE; i++) {
+        TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr, TEST_STRING4,
+                                              sizeof(TEST_STRING4), stale));
+        addr.u16[7].u16++;
+    }
+    second.u16[7].u16++;
+    /* use first entry, so the second becomes the least recently used */
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_get(DEFAULT_TEST_NETIF, &first));
+
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr, TEST_STRING4,
+                                          sizeof(TEST_STRING4), stale));
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_get(DEFAULT_TEST_NETIF, &addr));
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_get(DEFAULT_TEST_NETIF, &first));
+    TEST_ASSERT_NULL(gnrc_ipv6_nc_get(DEFAULT_TEST_NETIF, &second));
+    TEST_ASSERT_EQUAL_INT(1, gnrc_ipv6_nc_get_stats()->evictions);
+}
+
+static void test_ipv6_nc_add__full_stale_routers(void)
+{
+    ipv6_addr_t addr = DEFAULT_TEST_IPV6_ADDR;
+    const uint8_t flags = (GNRC_IPV6_NC_STATE_STALE << GNRC_IPV6_NC_STATE_POS) |
+                          GNRC_IPV6_NC_IS_ROUTER;
+
+    for (int i = 0; i < GNRC_IPV6_NC_SIZE; i++) {
+        TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr, TEST_STRING4,
+                                              sizeof(TEST_STRING4), flags));
+        addr.u16[7].u16++;
+    }
+
+    TEST_ASSERT_NULL(gnrc_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr, TEST_STRING4,
+                                      sizeof(TEST_STRING4), flags));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nc_get_stats()->evictions);
+}
+
 static void test_ipv6_nc_add__success(void)
 {
     ipv6_addr_t addr = DEFAULT_TEST_IPV6_ADDR;
@@ -245,6 +285,20 @@ static void test_ipv6_nc_get__success_if_global(void)
     TEST_ASSERT_EQUAL_INT(0, entry->flags);
 }
 
+static void test_ipv6_nc_get__stats(void)
+{
+    ipv6_addr_t addr = DEFAULT_TEST_IPV6_ADDR;
+    ipv6_addr_t other_addr = OTHER_TEST_IPV6_ADDR;
+
+    test_ipv6_nc_add__success(); /* adds DEFAULT_TEST_IPV6_ADDR to DEFAULT_TEST_NETIF */
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_get(DEFAULT_TEST_NETIF, &addr));
+    TEST_ASSERT_NULL(gnrc_ipv6_nc_get(DEFAULT_TEST_NETIF, &other_addr));
+
+    /* includes the lookup of test_ipv6_nc_add__success() */
+    TEST_ASSERT_EQUAL_INT(2, gnrc_ipv6_nc_get_stats()->hits);
+    TEST_ASSERT_EQUAL_INT(1, gnrc_ipv6_nc_get_stats()->misses);
+}
+
 static void test_ipv6_nc_get_next__empty(void)
 {
     TEST_ASSERT_NULL(gnrc_ipv6_nc_get_next(NULL));
@@ -449,6 +503,8 @@ Test *tests_ipv6_nc_tests(void)
         new_TestFixture(test_ipv6_nc_add__addr_unspecified),
         new_TestFixture(test_ipv6_nc_add__l2addr_too_long),
         new_TestFixture(test_ipv6_nc_add__full),
+        new_TestFixture(test_ipv6_nc_add__full_evict_stale),
+        new_TestFixture(test_ipv6_nc_add__full_stale_routers),
         new_TestFixture(test_ipv6_nc_add__success),
         new_TestFixture(test_ipv6_nc_add__address_update_despite_free_entry),
         new_TestFixture(test_ipv6_nc_remove__no_entry_pid),
@@ -460,6 +516,7 @@ Test *tests_ipv6_nc_tests(void)
         new_TestFixture(test_ipv6_nc_get__different_addr),
         new_TestFixture(test_ipv6_nc_get__success_if_local),
         new_TestFixture(test_ipv6_nc_get__success_if_global),
+        new_TestFixture(test_ipv6_nc_get__stats),
         new_TestFixture(test_ipv6_nc_get_next__empty),
         new_TestFixture(test_ipv6_nc_get_next__1_entry),
         new_TestFixture(test_ipv6_nc_get_next__2_entries),
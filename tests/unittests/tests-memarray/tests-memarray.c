@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "memarray.h"
+
+#include "tests-memarray.h"
+
+#define BLOCK_SIZE      (sizeof(void *) + 3)    /* deliberately unaligned */
+#define BLOCK_NUMOF     (4U)
+
+static uint8_t _data[BLOCK_NUMOF][BLOCK_SIZE];
+static memarray_t _mem;
+
+static void set_up(void)
+{
+    memarray_init(&_mem, _data, BLOCK_SIZE, BLOCK_NUMOF);
+}
+
+static void test_memarray_static_init(void)
+{
+    memarray_t mem = MEMARRAY_INIT(_data, BLOCK_SIZE, BLOCK_NUMOF);
+
+    TEST_ASSERT(_data[0] == memarray_alloc(&mem));
+    TEST_ASSERT(_data[1] == memarray_alloc(&mem));
+    TEST_ASSERT_EQUAL_INT(2, mem.used);
+}
+
+static void test_memarray_alloc_all(void)
+{
+    for (unsigned i = 0; i < BLOCK_NUMOF; i++) {
+        TEST_ASSERT_EQUAL_INT(BLOCK_NUMOF - i, memarray_available(&_mem));
+        TEST_ASSERT(_data[i] == memarray_alloc(&_mem));
+    }
+    TEST_ASSERT_EQUAL_INT(0, memarray_available(&_mem));
+    TEST_ASSERT_NULL(memarray_alloc(&_mem));
+    TEST_ASSERT_NULL(memarray_alloc(&_mem));
+    TEST_ASSERT_EQUAL_INT(BLOCK_NUMOF, _mem.used);
+    TEST_ASSERT_EQUAL_INT(BLOCK_NUMOF, _mem.high_water);
+    TEST_ASSERT_EQUAL_INT(2, _mem.failed);
+}
+
+static void test_memarray_free_realloc(void)
+{
+    void *blocks[BLOCK_NUMOF];
+
+    for (unsigned i = 0; i < BLOCK_NUMOF; i++) {
+        blocks[i] = memarray_alloc(&_mem);
+        memset(blocks[i], 0xff, BLOCK_SIZE);
+    }
+    memarray_free(&_mem, blocks[1]);
+    memarray_free(&_mem, blocks[3]);
+    TEST_ASSERT_EQUAL_INT(2, _mem.used);
+    TEST_ASSERT_EQUAL_INT(BLOCK_NUMOF, _mem.high_water);
+    /* free list is LIFO */
+    TEST_ASSERT(blocks[3] == memarray_alloc(&_mem));
+    TEST_ASSERT(blocks[1] == memarray_alloc(&_mem));
+    TEST_ASSERT_NULL(memarray_alloc(&_mem));
+    TEST_ASSERT_EQUAL_INT(1, _mem.failed);
+}
+
+static void test_memarray_free_keeps_tail(void)
+{
+    uint8_t *block = memarray_alloc(&_mem);
+
+    memset(block, 0xaa, BLOCK_SIZE);
+    memarray_free(&_mem, block);
+    /* only the link at the start of a free block is overwritten */
+    for (unsigned i = sizeof(void *); i < BLOCK_SIZE; i++) {
+        TEST_ASSERT_EQUAL_INT(0xaa, block[i]);
+    }
+}
+
+static void test_memarray_high_water(void)
+{
+    void *a, *b;
+
+    a = memarray_alloc(&_mem);
+    memarray_free(&_mem, a);
+    a = memarray_alloc(&_mem);
+    b = memarray_alloc(&_mem);
+    memarray_free(&_mem, a);
+    memarray_free(&_mem, b);
+    TEST_ASSERT_EQUAL_INT(0, _mem.used);
+    TEST_ASSERT_EQUAL_INT(2, _mem.high_water);
+    TEST_ASSERT_EQUAL_INT(0, _mem.failed);
+    /* re-initialization resets statistics */
+    set_up();
+    TEST_ASSERT_EQUAL_INT(0, _mem.high_water);
+    TEST_ASSERT(_data[0] == memarray_alloc(&_mem));
+}
+
+Test *tests_memarray_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_memarray_static_init),
+        new_TestFixture(test_memarray_alloc_all),
+        new_TestFixture(test_memarray_free_realloc),
+        new_TestFixture(test_memarray_free_keeps_tail),
+        new_TestFixture(test_memarray_high_water),
+    };
+
+    EMB_UNIT_TESTCALLER(memarray_tests, set_up, NULL, fixtures);
+
+    return (Test *)&memarray_tests;
+}
+
+void tests_memarray(void)
+{
+    TESTS_RUN(tests_memarray_tests());
+}
+/** @} */
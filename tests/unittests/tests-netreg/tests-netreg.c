@@ -139,6 +139,44 @@ void test_netreg_getnext__2_entries(void)
     TEST_ASSERT_NOT_NULL(gnrc_netreg_getnext(res));
 }
 
+static void test_netreg_lookup__same_ctx_other_type(void)
+{
+    gnrc_netreg_entry_t *res = NULL;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &entries[0]));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_UNDEF, &entries[1]));
+    TEST_ASSERT_EQUAL_INT(1, gnrc_netreg_num(GNRC_NETTYPE_TEST, TEST_UINT16));
+    TEST_ASSERT_EQUAL_INT(1, gnrc_netreg_num(GNRC_NETTYPE_UNDEF, TEST_UINT16));
+    TEST_ASSERT_NOT_NULL((res = gnrc_netreg_lookup(GNRC_NETTYPE_TEST, TEST_UINT16)));
+    TEST_ASSERT_EQUAL_INT(TEST_UINT8, res->target.pid);
+    TEST_ASSERT_NULL(gnrc_netreg_getnext(res));
+    TEST_ASSERT_NOT_NULL((res = gnrc_netreg_lookup(GNRC_NETTYPE_UNDEF, TEST_UINT16)));
+    TEST_ASSERT_EQUAL_INT(TEST_UINT8 + 1, res->target.pid);
+    TEST_ASSERT_NULL(gnrc_netreg_getnext(res));
+}
+
+static void test_netreg_lookup__many_ctx(void)
+{
+    gnrc_netreg_entry_t many[4 * GNRC_NETREG_BUCKETS];
+    gnrc_netreg_entry_t all = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
+                                                         TEST_UINT8);
+
+    for (unsigned i = 0; i < (sizeof(many) / sizeof(many[0])); i++) {
+        gnrc_netreg_entry_init_pid(&many[i], i, TEST_UINT8);
+        TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &many[i]));
+    }
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &all));
+    for (unsigned i = 0; i < (sizeof(many) / sizeof(many[0])); i++) {
+        TEST_ASSERT(gnrc_netreg_lookup(GNRC_NETTYPE_TEST, i) == &many[i]);
+        TEST_ASSERT_NULL(gnrc_netreg_getnext(&many[i]));
+    }
+    TEST_ASSERT(gnrc_netreg_lookup(GNRC_NETTYPE_TEST, GNRC_NETREG_DEMUX_CTX_ALL) == &all);
+    TEST_ASSERT_EQUAL_INT(1, gnrc_netreg_num(GNRC_NETTYPE_TEST, GNRC_NETREG_DEMUX_CTX_ALL));
+    gnrc_netreg_unregister(GNRC_NETTYPE_TEST, &many[3]);
+    TEST_ASSERT_NULL(gnrc_netreg_lookup(GNRC_NETTYPE_TEST, 3));
+    TEST_ASSERT(gnrc_netreg_lookup(GNRC_NETTYPE_TEST, 4) == &many[4]);
+}
+
 Test *tests_netreg_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -149,6 +187,8 @@ Test *tests_netreg_tests(void)
         new_TestFixture(test_netreg_unregister__success3),
         new_TestFixture(test_netreg_lookup__wrong_type_undef),
         new_TestFixture(test_netreg_lookup__wrong_type_numof),
+        new_TestFixture(test_netreg_lookup__same_ctx_other_type),
+        new_TestFixture(test_netreg_lookup__many_ctx),
         new_TestFixture(test_netreg_num__empty),
         new_TestFixture(test_netreg_num__wrong_type_undef),
         new_TestFixture(test_netreg_num__wrong_type_numof),
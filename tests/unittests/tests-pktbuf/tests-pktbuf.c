@@ -37,9 +37,23 @@ typedef struct __attribute__((packed)) {
 }
 test_pktbuf_struct_t;
 
+static char ext_payload[] = TEST_STRING16;
+static unsigned ext_released;
+static const void *ext_data;
+static size_t ext_size;
+
 static void set_up(void)
 {
     gnrc_pktbuf_init();
+    ext_released = 0;
+}
+
+static void _ext_cb(void *arg, const void *data, size_t size)
+{
+    TEST_ASSERT(arg == &ext_released);
+    ext_released++;
+    ext_data = data;
+    ext_size = size;
 }
 
 static void test_pktbuf_init(void)
@@ -274,6 +288,75 @@ static void test_pktbuf_add__0_sized_release(void)
     TEST_ASSERT(gnrc_pktbuf_is_empty());
 }
 
+static void _add_release(size_t size)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL, size, GNRC_NETTYPE_TEST);
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_EQUAL_INT(size, pkt->size);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_add__size_class_boundaries(void)
+{
+    /* four size classes per power of two in gnrc_pktbuf_sizeclass */
+    for (size_t pow = 8; pow <= (GNRC_PKTBUF_SIZE / 4); pow <<= 1) {
+        for (size_t bound = pow; bound < (2 * pow); bound += (pow / 4)) {
+            _add_release(bound - 1);
+            _add_release(bound);
+            _add_release(bound + 1);
+        }
+    }
+#if GNRC_PKTBUF_SIZE >= 4096
+    /* fall into the last bounded class, but only fit the unbounded one */
+    _add_release(1537);
+    _add_release(1788);
+#endif
+}
+
+static void test_pktbuf_add_ext__success(void)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add_ext(NULL, ext_payload,
+                                              sizeof(ext_payload),
+                                              GNRC_NETTYPE_TEST, _ext_cb,
+                                              &ext_released);
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT(pkt->data == ext_payload);
+    TEST_ASSERT_EQUAL_INT(sizeof(ext_payload), pkt->size);
+    TEST_ASSERT_EQUAL_INT(GNRC_NETTYPE_TEST, pkt->type);
+    TEST_ASSERT_EQUAL_INT(1, pkt->users);
+    TEST_ASSERT(gnrc_pktbuf_is_ext(pkt));
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT_EQUAL_INT(1, ext_released);
+    TEST_ASSERT(ext_data == ext_payload);
+    TEST_ASSERT_EQUAL_INT(sizeof(ext_payload), ext_size);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_add_ext__hold(void)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add_ext(NULL, ext_payload,
+                                              sizeof(ext_payload),
+                                              GNRC_NETTYPE_TEST, _ext_cb,
+                                              &ext_released);
+    gnrc_pktsnip_t *hdr = gnrc_pktbuf_add(pkt, TEST_STRING8, sizeof(TEST_STRING8),
+                                          GNRC_NETTYPE_TEST);
+
+    TEST_ASSERT_NOT_NULL(hdr);
+    TEST_ASSERT(!gnrc_pktbuf_is_ext(hdr));
+    gnrc_pktbuf_hold(hdr, 1);
+    gnrc_pktbuf_release(hdr);
+    TEST_ASSERT_EQUAL_INT(0, ext_released);
+    gnrc_pktbuf_release(hdr);
+    TEST_ASSERT_EQUAL_INT(1, ext_released);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
 static void test_pktbuf_mark__pkt_NULL__size_0(void)
 {
     TEST_ASSERT_NULL(gnrc_pktbuf_mark(NULL, 0, GNRC_NETTYPE_TEST));
@@ -492,6 +575,19 @@ static void test_pktbuf_mark__success_equally_sized(void)
     TEST_ASSERT(gnrc_pktbuf_is_empty());
 }
 
+static void test_pktbuf_mark__ext(void)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add_ext(NULL, ext_payload,
+                                              sizeof(ext_payload),
+                                              GNRC_NETTYPE_TEST, NULL, NULL);
+
+    TEST_ASSERT_NULL(gnrc_pktbuf_mark(pkt, 4, GNRC_NETTYPE_TEST));
+    TEST_ASSERT_NULL(pkt->next);
+    TEST_ASSERT_EQUAL_INT(sizeof(ext_payload), pkt->size);
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
 static void test_pktbuf_realloc_data__size_0(void)
 {
     gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL, sizeof(TEST_STRING8), GNRC_NETTYPE_TEST);
@@ -739,6 +835,25 @@ static void test_pktbuf_start_write__pkt_users_1(void)
     TEST_ASSERT(gnrc_pktbuf_is_empty());
 }
 
+static void test_pktbuf_start_write__ext(void)
+{
+    gnrc_pktsnip_t *pkt_copy, *pkt = gnrc_pktbuf_add_ext(NULL, ext_payload,
+                                                         sizeof(ext_payload),
+                                                         GNRC_NETTYPE_TEST,
+                                                         _ext_cb, &ext_released);
+
+    TEST_ASSERT_NOT_NULL((pkt_copy = gnrc_pktbuf_start_write(pkt)));
+    TEST_ASSERT(pkt != pkt_copy);
+    TEST_ASSERT(!gnrc_pktbuf_is_ext(pkt_copy));
+    TEST_ASSERT_EQUAL_STRING(TEST_STRING16, pkt_copy->data);
+    TEST_ASSERT_EQUAL_INT(1, pkt_copy->users);
+    /* the copy replaces the only user of pkt */
+    TEST_ASSERT_EQUAL_INT(1, ext_released);
+
+    gnrc_pktbuf_release(pkt_copy);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
 static void test_pktbuf_start_write__pkt_users_2(void)
 {
     gnrc_pktsnip_t *pkt_copy, *pkt = gnrc_pktbuf_add(NULL, TEST_STRING16, sizeof(TEST_STRING16),
@@ -828,6 +943,9 @@ Test *tests_pktbuf_tests(void)
         new_TestFixture(test_pktbuf_add__packed_struct),
         new_TestFixture(test_pktbuf_add__unaligned_in_aligned_hole),
         new_TestFixture(test_pktbuf_add__0_sized_release),
+        new_TestFixture(test_pktbuf_add__size_class_boundaries),
+        new_TestFixture(test_pktbuf_add_ext__success),
+        new_TestFixture(test_pktbuf_add_ext__hold),
         new_TestFixture(test_pktbuf_mark__pkt_NULL__size_0),
         new_TestFixture(test_pktbuf_mark__pkt_NULL__size_not_0),
         new_TestFixture(test_pktbuf_mark__pkt_NOT_NULL__size_0),
@@ -837,6 +955,7 @@ Test *tests_pktbuf_tests(void)
         new_TestFixture(test_pktbuf_mark__success_aligned),
         new_TestFixture(test_pktbuf_mark__success_small),
         new_TestFixture(test_pktbuf_mark__success_equally_sized),
+        new_TestFixture(test_pktbuf_mark__ext),
         new_TestFixture(test_pktbuf_realloc_data__size_0),
         new_TestFixture(test_pktbuf_realloc_data__memfull),
         new_TestFixture(test_pktbuf_realloc_data__nomemenough),
@@ -855,6 +974,7 @@ Test *tests_pktbuf_tests(void)
         new_TestFixture(test_pktbuf_start_write__NULL),
         new_TestFixture(test_pktbuf_start_write__pkt_users_1),
         new_TestFixture(test_pktbuf_start_write__pkt_users_2),
+        new_TestFixture(test_pktbuf_start_write__ext),
         new_TestFixture(test_pktbuf_get_iovec__1_elem),
         new_TestFixture(test_pktbuf_get_iovec__3_elem),
         new_TestFixture(test_pktbuf_get_iovec__null),
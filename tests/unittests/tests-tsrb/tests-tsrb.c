@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <limits.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "tsrb.h"
+
+#include "tests-tsrb.h"
+
+#define TEST_BUF_SIZE   (8U)
+
+static char _mem[TEST_BUF_SIZE];
+static tsrb_t _rb;
+
+static void set_up(void)
+{
+    memset(_mem, 0, sizeof(_mem));
+    tsrb_init(&_rb, _mem, sizeof(_mem));
+}
+
+static void test_tsrb_region__empty_full(void)
+{
+    char *region;
+
+    TEST_ASSERT_EQUAL_INT(0, tsrb_peek_region(&_rb, &region));
+    TEST_ASSERT_EQUAL_INT(TEST_BUF_SIZE, tsrb_reserve(&_rb, &region));
+    TEST_ASSERT(region == _mem);
+    tsrb_commit(&_rb, TEST_BUF_SIZE);
+    TEST_ASSERT(tsrb_full(&_rb));
+    TEST_ASSERT_EQUAL_INT(0, tsrb_reserve(&_rb, &region));
+    TEST_ASSERT_EQUAL_INT(TEST_BUF_SIZE, tsrb_peek_region(&_rb, &region));
+    TEST_ASSERT(region == _mem);
+    tsrb_release(&_rb, TEST_BUF_SIZE);
+    TEST_ASSERT(tsrb_empty(&_rb));
+}
+
+static void test_tsrb_region__commit_release(void)
+{
+    char *region;
+
+    TEST_ASSERT_EQUAL_INT(TEST_BUF_SIZE, tsrb_reserve(&_rb, &region));
+    memcpy(region, "abc", 3);
+    /* nothing is visible before the commit */
+    TEST_ASSERT(tsrb_empty(&_rb));
+    tsrb_commit(&_rb, 3);
+    TEST_ASSERT_EQUAL_INT(3, tsrb_avail(&_rb));
+    TEST_ASSERT_EQUAL_INT(TEST_BUF_SIZE - 3, tsrb_reserve(&_rb, &region));
+    TEST_ASSERT(region == &_mem[3]);
+
+    TEST_ASSERT_EQUAL_INT(3, tsrb_peek_region(&_rb, &region));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(region, "abc", 3));
+    /* peeking does not consume */
+    TEST_ASSERT_EQUAL_INT(3, tsrb_peek_region(&_rb, &region));
+    tsrb_release(&_rb, 1);
+    TEST_ASSERT_EQUAL_INT(2, tsrb_peek_region(&_rb, &region));
+    TEST_ASSERT_EQUAL_INT('b', *region);
+    TEST_ASSERT_EQUAL_INT('b', tsrb_get_one(&_rb));
+    TEST_ASSERT_EQUAL_INT('c', tsrb_get_one(&_rb));
+    TEST_ASSERT(tsrb_empty(&_rb));
+}
+
+static void test_tsrb_region__wraparound(void)
+{
+    char out[TEST_BUF_SIZE];
+    char *region;
+
+    TEST_ASSERT_EQUAL_INT(6, tsrb_add(&_rb, "012345", 6));
+    TEST_ASSERT_EQUAL_INT(5, tsrb_get(&_rb, out, 5));
+
+    /* free space wraps around: first up to the end of the buffer ... */
+    TEST_ASSERT_EQUAL_INT(2, tsrb_reserve(&_rb, &region));
+    TEST_ASSERT(region == &_mem[6]);
+    memcpy(region, "67", 2);
+    tsrb_commit(&_rb, 2);
+    /* ... then from its start up to the oldest data */
+    TEST_ASSERT_EQUAL_INT(5, tsrb_reserve(&_rb, &region));
+    TEST_ASSERT(region == _mem);
+    memcpy(region, "89abc", 5);
+    tsrb_commit(&_rb, 5);
+    TEST_ASSERT(tsrb_full(&_rb));
+
+    /* the same holds for the data */
+    TEST_ASSERT_EQUAL_INT(3, tsrb_peek_region(&_rb, &region));
+    TEST_ASSERT(region == &_mem[5]);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(region, "567", 3));
+    tsrb_release(&_rb, 3);
+    TEST_ASSERT_EQUAL_INT(5, tsrb_peek_region(&_rb, &region));
+    TEST_ASSERT(region == _mem);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(region, "89abc", 5));
+    tsrb_release(&_rb, 5);
+    TEST_ASSERT(tsrb_empty(&_rb));
+}
+
+static void test_tsrb_region__counter_overflow(void)
+{
+    char out[TEST_BUF_SIZE];
+    char *region;
+
+    /* the read and write counters overflow while data is in the buffer */
+    _rb.reads = UINT_MAX - 2;
+    _rb.writes = UINT_MAX - 2;
+    TEST_ASSERT(tsrb_empty(&_rb));
+    TEST_ASSERT_EQUAL_INT(3, tsrb_reserve(&_rb, &region));
+    TEST_ASSERT(region == &_mem[TEST_BUF_SIZE - 3]);
+    memcpy(region, "xyz", 3);
+    tsrb_commit(&_rb, 3);
+    TEST_ASSERT_EQUAL_INT(0, _rb.writes);
+    TEST_ASSERT_EQUAL_INT(TEST_BUF_SIZE - 3, tsrb_reserve(&_rb, &region));
+    TEST_ASSERT_EQUAL_INT(4, tsrb_add(&_rb, "0123", 4));
+    TEST_ASSERT_EQUAL_INT(7, tsrb_avail(&_rb));
+    TEST_ASSERT_EQUAL_INT(7, tsrb_get(&_rb, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(out, "xyz0123", 7));
+    TEST_ASSERT(tsrb_empty(&_rb));
+}
+
+Test *tests_tsrb_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_tsrb_region__empty_full),
+        new_TestFixture(test_tsrb_region__commit_release),
+        new_TestFixture(test_tsrb_region__wraparound),
+        new_TestFixture(test_tsrb_region__counter_overflow),
+    };
+
+    EMB_UNIT_TESTCALLER(tsrb_tests, set_up, NULL, fixtures);
+
+    return (Test *)&tsrb_tests;
+}
+
+void tests_tsrb(void)
+{
+    TESTS_RUN(tests_tsrb_tests());
+}
+/** @} */
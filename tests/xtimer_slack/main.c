@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       xtimer_set_slack() test application
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "xtimer.h"
+
+#define NUMOF       (8U)
+#define INTERVAL    (10U * US_PER_MS)
+#define SLACK       (50U * US_PER_MS)
+
+static xtimer_t timers[NUMOF];
+static uint32_t offsets[NUMOF];
+static uint32_t fired_at[NUMOF];
+static volatile unsigned fired;
+
+static void _cb(void *arg)
+{
+    uint32_t *timestamp = arg;
+
+    *timestamp = xtimer_now_usec();
+    fired++;
+}
+
+int main(void)
+{
+    puts("xtimer_set_slack() test application.");
+
+    uint32_t start = xtimer_now_usec();
+    uint32_t coalesced = xtimer_coalesced();
+
+    for (unsigned i = 0; i < NUMOF; i++) {
+        timers[i].callback = _cb;
+        timers[i].arg = &fired_at[i];
+        offsets[i] = (i + 1) * INTERVAL;
+        xtimer_set_slack(&timers[i], offsets[i], SLACK);
+    }
+
+    while (fired < NUMOF) {
+        xtimer_usleep(INTERVAL);
+    }
+
+    for (unsigned i = 0; i < NUMOF; i++) {
+        uint32_t diff = fired_at[i] - start;
+        printf("timer %u: offset %lu fired after %lu%s\n", i,
+               (unsigned long)offsets[i], (unsigned long)diff,
+               ((diff < offsets[i]) || (diff > offsets[i] + SLACK + INTERVAL)) ?
+               " (out of window!)" : "");
+    }
+
+    printf("%lu of %u timer interrupts avoided\n",
+           (unsigned long)(xtimer_coalesced() - coalesced), NUMOF);
+    puts("done");
+    return 0;
+}
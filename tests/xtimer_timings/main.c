@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures xtimer_set() and xtimer_remove() against the number
+ *              of active timers, and the wake-ups needed to fire them
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "random.h"
+#include "xtimer.h"
+
+#ifndef TIMERS_MAX
+#define TIMERS_MAX      (1024U)
+#endif
+
+#define RUNS            (1000U)
+/* keep all timers well away from expiring during the test */
+#define OFFSET_MIN      (60U * US_PER_SEC)
+#define OFFSET_MAX      (120U * US_PER_SEC)
+/* timers fired to count wake-ups, spread over the same range */
+#define FIRE_TIMERS     (64U)
+#define FIRE_OFFSET_MIN (100U * US_PER_MS)
+#define FIRE_OFFSET_MAX (2U * US_PER_SEC)
+
+static xtimer_t timers[TIMERS_MAX];
+static xtimer_t probe;
+static volatile unsigned fired;
+
+static void _cb(void *arg)
+{
+    (void)arg;
+    puts("error: timer fired during test");
+}
+
+static void _measure(unsigned numof)
+{
+    uint32_t set_sum = 0, set_max = 0, rem_sum = 0, rem_max = 0;
+
+    for (unsigned i = 0; i < numof; i++) {
+        timers[i].callback = _cb;
+        xtimer_set(&timers[i], random_uint32_range(OFFSET_MIN, OFFSET_MAX));
+    }
+
+    for (unsigned i = 0; i < RUNS; i++) {
+        uint32_t offset = random_uint32_range(OFFSET_MIN, OFFSET_MAX);
+        uint32_t start = xtimer_now_usec();
+        xtimer_set(&probe, offset);
+        uint32_t diff = xtimer_now_usec() - start;
+        set_sum += diff;
+        if (diff > set_max) {
+            set_max = diff;
+        }
+
+        start = xtimer_now_usec();
+        xtimer_remove(&probe);
+        diff = xtimer_now_usec() - start;
+        rem_sum += diff;
+        if (diff > rem_max) {
+            rem_max = diff;
+        }
+    }
+
+    for (unsigned i = 0; i < numof; i++) {
+        xtimer_remove(&timers[i]);
+    }
+
+    printf("%6u  %7lu  %7lu  %10lu  %10lu\n", numof,
+           (unsigned long)(set_sum / RUNS), (unsigned long)set_max,
+           (unsigned long)(rem_sum / RUNS), (unsigned long)rem_max);
+}
+
+static void _fire_cb(void *arg)
+{
+    (void)arg;
+    fired++;
+}
+
+static void _measure_wakeups(void)
+{
+    uint32_t wakeups;
+    unsigned numof = (FIRE_TIMERS < TIMERS_MAX) ? FIRE_TIMERS : TIMERS_MAX;
+
+    fired = 0;
+    for (unsigned i = 0; i < numof; i++) {
+        timers[i].callback = _fire_cb;
+        xtimer_set(&timers[i], random_uint32_range(FIRE_OFFSET_MIN, FIRE_OFFSET_MAX));
+    }
+    /* the wake-up of the sleeping thread is counted, too */
+    wakeups = xtimer_wakeups();
+    xtimer_usleep(FIRE_OFFSET_MAX + (100U * US_PER_MS));
+    wakeups = xtimer_wakeups() - wakeups;
+
+    printf("%u of %u timers fired with %lu wake-ups\n", fired, numof,
+           (unsigned long)wakeups);
+}
+
+int main(void)
+{
+    puts("xtimer set/remove timings (usec)");
+#ifdef MODULE_XTIMER_WHEEL
+    puts("backend: xtimer_wheel");
+#else
+    puts("backend: sorted lists");
+#endif
+
+    probe.callback = _cb;
+
+    puts("timers  set avg  set max  remove avg  remove max");
+    for (unsigned numof = 1; numof <= TIMERS_MAX; numof *= 4) {
+        _measure(numof);
+    }
+
+    _measure_wakeups();
+
+    puts("done");
+    return 0;
+}